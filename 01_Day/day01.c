@@ -0,0 +1,441 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>   // int64_t
+#include <unistd.h>     // ssize_t
+#include <errno.h>      // errno
+#include <ctype.h>      // isdigit
+#include <stdbool.h>    // bool
+
+#include "input.h"
+#include "input_stream.h"
+#include "scheduler.h"
+#include "swar.h"
+#include "solver.h"
+#include "day01.h"
+
+#define DEBUG (0)
+#define DEBUG_LEVEL (1) // Everything below this level will be printed (incl. this level)
+#ifdef DEBUG
+    #define DEBUG_START(level) if (DEBUG_LEVEL >= (level)) {
+    #define DEBUG_END }
+#else
+    #define DEBUG_START(level) if(0) {
+    #define DEBUG_END }
+#endif
+
+#define SOLVER_VERSION (4)
+
+// Parallel mode: newline aligned chunks of about this size are the scheduler's items
+// (unless options->chunk_size is set, see -j auto)
+#define DEFAULT_CHUNK_SIZE (64 * 1024)
+
+typedef enum {
+    LINE_OK,
+    LINE_NO_DIGIT,
+    LINE_CONVERSION_ERROR
+} line_status_t;
+
+// Digits of one line, found in the same scans: part one only counts numeric
+// digits (-1: none in the line), part two also counts spelled out digits
+typedef struct {
+    ssize_t first_digit;
+    ssize_t last_digit;
+    ssize_t first_any_digit;
+    ssize_t last_any_digit;
+} line_digits_t;
+
+// Running sums of both parts
+typedef struct {
+    ssize_t digits_only;
+    ssize_t with_spelled;
+} calibration_sums_t;
+
+// Chunk i of the parallel mode spans [bounds[i], bounds[i+1])
+typedef struct {
+    const char** bounds;
+} chunk_list_t;
+
+// Partial result of the parallel mode, all-zero is the empty result
+typedef struct {
+    calibration_sums_t sums;
+    line_status_t status;   // Of the first failing chunk, if any
+    size_t failed_chunk;
+    int saved_errno;
+} chunk_result_t;
+
+static bool decrypt_calibration_value(void* state,
+                                      const solver_options_t* options,
+                                      const char* input,
+                                      size_t input_size,
+                                      solver_result_t* result);
+static bool decrypt_calibration_value_lines(void* state,
+                                            const solver_options_t* options,
+                                            line_reader_t* reader,
+                                            solver_result_t* result);
+static bool try_decrypting_serial(line_reader_t* reader, calibration_sums_t* sums);
+static bool try_decrypting_parallel(const char* input, size_t input_size, const solver_options_t* options,
+                                    calibration_sums_t* sums);
+static bool try_parsing_digit(const char* str, ssize_t* digit);
+static line_status_t decode_line(const char* line, ssize_t read_bytes, line_digits_t* digits);
+static void add_line(calibration_sums_t* sums, const line_digits_t* digits);
+static uint8_t isWrittenDigit(const char* word, uint8_t word_len);
+
+const solver_t DAY01_SOLVER = {
+    .name = "01",
+    .directory = "01_Day",
+    .default_input = "input_big_letters.txt",
+    .version = SOLVER_VERSION,
+    .init = NULL,
+    .solve = decrypt_calibration_value,
+    .solve_lines = decrypt_calibration_value_lines,
+    .destroy = NULL,
+    .supports_threads = true
+};
+
+// ################################################
+
+static bool decrypt_calibration_value(void* state,
+                                      const solver_options_t* options,
+                                      const char* input,
+                                      size_t input_size,
+                                      solver_result_t* result) {
+
+    // Per-line debug output is only available in the serial path
+    if(options->thread_cnt <= 1) {
+        line_reader_t reader;
+        init_buffer_line_reader(&reader, input, input_size);
+        return decrypt_calibration_value_lines(state, options, &reader, result);
+    }
+
+    calibration_sums_t sums;
+    if(!try_decrypting_parallel(input, input_size, options, &sums)) {
+        return false;
+    }
+
+    result->part_one = sums.digits_only;
+    result->part_two = sums.with_spelled;
+    result->has_part_two = true;
+    return true;
+}
+
+// Streamed inputs cannot be split up front, so they are always decoded serially
+static bool decrypt_calibration_value_lines(void* state,
+                                            const solver_options_t* options,
+                                            line_reader_t* reader,
+                                            solver_result_t* result) {
+
+    calibration_sums_t sums;
+    if(!try_decrypting_serial(reader, &sums)) {
+        return false;
+    }
+
+    result->part_one = sums.digits_only;
+    result->part_two = sums.with_spelled;
+    result->has_part_two = true;
+    return true;
+}
+
+static bool try_parsing_digit(const char* str, ssize_t* digit) {
+    uint64_t value;
+    size_t consumed;
+    if(!swar_try_parsing_uint(str, 1, 9, &value, &consumed) || consumed != 1) {
+        errno = EINVAL;
+        return false;
+    }
+    *digit = (ssize_t)value;
+    return true;
+}
+
+// Both parts share the scans: a numeric digit ends a scan, a spelled out
+// digit before it only settles part two
+static line_status_t decode_line(const char* line, ssize_t read_bytes, line_digits_t* digits) {
+
+    // Get first digit in line
+    digits->first_digit = -1;
+    digits->first_any_digit = -1;
+    for(ssize_t i=0; i<read_bytes; ++i) {
+        if(isdigit(line[i])) {
+            // Only the first digit of line is wanted (123test456 => 1),
+            // so the parse is bounded to a single character
+            if(!try_parsing_digit(&line[i], &digits->first_digit)) {
+                return LINE_CONVERSION_ERROR;
+            }
+            if(digits->first_any_digit == -1) {
+                digits->first_any_digit = digits->first_digit;
+            }
+            break;
+        }
+        if(digits->first_any_digit == -1) {
+            uint8_t word_length = (read_bytes-1-i) < 7 ? (read_bytes-1-i) : 7;
+            uint8_t written_digit = isWrittenDigit(&line[i], word_length);
+            if(written_digit) {
+                digits->first_any_digit = written_digit;
+            }
+        }
+    }
+    if(digits->first_any_digit == -1) {
+        return LINE_NO_DIGIT;
+    }
+
+    // Get last digit in line
+    digits->last_digit = -1;
+    digits->last_any_digit = -1;
+    for(ssize_t i=read_bytes-1; i>=0; --i) {
+        if(isdigit(line[i])) {
+            if(!try_parsing_digit(&line[i], &digits->last_digit)) {
+                return LINE_CONVERSION_ERROR;
+            }
+            if(digits->last_any_digit == -1) {
+                digits->last_any_digit = digits->last_digit;
+            }
+            break;
+        }
+        if(digits->last_any_digit == -1) {
+            uint8_t word_length = (read_bytes-1-i < 7) ? (read_bytes-1-i) : 7;
+            uint8_t written_digit = isWrittenDigit(&line[i], word_length);
+            if(written_digit) {
+                digits->last_any_digit = written_digit;
+                // Without a numeric digit the backward scan cannot find one either
+                if(digits->first_digit == -1) {
+                    break;
+                }
+            }
+        }
+    }
+    // There has to be a last digit of both kinds, if there was a first one
+    // So it must not be checked here
+
+    return LINE_OK;
+}
+
+// Lines without a numeric digit count 0 for part one
+static void add_line(calibration_sums_t* sums, const line_digits_t* digits) {
+    if(digits->first_digit != -1) {
+        sums->digits_only += 10*digits->first_digit + digits->last_digit;
+    }
+    sums->with_spelled += 10*digits->first_any_digit + digits->last_any_digit;
+}
+
+static void report_line_status(line_status_t status) {
+    if(status == LINE_CONVERSION_ERROR) {
+        perror("Error converting string to number");
+    } else if(status == LINE_NO_DIGIT) {
+        perror("No digit in line");
+    }
+}
+
+static bool try_decrypting_serial(line_reader_t* reader, calibration_sums_t* sums) {
+
+    // Read input line by line
+    sums->digits_only = 0;
+    sums->with_spelled = 0;
+    const char* line = NULL;
+    size_t read_bytes = 0;
+    line_digits_t digits;
+    size_t line_counter = 1; 
+    while(read_line(reader, &line, &read_bytes)) {
+
+        line_status_t status = decode_line(line, (ssize_t)read_bytes, &digits);
+        if(status != LINE_OK) {
+            report_line_status(status);
+            return false;
+        }
+
+        DEBUG_START(2)
+        printf("%5.ld. (%ld, %ld) (%ld, %ld): %.*s",
+            line_counter,
+            digits.first_digit,
+            digits.last_digit,
+            digits.first_any_digit,
+            digits.last_any_digit,
+            (int)read_bytes,
+            line);
+        DEBUG_END
+        line_counter++;
+
+        // Add concatenation of first and last digit to the results
+        add_line(sums, &digits);
+    }
+
+    return true;
+}
+
+// Parallel Mode
+// ################################################
+
+static bool decrypt_chunks(void* context, size_t begin, size_t end, void* partial) {
+
+    const chunk_list_t* chunks = (const chunk_list_t*)context;
+    chunk_result_t* chunk_result = (chunk_result_t*)partial;
+
+    for(size_t chunk=begin; chunk<end; ++chunk) {
+        const char* line = chunks->bounds[chunk];
+        const char* chunk_end = chunks->bounds[chunk+1];
+        while(line < chunk_end) {
+            const char* newline = memchr(line, '\n', (size_t)(chunk_end - line));
+            const char* line_end = (newline != NULL) ? newline + 1 : chunk_end;
+
+            // Same kernel as the serial path, the line includes its '\n'
+            line_digits_t digits;
+            line_status_t status = decode_line(line, line_end - line, &digits);
+            if(status != LINE_OK) {
+                chunk_result->status = status;
+                chunk_result->failed_chunk = chunk;
+                chunk_result->saved_errno = errno;
+                return false;
+            }
+            add_line(&chunk_result->sums, &digits);
+            line = line_end;
+        }
+    }
+    return true;
+}
+
+static void combine_chunk_results(void* into, const void* from) {
+    chunk_result_t* into_result = (chunk_result_t*)into;
+    const chunk_result_t* from_result = (const chunk_result_t*)from;
+    into_result->sums.digits_only += from_result->sums.digits_only;
+    into_result->sums.with_spelled += from_result->sums.with_spelled;
+    if(from_result->status != LINE_OK
+    && (into_result->status == LINE_OK || from_result->failed_chunk < into_result->failed_chunk)) {
+        into_result->status = from_result->status;
+        into_result->failed_chunk = from_result->failed_chunk;
+        into_result->saved_errno = from_result->saved_errno;
+    }
+}
+
+static bool try_decrypting_parallel(const char* input, size_t input_size, const solver_options_t* options,
+                                    calibration_sums_t* sums) {
+
+    sums->digits_only = 0;
+    sums->with_spelled = 0;
+    if(input_size == 0) {
+        return true;
+    }
+
+    // Split at newline boundaries, so every line belongs to exactly one chunk.
+    // Many more chunks than workers: the scheduler balances them by stealing.
+    size_t chunk_size = (options->chunk_size > 0) ? options->chunk_size : DEFAULT_CHUNK_SIZE;
+    size_t max_chunks_cnt = input_size / chunk_size + 1;
+    chunk_list_t chunks = {malloc((max_chunks_cnt + 1) * sizeof(const char*))};
+    if(chunks.bounds == NULL) {
+        perror("Error allocating memory for chunks");
+        return false;
+    }
+    const char* input_end = input + input_size;
+    size_t chunks_cnt = 0;
+    chunks.bounds[0] = input;
+    while(chunks.bounds[chunks_cnt] < input_end) {
+        const char* chunk_end;
+        if((size_t)(input_end - chunks.bounds[chunks_cnt]) <= chunk_size) {
+            chunk_end = input_end;
+        } else {
+            chunk_end = chunks.bounds[chunks_cnt] + chunk_size;
+            const char* newline = memchr(chunk_end, '\n', (size_t)(input_end - chunk_end));
+            chunk_end = (newline != NULL) ? newline + 1 : input_end;
+        }
+        chunks.bounds[++chunks_cnt] = chunk_end;
+    }
+
+    // Workers are pinned before their first access: the input is mapped lazily,
+    // so the pages they touch first get allocated on their own node
+    scheduler_t* scheduler;
+    if(!try_creating_scheduler(options->thread_cnt, options->placement, &scheduler)) {
+        free(chunks.bounds);
+        return false;
+    }
+    chunk_result_t total;
+    bool successful = parallel_reduce(scheduler, chunks_cnt, SCHEDULER_AUTO_GRAIN, decrypt_chunks, &chunks,
+                                      sizeof(chunk_result_t), combine_chunk_results, &total);
+    destroy_scheduler(scheduler);
+    free(chunks.bounds);
+
+    // The first failing chunk (in file order) reports its error
+    if(total.status != LINE_OK) {
+        errno = total.saved_errno;
+        report_line_status(total.status);
+        return false;
+    }
+    *sums = total.sums;
+    return successful;
+}
+
+// ################################################
+
+static uint8_t isWrittenDigit(const char* word, uint8_t word_len) {
+
+    if(word_len < 3) {
+        return 0;
+    }
+
+    if(word[0] == 'o' 
+    && word[1] == 'n' 
+    && word[2] == 'e') {
+        return 1;
+    }
+
+    else if(word[0] == 't') {
+         if(word[1] == 'w' 
+         && word[2] == 'o') {
+             return 2;
+         }
+         else if(word_len >= 5
+         && word[1] == 'h' 
+         && word[2] == 'r' 
+         && word[3] == 'e' 
+         && word[4] == 'e') {
+             return 3;
+         }
+    }
+
+    else if(word[0] == 'f') {
+         if(word_len >= 4
+         && word[1] == 'o' 
+         && word[2] == 'u' 
+         && word[3] == 'r') {
+             return 4;
+         }
+         else if(word_len >= 4
+         && word[1] == 'i' 
+         && word[2] == 'v' 
+         && word[3] == 'e') {
+             return 5;
+         }
+    }
+
+    else if(word[0] == 's') {
+         if(word[1] == 'i' 
+         && word[2] == 'x') {
+             return 6;
+         }
+         else if(word_len >= 5
+         && word[1] == 'e' 
+         && word[2] == 'v' 
+         && word[3] == 'e' 
+         && word[4] == 'n') {
+             return 7;
+         }
+    }
+
+    else if(word[0] == 'e') {
+         if(word_len >= 5
+         && word[1] == 'i' 
+         && word[2] == 'g' 
+         && word[3] == 'h' 
+         && word[4] == 't') {
+             return 8;
+         }
+    }
+
+    else if(word[0] == 'n') {
+         if(word_len >= 4
+         && word[1] == 'i' 
+         && word[2] == 'n' 
+         && word[3] == 'e') {
+             return 9;
+         }
+    }
+    
+    return 0;
+}
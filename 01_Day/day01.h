@@ -0,0 +1,8 @@
+#ifndef DAY01_SOLVER_H
+#define DAY01_SOLVER_H
+
+#include "solver.h"
+
+extern const solver_t DAY01_SOLVER;
+
+#endif
@@ -0,0 +1,35 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils.h"
+#include "day02.h"
+
+// Converter
+// ################################################
+//
+// Parses a text input once and stores its games as a columnar game cache
+// (game_cache.h). The 02 solver (and the runner) accept the result in place
+// of the text input and fall back to the text if it changed since:
+//   ./convert_games input_big.txt input_big.bin
+//   ./main input_big.bin
+// -r also stores the counts of every round.
+
+int main(int argc, char* argv[]) {
+
+    bool with_rounds = argc == 4 && strcmp(argv[1], "-r") == 0;
+    if(argc != 3 && !with_rounds) {
+        fprintf(stderr, "Usage: %s [-r] input.txt output.bin\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    const char* input_file_name = argv[argc - 2];
+    const char* output_file_name = argv[argc - 1];
+
+    int64_t start = millis();
+    if(!try_converting_games(input_file_name, output_file_name, with_rounds)) {
+        return EXIT_FAILURE;
+    }
+
+    fprintf(stdout, "Converted %s to %s in %ld ms\n", input_file_name, output_file_name, (long)(millis() - start));
+    return EXIT_SUCCESS;
+}
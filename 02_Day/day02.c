@@ -0,0 +1,1010 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>   // int64_t
+#include <unistd.h>     // ssize_t
+#include <errno.h>      // errno
+#include <ctype.h>      // isdigit
+#include <stdbool.h>    // bool
+#include <regex.h>      // regex
+
+#include "arena.h"
+#include "input.h"
+#include "input_stream.h"
+#include "pipeline.h"
+#include "export_writer.h"
+#include "mem_stats.h"
+#include "profiler.h"
+#include "solver.h"
+#include "swar.h"
+#include "utils.h"
+#include "day02.h"
+#include "limit_index.h"
+#include "game_cache.h"
+
+// ################################################
+
+// #define DEBUG (0)
+#define DEBUG_LEVEL (1)
+#ifdef DEBUG
+    #define DEBUG_START(level) if (DEBUG_LEVEL >= (level)) {
+    #define DEBUG_END }
+#else
+    #define DEBUG_START(level) if(0) {
+    #define DEBUG_END }
+#endif
+
+// ################################################
+
+#define RED (0)
+#define GREEN (1)
+#define BLUE (2)
+#define COLOR_CNT (3)
+
+#define RED_MAX_DICE (12)
+#define GREEN_MAX_DICE (13)
+#define BLUE_MAX_DICE (14)
+// Largest dice count a round may name, the columnar copies store counts as uint16_t
+#define MAX_DICE_COUNT (9999)
+
+#define PATTERN_LEN_RED (18)
+#define PATTERN_LEN_GREEN (20)
+#define PATTERN_LEN_BLUE (19)
+
+#define SOLVER_VERSION (4)
+
+#define INITIAL_GAMES_CAPACITY (64)
+
+// "whatif:<file>" answers the (red green blue) limits listed in file
+#define WHATIF_MODE_PREFIX "whatif:"
+
+// Per-game export (-e), binary records follow an export_binary_header_t
+#define EXPORT_MAGIC "AOC02GM"
+#define EXPORT_VERSION (1)
+#define EXPORT_CSV_HEADER "id,red,green,blue,power,valid"
+
+// ################################################
+
+typedef struct {
+    char* round_string;
+    size_t number_of_dice[COLOR_CNT];
+} round_t;
+
+typedef struct {
+    size_t id;
+    size_t round_cnt;
+    round_t* rounds;
+    size_t max_number_of_dice[COLOR_CNT];
+} single_game_t;
+
+typedef struct {
+    size_t game_cnt;
+    size_t games_capacity;
+    single_game_t* all_games;
+    size_t max_dice[COLOR_CNT];
+} games_t;
+
+typedef struct {
+    uint64_t id;
+    uint64_t power;
+    uint16_t max_number_of_dice[COLOR_CNT];
+    uint8_t valid;
+    uint8_t reserved;
+} game_record_t;
+
+// Reused across inputs: compiled regexes and the arena for round strings
+typedef struct {
+    regex_t regexes[COLOR_CNT];
+    arena_t arena;
+} solver_state_t;
+
+// Parser stage output of the pipeline mode, one per line
+typedef struct {
+    size_t id;
+    size_t max_number_of_dice[COLOR_CNT];
+} parsed_game_t;
+
+// Shared by the stages of the pipeline mode: the parser owns the line buffer
+// and the arena, the solver owns the sums
+typedef struct {
+    solver_state_t* solver_state;
+    char* line;
+    size_t line_capacity;
+    const size_t* max_dice;
+    size_t sum_valid_game_ids;
+    size_t sum_game_powers;
+} pipeline_context_t;
+
+// ################################################
+
+// AoC Functions
+static bool try_initializing_state(void** state);
+static void destroy_state(void* state);
+static bool decrypt_riddle_value(void* state,
+                                 const solver_options_t* options,
+                                 const char* input,
+                                 size_t input_size,
+                                 solver_result_t* result);
+static bool decrypt_riddle_value_lines(void* state,
+                                       const solver_options_t* options,
+                                       line_reader_t* reader,
+                                       solver_result_t* result);
+static bool try_setting_up_regex(regex_t** regex);
+static bool try_splitting_rounds(char* line, size_t* round_cnt, round_t** rounds, arena_t* arena);
+static bool try_parsing_rounds(size_t* round_cnt, round_t* rounds, regex_t* regexes, size_t* max_number_of_dice);
+static bool try_parsing_whatif_mode(const solver_options_t* options, const char** queries_file_name);
+static bool bypasses_result_cache(const solver_options_t* options, const char* file_name);
+static bool try_answering_limit_queries(const games_t* games, const char* queries_file_name);
+static bool try_answering_column_limit_queries(const uint64_t* ids, const uint16_t* const columns[COLOR_CNT],
+                                               size_t games_cnt, const char* queries_file_name);
+static bool try_solving_game_cache(void* state,
+                                   const solver_options_t* options,
+                                   const char* input,
+                                   size_t input_size,
+                                   solver_result_t* result);
+static bool try_opening_game_export(const char* file_name, export_writer_t** writer);
+static bool try_solving_with_pipeline(solver_state_t* solver_state, line_reader_t* reader, solver_result_t* result);
+static bool try_exporting_game(export_writer_t* writer, bool binary, const single_game_t* game,
+                               size_t power, bool is_valid);
+
+const solver_t DAY02_SOLVER = {
+    .name = "02",
+    .directory = "02_Day",
+    .default_input = "input_big.txt",
+    .version = SOLVER_VERSION,
+    .init = try_initializing_state,
+    .solve = decrypt_riddle_value,
+    .solve_lines = decrypt_riddle_value_lines,
+    .destroy = destroy_state,
+    .bypasses_result_cache = bypasses_result_cache
+};
+
+// ################################################
+
+static bool try_initializing_state(void** state) {
+
+    solver_state_t* solver_state = malloc(sizeof(solver_state_t));
+    if(solver_state == NULL) {
+        perror("Error allocating memory for solver state");
+        return false;
+    }
+    regex_t* regexes = solver_state->regexes;
+    if(!try_setting_up_regex(&regexes)) {
+        free(solver_state);
+        return false;
+    }
+    init_arena(&solver_state->arena, ARENA_DEFAULT_BLOCK_SIZE);
+    *state = solver_state;
+    return true;
+}
+
+static void destroy_state(void* state) {
+
+    solver_state_t* solver_state = (solver_state_t*)state;
+    if(solver_state == NULL) {
+        return;
+    }
+    for(size_t i=0; i<COLOR_CNT; ++i) {
+        regfree(&solver_state->regexes[i]);
+    }
+    destroy_arena(&solver_state->arena);
+    free(solver_state);
+}
+
+static bool try_setting_up_regex(regex_t** regex) {
+
+    // Define the patterns
+    const char* patterns[COLOR_CNT] = {
+        "([0-9]+\\sred)",  
+        "([0-9]+\\sgreen)",
+        "([0-9]+\\sblue)"  
+    };
+
+    // Compile regex for each pattern
+    for (size_t i = 0; i < COLOR_CNT; ++i) {
+        if (regcomp(&((*regex)[i]), patterns[i], REG_EXTENDED) != 0) {
+            perror("Error compiling regex");
+            return false;
+        }
+    }
+
+    DEBUG_START(1)
+        fprintf(stderr, "Compiled regex\n\n");
+    DEBUG_END
+
+    return true;
+}
+
+static bool try_parsing_game_id(const ssize_t* read_bytes, const char* line, size_t* game_id) {
+
+    if(*read_bytes < 7) {
+        perror("Invalid line format");
+        return false;
+    }
+
+    uint64_t parsed_game_id;
+    size_t consumed;
+    if(!swar_try_parsing_uint(&line[5], (size_t)(*read_bytes - 5), SIZE_MAX, &parsed_game_id, &consumed)) {
+        fprintf(stderr, "Error parsing game id: value out of range\n");
+        return false;
+    }
+    if(consumed == 0) {
+        fprintf(stderr, "Invalid line format: missing game id\n");
+        return false;
+    }
+    *game_id = (size_t)parsed_game_id;
+
+    DEBUG_START(2)
+        fprintf(stderr, "Parsed game ID: %ld\n\n", *game_id);
+    DEBUG_END
+
+    return true;
+}
+
+static bool try_splitting_rounds(char* line, size_t* round_cnt, round_t** rounds, arena_t* arena) {
+
+    char* round_string;
+    const char delimiter[2] = ";";
+    char* rest = line;
+
+    round_string = strtok_r(line, delimiter, &rest);
+    while (round_string != NULL) {
+
+        // Reallocate memory for round struct pointer
+        *rounds = realloc(*rounds, ((*round_cnt)+1) * sizeof(round_t));
+        if (*rounds == NULL) {
+            perror("Error reallocating memory for rounds");
+            return false;
+        }
+
+        // Copy round string into the arena (released as a whole after solving)
+        round_t* round = &((*rounds)[*round_cnt]);
+        round->round_string = arena_strdup(arena, round_string);
+        if (round->round_string == NULL) {
+            perror("Error allocating memory for round string");
+            return false;
+        }
+        DEBUG_START(2)
+            fprintf(stderr, "Parsed round: %s\n", rawify(round->round_string));
+        DEBUG_END
+
+        (*round_cnt)++;
+
+        round_string = strtok_r(NULL, delimiter, &rest);
+    }
+
+    return true;
+}
+
+static bool try_parsing_rounds(size_t* round_cnt, round_t* rounds, regex_t* regexes, size_t* max_number_of_dice) {
+
+    for(int round_index=0; round_index<*round_cnt; ++round_index) {
+        round_t* round = &rounds[round_index];
+        round->number_of_dice[RED] = 0;
+        round->number_of_dice[GREEN] = 0;
+        round->number_of_dice[BLUE] = 0;
+        for(int color_index=0; color_index<COLOR_CNT; ++color_index) {
+            regex_t* regex = &regexes[color_index];
+            regmatch_t match_pos[1];
+            if(regexec(regex, round->round_string, 1, match_pos, 0) == 0) {
+                // Counts outside 1..MAX_DICE_COUNT fail the game, the caller reports the line
+                const char* amount_string = &round->round_string[(size_t)match_pos[0].rm_so];
+                size_t amount_len = (size_t)(match_pos[0].rm_eo - match_pos[0].rm_so);
+                uint64_t parsed_dice_amount;
+                size_t consumed;
+                if(!swar_try_parsing_uint(amount_string, amount_len, MAX_DICE_COUNT, &parsed_dice_amount, &consumed)
+                || parsed_dice_amount == 0) {
+                    fprintf(stderr, "Error: Dice count out of range (1..%d): %.*s\n",
+                            MAX_DICE_COUNT, (int)amount_len, amount_string);
+                    return false;
+                }
+                round->number_of_dice[color_index] = parsed_dice_amount;
+                if(parsed_dice_amount > max_number_of_dice[color_index]) {
+                    max_number_of_dice[color_index] = parsed_dice_amount;
+                }
+            }
+        }
+
+        DEBUG_START(2)
+            fprintf(stderr, "Round: %s\n", rawify(round->round_string));
+            fprintf(stderr, "R:%ld G:%ld B:%ld\n", round->number_of_dice[RED], round->number_of_dice[GREEN], round->number_of_dice[BLUE]);
+        DEBUG_END
+    }
+
+    return true;
+}
+
+static bool try_parsing_whatif_mode(const solver_options_t* options, const char** queries_file_name) {
+
+    *queries_file_name = NULL;
+    size_t prefix_len = strlen(WHATIF_MODE_PREFIX);
+    if(options->mode != NULL && strncmp(options->mode, WHATIF_MODE_PREFIX, prefix_len) == 0
+    && options->mode[prefix_len] != '\0') {
+        *queries_file_name = options->mode + prefix_len;
+        return true;
+    }
+    if(!solver_mode_is(options, "default")) {
+        fprintf(stderr, "Error: Unknown mode \"%s\" (default, pipeline, whatif:<file>)\n", options->mode);
+        return false;
+    }
+    return true;
+}
+
+// The answers of whatif queries are printed, a cached result would skip them.
+// A stale game cache is solved from its text, which the result cache key does not cover.
+static bool bypasses_result_cache(const solver_options_t* options, const char* file_name) {
+    if(options->mode != NULL && strncmp(options->mode, WHATIF_MODE_PREFIX, strlen(WHATIF_MODE_PREFIX)) == 0) {
+        return true;
+    }
+    return game_cache_file_is_stale(file_name);
+}
+
+// One query per line: "<red> <green> <blue>", empty lines and lines starting with '#' are skipped
+static bool try_parsing_limit_query(const char* line, uint32_t* limits, bool* is_query) {
+
+    const char* cursor = line;
+    while(*cursor == ' ' || *cursor == '\t') {
+        cursor++;
+    }
+    *is_query = *cursor != '\0' && *cursor != '\n' && *cursor != '#';
+    if(!*is_query) {
+        return true;
+    }
+    for(size_t color=0; color<COLOR_CNT; ++color) {
+        while(*cursor == ' ' || *cursor == '\t') {
+            cursor++;
+        }
+        uint64_t parsed_limit;
+        size_t consumed;
+        if(!swar_try_parsing_uint(cursor, strlen(cursor), UINT32_MAX, &parsed_limit, &consumed) || consumed == 0) {
+            return false;
+        }
+        limits[color] = (uint32_t)parsed_limit;
+        cursor += consumed;
+    }
+    return true;
+}
+
+static bool try_answering_limit_queries(const games_t* games, const char* queries_file_name) {
+
+    // Columnar copy of the per-game maxima, counts are at most MAX_DICE_COUNT
+    uint64_t* ids = malloc((games->game_cnt > 0 ? games->game_cnt : 1) * sizeof(uint64_t));
+    uint16_t* columns[COLOR_CNT];
+    bool successful = ids != NULL;
+    for(size_t color=0; color<COLOR_CNT; ++color) {
+        columns[color] = malloc((games->game_cnt > 0 ? games->game_cnt : 1) * sizeof(uint16_t));
+        successful = successful && columns[color] != NULL;
+    }
+    if(!successful) {
+        perror("Error allocating memory for limit columns");
+    }
+    for(size_t i=0; i<games->game_cnt && successful; ++i) {
+        ids[i] = games->all_games[i].id;
+        for(size_t color=0; color<COLOR_CNT; ++color) {
+            columns[color][i] = (uint16_t)games->all_games[i].max_number_of_dice[color];
+        }
+    }
+
+    const uint16_t* const const_columns[COLOR_CNT] = {columns[RED], columns[GREEN], columns[BLUE]};
+    successful = successful && try_answering_column_limit_queries(ids, const_columns, games->game_cnt,
+                                                                  queries_file_name);
+    free(ids);
+    for(size_t color=0; color<COLOR_CNT; ++color) {
+        free(columns[color]);
+    }
+    return successful;
+}
+
+// Answers the queries of queries_file_name from an index over the per-game maxima columns
+static bool try_answering_column_limit_queries(const uint64_t* ids, const uint16_t* const columns[COLOR_CNT],
+                                               size_t games_cnt, const char* queries_file_name) {
+
+    FILE* queries_file;
+    if(!try_opening_file(queries_file_name, &queries_file)) {
+        return false;
+    }
+
+    limit_index_t index;
+    bool index_built = try_building_limit_index(ids, columns, games_cnt, &index);
+    bool successful = index_built;
+
+    char* line = NULL;
+    size_t line_size = 0;
+    size_t line_number = 0;
+    size_t queries_cnt = 0;
+    int64_t start_time = micros();
+    while(successful && getline(&line, &line_size, queries_file) != -1) {
+        line_number++;
+        uint32_t limits[COLOR_CNT];
+        bool is_query;
+        if(!try_parsing_limit_query(line, limits, &is_query)) {
+            fprintf(stderr, "Error: Invalid query at %s:%zu (expected \"red green blue\")\n",
+                    queries_file_name, line_number);
+            successful = false;
+            break;
+        }
+        if(!is_query) {
+            continue;
+        }
+        limit_query_result_t answer = query_limit_index(&index, limits);
+        printf("r=%u g=%u b=%u: %" PRIu64 " games, id sum %" PRIu64 "\n",
+               limits[RED], limits[GREEN], limits[BLUE], answer.games_cnt, answer.id_sum);
+        queries_cnt++;
+    }
+    if(successful) {
+        int64_t elapsed = micros() - start_time;
+        fprintf(stderr, "Answered %zu limit queries in %ld us (%s)\n", queries_cnt, (long)elapsed,
+                index.prefix_games_cnt != NULL ? "prefix table" : "red-sorted scan");
+    }
+    if(index_built) {
+        destroy_limit_index(&index);
+    }
+
+    free(line);
+    fclose(queries_file);
+    return successful;
+}
+
+static bool try_opening_game_export(const char* file_name, export_writer_t** writer) {
+
+    export_binary_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, EXPORT_MAGIC, strlen(EXPORT_MAGIC));
+    header.version = EXPORT_VERSION;
+    header.record_size = sizeof(game_record_t);
+    return try_opening_export_writer(file_name, EXPORT_CSV_HEADER, &header, writer);
+}
+
+static bool try_exporting_game(export_writer_t* writer, bool binary, const single_game_t* game,
+                               size_t power, bool is_valid) {
+
+    char* out = export_reserve(writer, binary ? sizeof(game_record_t) : EXPORT_MAX_RECORD_LEN);
+    if(out == NULL) {
+        return false;
+    }
+    if(binary) {
+        // Counts are at most MAX_DICE_COUNT (see try_parsing_rounds)
+        game_record_t record = {
+            .id = game->id,
+            .power = power,
+            .max_number_of_dice = {(uint16_t)game->max_number_of_dice[RED],
+                                   (uint16_t)game->max_number_of_dice[GREEN],
+                                   (uint16_t)game->max_number_of_dice[BLUE]},
+            .valid = is_valid ? 1 : 0,
+            .reserved = 0
+        };
+        memcpy(out, &record, sizeof(record));
+        export_commit(writer, out + sizeof(record));
+        return true;
+    }
+    out = export_format_u64(out, game->id);
+    for(size_t color=0; color<COLOR_CNT; ++color) {
+        *out++ = ',';
+        out = export_format_u64(out, game->max_number_of_dice[color]);
+    }
+    *out++ = ',';
+    out = export_format_u64(out, power);
+    *out++ = ',';
+    *out++ = is_valid ? '1' : '0';
+    *out++ = '\n';
+    export_commit(writer, out);
+    return true;
+}
+
+// Pipeline Mode
+// ################################################
+
+// Parser stage: game id and maxima of every line, rounds are dropped right away
+static bool parse_game_batch(void* context, pipeline_batch_t* batch) {
+
+    pipeline_context_t* pipeline_context = (pipeline_context_t*)context;
+    solver_state_t* solver_state = pipeline_context->solver_state;
+    parsed_game_t* parsed_games = (parsed_game_t*)batch->parsed;
+    const char* previous_stage = profiler_enter_stage("02 pipeline parser");
+
+    for(size_t i=0; i<batch->lines_cnt; ++i) {
+        size_t line_len = batch->line_lens[i];
+        if(line_len + 1 > pipeline_context->line_capacity) {
+            char* grown_line = realloc(pipeline_context->line, line_len + 1);
+            if(grown_line == NULL) {
+                perror("Error allocating memory for line");
+                return false;
+            }
+            pipeline_context->line = grown_line;
+            pipeline_context->line_capacity = line_len + 1;
+        }
+        char* line = pipeline_context->line;
+        memcpy(line, batch->lines[i], line_len);
+        line[line_len] = '\0';
+
+        single_game_t game = {0, 0, NULL, {0, 0, 0}};
+        ssize_t read_bytes = (ssize_t)line_len;
+        bool parsed = try_parsing_game_id(&read_bytes, line, &game.id)
+                   && try_splitting_rounds(line, &game.round_cnt, &game.rounds, &solver_state->arena)
+                   && try_parsing_rounds(&game.round_cnt, game.rounds, solver_state->regexes, game.max_number_of_dice);
+        free(game.rounds);
+        if(!parsed) {
+            fprintf(stderr, "Error parsing game at line %zu\n", batch->first_line_number + i + 1);
+            profiler_exit_stage(previous_stage);
+            return false;
+        }
+        parsed_games[i].id = game.id;
+        memcpy(parsed_games[i].max_number_of_dice, game.max_number_of_dice, sizeof(game.max_number_of_dice));
+    }
+    reset_arena(&solver_state->arena);
+    profiler_exit_stage(previous_stage);
+    return true;
+}
+
+// Solver stage: validity and power per game
+static bool solve_game_batch(void* context, const pipeline_batch_t* batch) {
+
+    pipeline_context_t* pipeline_context = (pipeline_context_t*)context;
+    const parsed_game_t* parsed_games = (const parsed_game_t*)batch->parsed;
+    const char* previous_stage = profiler_enter_stage("02 pipeline solver");
+
+    for(size_t i=0; i<batch->lines_cnt; ++i) {
+        bool game_is_valid = true;
+        size_t game_power = 1;
+        for(int color_id=0; color_id<COLOR_CNT; ++color_id) {
+            if(parsed_games[i].max_number_of_dice[color_id] > pipeline_context->max_dice[color_id]) {
+                game_is_valid = false;
+            }
+            game_power *= parsed_games[i].max_number_of_dice[color_id];
+        }
+        if(game_is_valid) {
+            pipeline_context->sum_valid_game_ids += parsed_games[i].id;
+        }
+        pipeline_context->sum_game_powers += game_power;
+    }
+    profiler_exit_stage(previous_stage);
+    return true;
+}
+
+static bool try_solving_with_pipeline(solver_state_t* solver_state, line_reader_t* reader, solver_result_t* result) {
+
+    const size_t max_dice[COLOR_CNT] = {RED_MAX_DICE, GREEN_MAX_DICE, BLUE_MAX_DICE};
+    pipeline_context_t context = {
+        .solver_state = solver_state,
+        .line = NULL,
+        .line_capacity = 0,
+        .max_dice = max_dice,
+        .sum_valid_game_ids = 0,
+        .sum_game_powers = 0
+    };
+    const pipeline_stages_t stages = {
+        .context = &context,
+        .parsed_item_size = sizeof(parsed_game_t),
+        .parse = parse_game_batch,
+        .solve = solve_game_batch
+    };
+
+    pipeline_stats_t stats;
+    bool successful = try_running_pipeline(reader, &stages, &stats);
+    free(context.line);
+    reset_arena(&solver_state->arena);
+    if(!successful) {
+        return false;
+    }
+
+    DEBUG_START(1)
+        fprintf(stderr, "Pipeline: reader %ld us, parser %ld us, solver %ld us, wall %ld us\n",
+                (long)stats.reader_us, (long)stats.parser_us, (long)stats.solver_us, (long)stats.wall_us);
+    DEBUG_END
+
+    result->part_one = (int64_t)context.sum_valid_game_ids;
+    result->part_two = (int64_t)context.sum_game_powers;
+    result->has_part_two = true;
+    return true;
+}
+
+// Game Cache
+// ################################################
+
+// Answers part 1 and 2 (or the what-if queries) from the cache columns, or from
+// the text input when that changed since the conversion
+static bool try_solving_game_cache(void* state,
+                                   const solver_options_t* options,
+                                   const char* input,
+                                   size_t input_size,
+                                   solver_result_t* result) {
+
+    game_cache_t cache;
+    if(!try_mapping_game_cache(input, input_size, &cache)) {
+        return false;
+    }
+
+    if(game_cache_is_stale(&cache)) {
+        fprintf(stderr, "Note: %s changed since the game cache was written, solving the text (convert it again)\n",
+                cache.header->source_path);
+        input_t source;
+        if(!try_loading_input(cache.header->source_path, &source)) {
+            return false;
+        }
+        line_reader_t reader;
+        init_buffer_line_reader(&reader, source.data, source.size);
+        bool solved = decrypt_riddle_value_lines(state, options, &reader, result);
+        release_input(&source);
+        return solved;
+    }
+
+    if(options->export_file_name != NULL) {
+        fprintf(stderr, "Error: Export is not available for game caches\n");
+        return false;
+    }
+    if(solver_mode_is(options, "pipeline")) {
+        fprintf(stderr, "Error: The pipeline mode needs a text input\n");
+        return false;
+    }
+    const char* queries_file_name;
+    if(!try_parsing_whatif_mode(options, &queries_file_name)) {
+        return false;
+    }
+    mem_stats_record("game cache (mapped)", input_size);
+
+    // Same columns as the limit index, the hot loop only touches 14 bytes per game
+    const size_t max_dice[COLOR_CNT] = {RED_MAX_DICE, GREEN_MAX_DICE, BLUE_MAX_DICE};
+    uint64_t sum_valid_game_ids = 0;
+    uint64_t sum_game_powers = 0;
+    for(uint64_t i=0; i<cache.games_cnt; ++i) {
+        uint16_t red = cache.max_dice[RED][i];
+        uint16_t green = cache.max_dice[GREEN][i];
+        uint16_t blue = cache.max_dice[BLUE][i];
+        if(red <= max_dice[RED] && green <= max_dice[GREEN] && blue <= max_dice[BLUE]) {
+            sum_valid_game_ids += cache.id[i];
+        }
+        sum_game_powers += (uint64_t)red * green * blue;
+    }
+
+    if(queries_file_name != NULL
+    && !try_answering_column_limit_queries(cache.id, cache.max_dice, (size_t)cache.games_cnt, queries_file_name)) {
+        return false;
+    }
+
+    result->part_one = (int64_t)sum_valid_game_ids;
+    result->part_two = (int64_t)sum_game_powers;
+    result->has_part_two = true;
+    return true;
+}
+
+bool try_converting_games(const char* input_file_name, const char* output_file_name, bool with_rounds) {
+
+    void* state;
+    if(!try_initializing_state(&state)) {
+        return false;
+    }
+    solver_state_t* solver_state = (solver_state_t*)state;
+    input_t input;
+    if(!try_loading_input(input_file_name, &input)) {
+        destroy_state(state);
+        return false;
+    }
+    if(is_game_cache(input.data, input.size)) {
+        fprintf(stderr, "Error: %s is already a game cache\n", input_file_name);
+        release_input(&input);
+        destroy_state(state);
+        return false;
+    }
+
+    game_cache_builder_t builder;
+    init_game_cache_builder(&builder, with_rounds);
+    char* line = NULL;
+    size_t line_capacity = 0;
+    uint16_t* round_dice = NULL;
+    size_t round_dice_capacity = 0;
+    bool successful = true;
+
+    // Same parsing as the text solver, so both answer alike
+    const char* cursor = input.data;
+    const char* input_end = input.data + input.size;
+    const char* input_line;
+    size_t input_line_len;
+    size_t line_number = 0;
+    while(successful && next_line(&cursor, input_end, &input_line, &input_line_len)) {
+        line_number++;
+        if(input_line_len + 1 > line_capacity) {
+            char* grown_line = realloc(line, input_line_len + 1);
+            if(grown_line == NULL) {
+                perror("Error allocating memory for line");
+                successful = false;
+                break;
+            }
+            line = grown_line;
+            line_capacity = input_line_len + 1;
+        }
+        memcpy(line, input_line, input_line_len);
+        line[input_line_len] = '\0';
+
+        single_game_t game = {0, 0, NULL, {0, 0, 0}};
+        ssize_t read_bytes = (ssize_t)input_line_len;
+        successful = try_parsing_game_id(&read_bytes, line, &game.id)
+                  && try_splitting_rounds(line, &game.round_cnt, &game.rounds, &solver_state->arena)
+                  && try_parsing_rounds(&game.round_cnt, game.rounds, solver_state->regexes, game.max_number_of_dice);
+        if(!successful) {
+            fprintf(stderr, "Error parsing game at line %zu\n", line_number);
+        }
+        if(successful && game.round_cnt > UINT32_MAX) {
+            fprintf(stderr, "Error: Game at line %zu has too many rounds\n", line_number);
+            successful = false;
+        }
+        if(successful && with_rounds && game.round_cnt * COLOR_CNT > round_dice_capacity) {
+            uint16_t* grown_round_dice = realloc(round_dice, game.round_cnt * COLOR_CNT * sizeof(uint16_t));
+            if(grown_round_dice == NULL) {
+                perror("Error allocating memory for round counts");
+                successful = false;
+            } else {
+                round_dice = grown_round_dice;
+                round_dice_capacity = game.round_cnt * COLOR_CNT;
+            }
+        }
+        if(successful) {
+            // Counts are at most MAX_DICE_COUNT (see try_parsing_rounds)
+            uint16_t max_dice[COLOR_CNT];
+            for(size_t color=0; color<COLOR_CNT; ++color) {
+                max_dice[color] = (uint16_t)game.max_number_of_dice[color];
+                for(size_t round=0; round<game.round_cnt && with_rounds; ++round) {
+                    round_dice[round * COLOR_CNT + color] = (uint16_t)game.rounds[round].number_of_dice[color];
+                }
+            }
+            successful = try_adding_cached_game(&builder, game.id, max_dice, (uint32_t)game.round_cnt, round_dice);
+        }
+        free(game.rounds);
+        reset_arena(&solver_state->arena);
+    }
+
+    successful = successful && try_writing_game_cache(&builder, input_file_name, output_file_name);
+
+    free(line);
+    free(round_dice);
+    destroy_game_cache_builder(&builder);
+    release_input(&input);
+    destroy_state(state);
+    return successful;
+}
+
+static bool decrypt_riddle_value(void* state,
+                                 const solver_options_t* options,
+                                 const char* input,
+                                 size_t input_size,
+                                 solver_result_t* result) {
+
+    // Games converted by convert_games are solved from their columns
+    if(is_game_cache(input, input_size)) {
+        return try_solving_game_cache(state, options, input, input_size, result);
+    }
+
+    line_reader_t reader;
+    init_buffer_line_reader(&reader, input, input_size);
+    return decrypt_riddle_value_lines(state, options, &reader, result);
+}
+
+static bool decrypt_riddle_value_lines(void* state,
+                                       const solver_options_t* options,
+                                       line_reader_t* reader,
+                                       solver_result_t* result) {
+
+    // Parsing and solving on their own threads, overlapping the reader
+    if(solver_mode_is(options, "pipeline")) {
+        if(options->export_file_name != NULL) {
+            fprintf(stderr, "Error: The pipeline mode does not support exports\n");
+            return false;
+        }
+        return try_solving_with_pipeline((solver_state_t*)state, reader, result);
+    }
+
+    bool failure = false;
+
+    // Declare counting variables for the end results
+    size_t sum_valid_game_ids = 0;
+    size_t* valid_game_ids = NULL;
+    size_t valid_game_ids_cnt = 0;
+    // -------------
+    size_t cur_game_power = 1;
+    size_t sum_game_powers = 0;
+    size_t* game_powers = NULL;
+    size_t game_powers_cnt = 0;
+
+    const char* queries_file_name;
+    if(!try_parsing_whatif_mode(options, &queries_file_name)) {
+        failure = true;
+        goto cleanup_stage_0;
+    }
+
+    // Regexes are compiled once per solver state
+    solver_state_t* solver_state = (solver_state_t*)state;
+    regex_t* regexes = solver_state->regexes;
+
+    // Set up games struct
+    games_t* games = malloc(sizeof(games_t));
+    if(games == NULL) {
+        perror("Error allocating memory for games");
+        failure = true;
+        goto cleanup_stage_0;
+    }
+    games->game_cnt = 0;
+    games->games_capacity = 0;
+    games->all_games = NULL;
+    games->max_dice[RED] = RED_MAX_DICE;
+    games->max_dice[GREEN] = GREEN_MAX_DICE;
+    games->max_dice[BLUE] = BLUE_MAX_DICE;
+
+    // Per-game results are formatted here and written on the export thread
+    export_writer_t* exporter = NULL;
+    bool export_binary = false;
+    if(options->export_file_name != NULL) {
+        if(!try_opening_game_export(options->export_file_name, &exporter)) {
+            free(games);
+            failure = true;
+            goto cleanup_stage_0;
+        }
+        export_binary = export_format_for(options->export_file_name) == EXPORT_FORMAT_BINARY;
+    }
+
+    // Stage tags for AOC_PROFILE, the reader counts as part of the line loop
+    const char* previous_stage = profiler_enter_stage("02 read line");
+
+    // Read each input line into a writable, terminated copy
+    char *line = NULL;
+    size_t len = 0;
+    ssize_t read_bytes;
+    const char* input_line;
+    size_t input_line_len;
+    while (read_line(reader, &input_line, &input_line_len)) {
+
+        if(input_line_len + 1 > len) {
+            char* grown_line = realloc(line, input_line_len + 1);
+            if(grown_line == NULL) {
+                perror("Error allocating memory for line");
+                failure = true;
+                goto cleanup_stage_3;
+            }
+            line = grown_line;
+            len = input_line_len + 1;
+        }
+        memcpy(line, input_line, input_line_len);
+        line[input_line_len] = '\0';
+        read_bytes = (ssize_t)input_line_len;
+
+        // Set up single game struct, the games array doubles when full
+        if(games->game_cnt == games->games_capacity) {
+            size_t grown_capacity = (games->games_capacity > 0) ? games->games_capacity * 2 : INITIAL_GAMES_CAPACITY;
+            single_game_t* grown_games = realloc(games->all_games, grown_capacity * sizeof(single_game_t));
+            if(grown_games == NULL) {
+                perror("Error allocating memory for game");
+                failure = true;
+                goto cleanup_stage_3;
+            }
+            games->all_games = grown_games;
+            games->games_capacity = grown_capacity;
+        }
+        single_game_t* single_game = &games->all_games[games->game_cnt];
+        single_game->id = 0;
+        single_game->round_cnt = 0;
+        single_game->rounds = NULL;
+        single_game->max_number_of_dice[RED] = 0;
+        single_game->max_number_of_dice[GREEN] = 0;
+        single_game->max_number_of_dice[BLUE] = 0;
+        games->game_cnt++;
+        
+        // Get single game id
+        if(!try_parsing_game_id(&read_bytes, line, &single_game->id)) {
+            fprintf(stderr, "Error parsing game id at line %zu\n", games->game_cnt);
+            failure = true;
+            goto cleanup_stage_3;
+        }
+        
+        // Split rounds via ";"
+        profiler_enter_stage("02 split rounds");
+        if(!try_splitting_rounds(line, &single_game->round_cnt, &single_game->rounds, &solver_state->arena)) {
+            fprintf(stderr, "Error parsing rounds at line %zu\n", games->game_cnt);
+            failure = true;
+            goto cleanup_stage_3;
+        }
+
+        // Parse rounds via regex and update max number of dice
+        profiler_enter_stage("02 parse rounds");
+        if(!try_parsing_rounds(&single_game->round_cnt, single_game->rounds, regexes, single_game->max_number_of_dice)) {
+            fprintf(stderr, "Error parsing rounds at line %zu\n", games->game_cnt);
+            failure = true;
+            goto cleanup_stage_3;
+        }
+
+        // Calculate sum of invalid game ids and game powers
+        bool game_is_valid = true;
+        for(int color_id=0; color_id<COLOR_CNT; ++color_id) {
+            if(single_game->max_number_of_dice[color_id] > games->max_dice[color_id]) {
+                game_is_valid = false; 
+            }
+            cur_game_power *= single_game->max_number_of_dice[color_id];
+        }
+
+        if(exporter != NULL && !try_exporting_game(exporter, export_binary, single_game, cur_game_power, game_is_valid)) {
+            failure = true;
+            goto cleanup_stage_3;
+        }
+
+        // Update end result - valid games
+        if(game_is_valid) {
+            valid_game_ids = realloc(valid_game_ids, (valid_game_ids_cnt+1) * sizeof(size_t));
+            if(valid_game_ids == NULL) {
+                perror("Error reallocating memory for invalid game ids");
+                failure = true;
+                goto cleanup_stage_3;
+            }
+            valid_game_ids[valid_game_ids_cnt] = single_game->id;
+            valid_game_ids_cnt++;
+            sum_valid_game_ids += single_game->id;
+        }
+
+        // Update end result - game powers
+        game_powers = realloc(game_powers, (game_powers_cnt+1) * sizeof(size_t));
+        if(game_powers == NULL) {
+            perror("Error reallocating memory for game powers");
+            failure = true;
+            goto cleanup_stage_3;
+        }
+        game_powers[game_powers_cnt] = cur_game_power;
+        game_powers_cnt++;
+        sum_game_powers += cur_game_power;
+        cur_game_power = 1;
+        profiler_enter_stage("02 read line");
+    }
+    profiler_enter_stage("02 finish");
+
+    DEBUG_START(1)
+    // Print invalid ids and their game strings
+    for(size_t i=0; i<valid_game_ids_cnt; ++i) {
+        fprintf(stderr, "%ld. Valid game ID: %ld\n", (i+1), valid_game_ids[i]);
+    }
+    fprintf(stderr, "----------------------\n");
+    fprintf(stderr, "Sum of valid game IDs: %ld\n\n", sum_valid_game_ids);
+
+
+    // Print game powers per game
+    for(size_t i=0; i<game_powers_cnt; i++) {
+        fprintf(stderr, "%ld. Game Power: %ld\n", (i+1), game_powers[i]);
+    }
+    fprintf(stderr, "----------------------\n");
+    fprintf(stderr, "Sum of Game Powers: %ld\n\n", sum_game_powers);
+    DEBUG_END
+
+    // Footprint of the parsed input, reported in the end banner
+    size_t games_bytes = sizeof(games_t) + games->games_capacity * sizeof(single_game_t);
+    for(size_t i=0; i<games->game_cnt; ++i) {
+        games_bytes += games->all_games[i].round_cnt * sizeof(round_t);
+    }
+    mem_stats_record("games/rounds", games_bytes);
+    mem_stats_record("round strings (arena)", solver_state->arena.bytes_allocated);
+    mem_stats_record("line buffer", len);
+    mem_stats_record("result lists", (valid_game_ids_cnt + game_powers_cnt) * sizeof(size_t));
+
+    // What-if limits are answered from an index over the parsed games
+    if(queries_file_name != NULL && !try_answering_limit_queries(games, queries_file_name)) {
+        failure = true;
+        goto cleanup_stage_3;
+    }
+
+    result->part_one = (int64_t)sum_valid_game_ids;
+    result->part_two = (int64_t)sum_game_powers;
+    result->has_part_two = true;
+
+    // Clean up
+    cleanup_stage_3:
+        if(exporter != NULL && !try_closing_export_writer(exporter)) {
+            failure = true;
+        }
+        free(valid_game_ids);
+        free(game_powers);
+
+        free(line);
+
+        for(size_t i=0; i<games->game_cnt; ++i) {
+            free(games->all_games[i].rounds);
+        }
+        reset_arena(&solver_state->arena);
+        free(games->all_games);
+        free(games);
+        profiler_exit_stage(previous_stage);
+    cleanup_stage_0:
+        return !failure;
+}
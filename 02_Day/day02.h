@@ -0,0 +1,14 @@
+#ifndef DAY02_SOLVER_H
+#define DAY02_SOLVER_H
+
+#include <stdbool.h>
+
+#include "solver.h"
+
+extern const solver_t DAY02_SOLVER;
+
+// Parses a text input and writes its games as a columnar game cache (game_cache.h),
+// with_rounds also stores the counts of every round
+bool try_converting_games(const char* input_file_name, const char* output_file_name, bool with_rounds);
+
+#endif
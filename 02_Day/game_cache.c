@@ -0,0 +1,311 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>     // PATH_MAX
+#include <inttypes.h>   // uint64_t
+#include <unistd.h>     // getpid
+#include <sys/stat.h>   // stat
+
+#include "columns.h"
+#include "hash.h"
+#include "game_cache.h"
+
+// Definitions
+// ################################################
+
+#define CHECKSUM_SEED (0)
+
+// Helper Functions
+// ################################################
+
+static void place_section(char* file_data, uint64_t offset, const void* data, uint64_t size) {
+    if(size > 0) {
+        memcpy(file_data + offset, data, size);
+    }
+}
+
+// Builder
+// ################################################
+
+void init_game_cache_builder(game_cache_builder_t* builder, bool with_rounds) {
+    memset(builder, 0, sizeof(*builder));
+    builder->with_rounds = with_rounds;
+}
+
+bool try_adding_cached_game(game_cache_builder_t* builder,
+                            uint64_t id,
+                            const uint16_t* max_dice,
+                            uint32_t round_cnt,
+                            const uint16_t* round_dice) {
+
+    // +2: the round index also holds the end of the last game
+    void** game_arrays[] = {(void**)&builder->id, (void**)&builder->max_dice[0], (void**)&builder->max_dice[1],
+                            (void**)&builder->max_dice[2], (void**)&builder->round_cnt, (void**)&builder->round_index};
+    const size_t game_element_sizes[] = {sizeof(uint64_t), sizeof(uint16_t), sizeof(uint16_t),
+                                         sizeof(uint16_t), sizeof(uint32_t), sizeof(uint64_t)};
+    size_t game_arrays_cnt = builder->with_rounds ? 6 : 5;
+    if(!try_growing_arrays(game_arrays, game_element_sizes, game_arrays_cnt,
+                           &builder->games_capacity, (size_t)builder->games_cnt + 2, "game cache")) {
+        return false;
+    }
+
+    uint64_t game = builder->games_cnt;
+    builder->id[game] = id;
+    for(size_t color=0; color<GAME_CACHE_COLOR_CNT; ++color) {
+        builder->max_dice[color][game] = max_dice[color];
+    }
+    builder->round_cnt[game] = round_cnt;
+
+    if(builder->with_rounds) {
+        void** round_arrays[] = {(void**)&builder->round_dice[0], (void**)&builder->round_dice[1],
+                                 (void**)&builder->round_dice[2]};
+        const size_t round_element_sizes[] = {sizeof(uint16_t), sizeof(uint16_t), sizeof(uint16_t)};
+        if(!try_growing_arrays(round_arrays, round_element_sizes, GAME_CACHE_COLOR_CNT,
+                               &builder->rounds_capacity, (size_t)builder->rounds_cnt + round_cnt, "game cache")) {
+            return false;
+        }
+        builder->round_index[game] = builder->rounds_cnt;
+        for(uint32_t round=0; round<round_cnt; ++round) {
+            for(size_t color=0; color<GAME_CACHE_COLOR_CNT; ++color) {
+                builder->round_dice[color][builder->rounds_cnt] = round_dice[round * GAME_CACHE_COLOR_CNT + color];
+            }
+            builder->rounds_cnt++;
+        }
+        builder->round_index[game + 1] = builder->rounds_cnt;
+    }
+
+    builder->games_cnt++;
+    return true;
+}
+
+// Size, mtime and hash of the text input, so the loader can tell when it changed
+static bool try_recording_source(const char* source_file_name, game_cache_header_t* header) {
+
+    char resolved_path[PATH_MAX];
+    if(realpath(source_file_name, resolved_path) == NULL) {
+        perror("Error resolving text input path");
+        return false;
+    }
+    if(strlen(resolved_path) >= sizeof(header->source_path)) {
+        fprintf(stderr, "Error: Text input path is longer than %d bytes\n", GAME_CACHE_MAX_PATH - 1);
+        return false;
+    }
+    struct stat source_stat;
+    if(stat(resolved_path, &source_stat) == -1) {
+        perror("Error reading text input metadata");
+        return false;
+    }
+    if(!try_hashing_file(resolved_path, &header->source_hash)) {
+        return false;
+    }
+    strcpy(header->source_path, resolved_path);
+    header->source_size = (uint64_t)source_stat.st_size;
+    header->source_mtime_sec = (int64_t)source_stat.st_mtim.tv_sec;
+    header->source_mtime_nsec = (int64_t)source_stat.st_mtim.tv_nsec;
+    return true;
+}
+
+bool try_writing_game_cache(const game_cache_builder_t* builder,
+                            const char* source_file_name,
+                            const char* output_file_name) {
+
+    game_cache_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, GAME_CACHE_MAGIC, GAME_CACHE_MAGIC_LEN);
+    header.version = GAME_CACHE_VERSION;
+    header.header_size = sizeof(header);
+    header.flags = builder->with_rounds ? GAME_CACHE_FLAG_ROUNDS : 0;
+    header.games_cnt = builder->games_cnt;
+    header.rounds_cnt = builder->rounds_cnt;
+    if(!try_recording_source(source_file_name, &header)) {
+        return false;
+    }
+
+    uint64_t games = builder->games_cnt;
+    uint64_t offset = align_up(sizeof(header), GAME_CACHE_ALIGNMENT);
+    header.id_offset = offset;
+    offset = align_up(offset + games * sizeof(uint64_t), GAME_CACHE_ALIGNMENT);
+    for(size_t color=0; color<GAME_CACHE_COLOR_CNT; ++color) {
+        header.max_dice_offsets[color] = offset;
+        offset = align_up(offset + games * sizeof(uint16_t), GAME_CACHE_ALIGNMENT);
+    }
+    header.round_cnt_offset = offset;
+    offset = align_up(offset + games * sizeof(uint32_t), GAME_CACHE_ALIGNMENT);
+    if(builder->with_rounds) {
+        header.round_index_offset = offset;
+        offset = align_up(offset + (games + 1) * sizeof(uint64_t), GAME_CACHE_ALIGNMENT);
+        for(size_t color=0; color<GAME_CACHE_COLOR_CNT; ++color) {
+            header.round_dice_offsets[color] = offset;
+            offset = align_up(offset + builder->rounds_cnt * sizeof(uint16_t), GAME_CACHE_ALIGNMENT);
+        }
+    }
+
+    // The whole file is assembled in memory, the checksum covers it behind the header
+    char* file_data = calloc(1, (size_t)offset);
+    if(file_data == NULL) {
+        perror("Error allocating memory for game cache");
+        return false;
+    }
+    place_section(file_data, header.id_offset, builder->id, games * sizeof(uint64_t));
+    for(size_t color=0; color<GAME_CACHE_COLOR_CNT; ++color) {
+        place_section(file_data, header.max_dice_offsets[color], builder->max_dice[color], games * sizeof(uint16_t));
+    }
+    place_section(file_data, header.round_cnt_offset, builder->round_cnt, games * sizeof(uint32_t));
+    if(builder->with_rounds) {
+        uint64_t empty_round_index = 0;
+        const uint64_t* round_index = (games > 0) ? builder->round_index : &empty_round_index;
+        place_section(file_data, header.round_index_offset, round_index, (games + 1) * sizeof(uint64_t));
+        for(size_t color=0; color<GAME_CACHE_COLOR_CNT; ++color) {
+            place_section(file_data, header.round_dice_offsets[color], builder->round_dice[color],
+                          builder->rounds_cnt * sizeof(uint16_t));
+        }
+    }
+    header.payload_size = offset - sizeof(header);
+    header.checksum = xxh64(file_data + sizeof(header), (size_t)header.payload_size, CHECKSUM_SEED);
+    memcpy(file_data, &header, sizeof(header));
+
+    // Write next to the target and rename, so readers never map a half written file
+    char temp_path[4096];
+    int temp_path_len = snprintf(temp_path, sizeof(temp_path), "%s.%ld.tmp", output_file_name, (long)getpid());
+    if(temp_path_len < 0 || (size_t)temp_path_len >= sizeof(temp_path)) {
+        fprintf(stderr, "Error: Output path too long\n");
+        free(file_data);
+        return false;
+    }
+    FILE* file = fopen(temp_path, "wb");
+    if(file == NULL) {
+        perror("Error opening game cache for writing");
+        free(file_data);
+        return false;
+    }
+    bool success = fwrite(file_data, 1, (size_t)offset, file) == (size_t)offset;
+    if(fclose(file) != 0) {
+        success = false;
+    }
+    free(file_data);
+    if(!success) {
+        perror("Error writing game cache");
+        remove(temp_path);
+        return false;
+    }
+    if(rename(temp_path, output_file_name) == -1) {
+        perror("Error renaming game cache");
+        remove(temp_path);
+        return false;
+    }
+    return true;
+}
+
+void destroy_game_cache_builder(game_cache_builder_t* builder) {
+    free(builder->id);
+    free(builder->round_cnt);
+    free(builder->round_index);
+    for(size_t color=0; color<GAME_CACHE_COLOR_CNT; ++color) {
+        free(builder->max_dice[color]);
+        free(builder->round_dice[color]);
+    }
+}
+
+// Loader
+// ################################################
+
+bool is_game_cache(const char* input, size_t input_size) {
+    return input_size >= GAME_CACHE_MAGIC_LEN
+        && memcmp(input, GAME_CACHE_MAGIC, GAME_CACHE_MAGIC_LEN) == 0;
+}
+
+bool try_mapping_game_cache(const char* input, size_t input_size, game_cache_t* cache) {
+
+    if(input_size < sizeof(game_cache_header_t) || !is_game_cache(input, input_size)) {
+        fprintf(stderr, "Error: Not a game cache\n");
+        return false;
+    }
+    if((uintptr_t)input % sizeof(uint64_t) != 0) {
+        fprintf(stderr, "Error: Game cache buffer is not aligned\n");
+        return false;
+    }
+    const game_cache_header_t* header = (const game_cache_header_t*)(const void*)input;
+    if(header->version != GAME_CACHE_VERSION || header->header_size != sizeof(game_cache_header_t)) {
+        fprintf(stderr, "Error: Game cache version %u is not supported (expected %u), convert it again\n",
+                header->version, GAME_CACHE_VERSION);
+        return false;
+    }
+
+    uint64_t games = header->games_cnt;
+    bool with_rounds = (header->flags & GAME_CACHE_FLAG_ROUNDS) != 0;
+    bool valid = header->payload_size == input_size - sizeof(game_cache_header_t)
+        && memchr(header->source_path, '\0', sizeof(header->source_path)) != NULL
+        && section_is_valid(header->id_offset, games, sizeof(uint64_t), input_size)
+        && section_is_valid(header->round_cnt_offset, games, sizeof(uint32_t), input_size);
+    for(size_t color=0; color<GAME_CACHE_COLOR_CNT && valid; ++color) {
+        valid = section_is_valid(header->max_dice_offsets[color], games, sizeof(uint16_t), input_size)
+             && (!with_rounds
+              || section_is_valid(header->round_dice_offsets[color], header->rounds_cnt, sizeof(uint16_t), input_size));
+    }
+    valid = valid && (!with_rounds || (games < UINT64_MAX
+                   && section_is_valid(header->round_index_offset, games + 1, sizeof(uint64_t), input_size)));
+    if(!valid) {
+        fprintf(stderr, "Error: Game cache is truncated or corrupt\n");
+        return false;
+    }
+    if(xxh64(input + sizeof(game_cache_header_t), (size_t)header->payload_size, CHECKSUM_SEED) != header->checksum) {
+        fprintf(stderr, "Error: Game cache checksum mismatch, convert it again\n");
+        return false;
+    }
+
+    // Point straight into the mapped file, nothing is copied or parsed
+    memset(cache, 0, sizeof(*cache));
+    cache->games_cnt = games;
+    cache->rounds_cnt = with_rounds ? header->rounds_cnt : 0;
+    cache->id = (const uint64_t*)(const void*)(input + header->id_offset);
+    cache->round_cnt = (const uint32_t*)(const void*)(input + header->round_cnt_offset);
+    for(size_t color=0; color<GAME_CACHE_COLOR_CNT; ++color) {
+        cache->max_dice[color] = (const uint16_t*)(const void*)(input + header->max_dice_offsets[color]);
+        if(with_rounds) {
+            cache->round_dice[color] = (const uint16_t*)(const void*)(input + header->round_dice_offsets[color]);
+        }
+    }
+    if(with_rounds) {
+        cache->round_index = (const uint64_t*)(const void*)(input + header->round_index_offset);
+    }
+    cache->header = header;
+    return true;
+}
+
+static bool source_is_stale(const game_cache_header_t* header) {
+
+    struct stat source_stat;
+    if(stat(header->source_path, &source_stat) == -1) {
+        return false;
+    }
+    if((uint64_t)source_stat.st_size != header->source_size) {
+        return true;
+    }
+    if((int64_t)source_stat.st_mtim.tv_sec == header->source_mtime_sec
+    && (int64_t)source_stat.st_mtim.tv_nsec == header->source_mtime_nsec) {
+        return false;
+    }
+    // Touched but maybe unchanged: the content decides
+    uint64_t source_hash;
+    return !try_hashing_file(header->source_path, &source_hash) || source_hash != header->source_hash;
+}
+
+bool game_cache_is_stale(const game_cache_t* cache) {
+    return source_is_stale(cache->header);
+}
+
+bool game_cache_file_is_stale(const char* file_name) {
+
+    FILE* file = fopen(file_name, "rb");
+    if(file == NULL) {
+        return false;
+    }
+    game_cache_header_t header;
+    bool has_header = fread(&header, sizeof(header), 1, file) == 1;
+    fclose(file);
+    if(!has_header || !is_game_cache(header.magic, sizeof(header)) || header.version != GAME_CACHE_VERSION
+    || memchr(header.source_path, '\0', sizeof(header.source_path)) == NULL) {
+        return false;
+    }
+    return source_is_stale(&header);
+}
@@ -0,0 +1,114 @@
+#ifndef DAY02_GAME_CACHE_H
+#define DAY02_GAME_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Columnar Game Cache
+// ################################################
+//
+// Parsed games of a 02 input, solved straight from the mapped file without
+// any text parsing. Layout (native little-endian, every section 64-byte aligned):
+//
+//   header                      game_cache_header_t
+//   game id                     uint64_t[games_cnt]
+//   max red, green, blue        uint16_t[games_cnt] each
+//   round count                 uint32_t[games_cnt]
+//   with GAME_CACHE_FLAG_ROUNDS:
+//   round index                 uint64_t[games_cnt+1], rounds of game i: [index[i], index[i+1])
+//   round red, green, blue      uint16_t[rounds_cnt] each
+//
+// checksum is the xxh64 of everything behind the header. The header also
+// records the text input the cache was converted from (absolute path, size,
+// mtime and xxh64), so a cache whose text changed is detected as stale.
+// The result cache (-c) keys on the cache file itself, so 02 bypasses it
+// for stale caches.
+//
+// Bump GAME_CACHE_VERSION on any layout change.
+
+#define GAME_CACHE_MAGIC "AOC02GMC"
+#define GAME_CACHE_MAGIC_LEN (8)
+#define GAME_CACHE_VERSION (1)
+#define GAME_CACHE_ALIGNMENT (64)
+#define GAME_CACHE_MAX_PATH (1024)
+#define GAME_CACHE_COLOR_CNT (3)    // red, green, blue
+
+// Per-round counts are stored
+#define GAME_CACHE_FLAG_ROUNDS (1u << 0)
+
+typedef struct {
+    char magic[GAME_CACHE_MAGIC_LEN];
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t flags;
+    uint32_t reserved;
+    uint64_t games_cnt;
+    uint64_t rounds_cnt;
+    uint64_t payload_size;
+    uint64_t checksum;
+    uint64_t source_size;
+    int64_t source_mtime_sec;
+    int64_t source_mtime_nsec;
+    uint64_t source_hash;
+    char source_path[GAME_CACHE_MAX_PATH];
+    uint64_t id_offset;
+    uint64_t max_dice_offsets[GAME_CACHE_COLOR_CNT];
+    uint64_t round_cnt_offset;
+    uint64_t round_index_offset;
+    uint64_t round_dice_offsets[GAME_CACHE_COLOR_CNT];
+} game_cache_header_t;
+
+// Growable columns, filled one game at a time by the converter
+typedef struct {
+    bool with_rounds;
+    uint64_t* id;
+    uint16_t* max_dice[GAME_CACHE_COLOR_CNT];
+    uint32_t* round_cnt;
+    uint64_t* round_index;
+    uint16_t* round_dice[GAME_CACHE_COLOR_CNT];
+    size_t games_capacity;
+    size_t rounds_capacity;
+    uint64_t games_cnt;
+    uint64_t rounds_cnt;
+} game_cache_builder_t;
+
+// Columns of a validated cache, pointing into the mapped file
+typedef struct {
+    uint64_t games_cnt;
+    uint64_t rounds_cnt;
+    const uint64_t* id;
+    const uint16_t* max_dice[GAME_CACHE_COLOR_CNT];
+    const uint32_t* round_cnt;
+    const uint64_t* round_index;                        // NULL without per-round counts
+    const uint16_t* round_dice[GAME_CACHE_COLOR_CNT];   // NULL without per-round counts
+    const game_cache_header_t* header;
+} game_cache_t;
+
+void init_game_cache_builder(game_cache_builder_t* builder, bool with_rounds);
+// round_dice holds round_cnt (red, green, blue) triples, ignored without rounds
+bool try_adding_cached_game(game_cache_builder_t* builder,
+                            uint64_t id,
+                            const uint16_t* max_dice,
+                            uint32_t round_cnt,
+                            const uint16_t* round_dice);
+// source_file_name is the text input the games were parsed from
+bool try_writing_game_cache(const game_cache_builder_t* builder,
+                            const char* source_file_name,
+                            const char* output_file_name);
+void destroy_game_cache_builder(game_cache_builder_t* builder);
+
+// True if input starts with the game cache magic
+bool is_game_cache(const char* input, size_t input_size);
+
+// Validates header, sections and checksum of a mapped cache
+bool try_mapping_game_cache(const char* input, size_t input_size, game_cache_t* cache);
+
+// True if the recorded text input changed since the conversion; a missing
+// text input is not stale, the cache is all there is
+bool game_cache_is_stale(const game_cache_t* cache);
+// Same for a cache file that is not mapped, only its header is read;
+// false if file_name is no game cache
+bool game_cache_file_is_stale(const char* file_name);
+
+#endif
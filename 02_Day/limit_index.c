@@ -0,0 +1,215 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "limit_index.h"
+
+// Definitions
+// ################################################
+
+#define RED (0)
+#define GREEN (1)
+#define BLUE (2)
+
+#define VALUE_CNT ((size_t)UINT16_MAX + 1)
+
+// Helper Functions
+// ################################################
+
+// Number of sorted values that are <= limit
+static size_t count_values_up_to(const uint16_t* values, size_t values_cnt, uint32_t limit) {
+    size_t low = 0;
+    size_t high = values_cnt;
+    while(low < high) {
+        size_t mid = low + (high - low) / 2;
+        if(values[mid] <= limit) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static size_t cell_index(const limit_index_t* index, size_t red_level, size_t green_level, size_t blue_level) {
+    size_t green_dim = index->levels_cnt[GREEN] + 1;
+    size_t blue_dim = index->levels_cnt[BLUE] + 1;
+    return (red_level * green_dim + green_level) * blue_dim + blue_level;
+}
+
+// Copies the columns ordered by red count (counting sort, counts are 16 bit)
+static bool try_sorting_columns_by_red(const uint64_t* ids,
+                                       const uint16_t* const max_dice[LIMIT_INDEX_COLOR_CNT],
+                                       size_t games_cnt,
+                                       limit_index_t* index) {
+
+    size_t* offsets = calloc(VALUE_CNT + 1, sizeof(size_t));
+    if(offsets == NULL) {
+        return false;
+    }
+    for(size_t game=0; game<games_cnt; ++game) {
+        offsets[max_dice[RED][game] + 1]++;
+    }
+    for(size_t value=0; value<VALUE_CNT; ++value) {
+        offsets[value + 1] += offsets[value];
+    }
+    for(size_t game=0; game<games_cnt; ++game) {
+        size_t target = offsets[max_dice[RED][game]]++;
+        index->ids[target] = ids[game];
+        for(size_t color=0; color<LIMIT_INDEX_COLOR_CNT; ++color) {
+            index->max_dice[color][target] = max_dice[color][game];
+        }
+    }
+    free(offsets);
+    return true;
+}
+
+// Collects the distinct counts of one color, rank_of[value] becomes its 1-based level
+static bool try_building_levels(const uint16_t* column, size_t games_cnt,
+                                uint16_t** levels, size_t* levels_cnt, uint32_t* rank_of) {
+
+    memset(rank_of, 0, VALUE_CNT * sizeof(uint32_t));
+    for(size_t game=0; game<games_cnt; ++game) {
+        rank_of[column[game]] = 1;
+    }
+    size_t cnt = 0;
+    for(size_t value=0; value<VALUE_CNT; ++value) {
+        cnt += rank_of[value];
+    }
+
+    *levels = malloc((cnt > 0 ? cnt : 1) * sizeof(uint16_t));
+    if(*levels == NULL) {
+        return false;
+    }
+    size_t level = 0;
+    for(size_t value=0; value<VALUE_CNT; ++value) {
+        if(rank_of[value] != 0) {
+            (*levels)[level++] = (uint16_t)value;
+            rank_of[value] = (uint32_t)level;
+        }
+    }
+    *levels_cnt = cnt;
+    return true;
+}
+
+static bool try_building_prefix_table(limit_index_t* index, uint32_t* const rank_of[LIMIT_INDEX_COLOR_CNT]) {
+
+    size_t dims[LIMIT_INDEX_COLOR_CNT];
+    size_t cells_cnt = 1;
+    for(size_t color=0; color<LIMIT_INDEX_COLOR_CNT; ++color) {
+        dims[color] = index->levels_cnt[color] + 1;
+        cells_cnt *= dims[color];
+    }
+    if(cells_cnt > LIMIT_INDEX_MAX_CELLS) {
+        return true;
+    }
+
+    uint64_t* games_cnt = calloc(cells_cnt, sizeof(uint64_t));
+    uint64_t* id_sum = calloc(cells_cnt, sizeof(uint64_t));
+    if(games_cnt == NULL || id_sum == NULL) {
+        free(games_cnt);
+        free(id_sum);
+        return false;
+    }
+
+    for(size_t game=0; game<index->games_cnt; ++game) {
+        size_t cell = cell_index(index,
+                                 rank_of[RED][index->max_dice[RED][game]],
+                                 rank_of[GREEN][index->max_dice[GREEN][game]],
+                                 rank_of[BLUE][index->max_dice[BLUE][game]]);
+        games_cnt[cell]++;
+        id_sum[cell] += index->ids[game];
+    }
+
+    // One running sum per axis turns the cells into dominance counts
+    size_t strides[LIMIT_INDEX_COLOR_CNT] = {dims[GREEN] * dims[BLUE], dims[BLUE], 1};
+    for(size_t color=0; color<LIMIT_INDEX_COLOR_CNT; ++color) {
+        size_t stride = strides[color];
+        for(size_t cell=0; cell<cells_cnt; ++cell) {
+            if((cell / stride) % dims[color] != 0) {
+                games_cnt[cell] += games_cnt[cell - stride];
+                id_sum[cell] += id_sum[cell - stride];
+            }
+        }
+    }
+
+    index->prefix_games_cnt = games_cnt;
+    index->prefix_id_sum = id_sum;
+    return true;
+}
+
+// Limit Index
+// ################################################
+
+bool try_building_limit_index(const uint64_t* ids,
+                              const uint16_t* const max_dice[LIMIT_INDEX_COLOR_CNT],
+                              size_t games_cnt,
+                              limit_index_t* index) {
+
+    memset(index, 0, sizeof(limit_index_t));
+    index->games_cnt = games_cnt;
+
+    bool successful = true;
+    size_t column_cnt = games_cnt > 0 ? games_cnt : 1;
+    index->ids = malloc(column_cnt * sizeof(uint64_t));
+    successful = index->ids != NULL;
+    for(size_t color=0; color<LIMIT_INDEX_COLOR_CNT && successful; ++color) {
+        index->max_dice[color] = malloc(column_cnt * sizeof(uint16_t));
+        successful = index->max_dice[color] != NULL;
+    }
+    successful = successful && try_sorting_columns_by_red(ids, max_dice, games_cnt, index);
+
+    uint32_t* rank_of[LIMIT_INDEX_COLOR_CNT] = {NULL, NULL, NULL};
+    for(size_t color=0; color<LIMIT_INDEX_COLOR_CNT && successful; ++color) {
+        rank_of[color] = malloc(VALUE_CNT * sizeof(uint32_t));
+        successful = rank_of[color] != NULL
+                  && try_building_levels(index->max_dice[color], games_cnt,
+                                         &index->levels[color], &index->levels_cnt[color], rank_of[color]);
+    }
+    successful = successful && try_building_prefix_table(index, rank_of);
+
+    for(size_t color=0; color<LIMIT_INDEX_COLOR_CNT; ++color) {
+        free(rank_of[color]);
+    }
+    if(!successful) {
+        fprintf(stderr, "Error allocating memory for limit index\n");
+        destroy_limit_index(index);
+    }
+    return successful;
+}
+
+void destroy_limit_index(limit_index_t* index) {
+    free(index->ids);
+    for(size_t color=0; color<LIMIT_INDEX_COLOR_CNT; ++color) {
+        free(index->max_dice[color]);
+        free(index->levels[color]);
+    }
+    free(index->prefix_games_cnt);
+    free(index->prefix_id_sum);
+    memset(index, 0, sizeof(limit_index_t));
+}
+
+limit_query_result_t query_limit_index(const limit_index_t* index, const uint32_t limits[LIMIT_INDEX_COLOR_CNT]) {
+
+    limit_query_result_t result = {0, 0};
+
+    if(index->prefix_games_cnt != NULL) {
+        size_t level[LIMIT_INDEX_COLOR_CNT];
+        for(size_t color=0; color<LIMIT_INDEX_COLOR_CNT; ++color) {
+            level[color] = count_values_up_to(index->levels[color], index->levels_cnt[color], limits[color]);
+        }
+        size_t cell = cell_index(index, level[RED], level[GREEN], level[BLUE]);
+        result.games_cnt = index->prefix_games_cnt[cell];
+        result.id_sum = index->prefix_id_sum[cell];
+        return result;
+    }
+
+    size_t candidates_cnt = count_values_up_to(index->max_dice[RED], index->games_cnt, limits[RED]);
+    for(size_t game=0; game<candidates_cnt; ++game) {
+        if(index->max_dice[GREEN][game] <= limits[GREEN] && index->max_dice[BLUE][game] <= limits[BLUE]) {
+            result.games_cnt++;
+            result.id_sum += index->ids[game];
+        }
+    }
+    return result;
+}
@@ -0,0 +1,53 @@
+#ifndef DAY02_LIMIT_INDEX_H
+#define DAY02_LIMIT_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Bag Limit Index
+// ################################################
+//
+// Answers "which games are possible with at most r red, g green and b blue
+// dice" for many limits without touching the input again. The per-game max
+// counts are stored as columns; the distinct values of each color are
+// compressed to levels and a 3D prefix table over the levels holds the
+// number and id sum of all games dominated by a cell. A query is three binary
+// searches and one table lookup.
+//
+// Inputs with too many distinct counts (table above LIMIT_INDEX_MAX_CELLS)
+// fall back to the games sorted by red: a binary search bounds the candidates,
+// green and blue are checked per game.
+
+#define LIMIT_INDEX_COLOR_CNT (3)
+#define LIMIT_INDEX_MAX_CELLS ((size_t)1 << 21)
+
+typedef struct {
+    size_t games_cnt;
+    // Columns in red-sorted order
+    uint64_t* ids;
+    uint16_t* max_dice[LIMIT_INDEX_COLOR_CNT];
+    // Sorted distinct counts per color
+    uint16_t* levels[LIMIT_INDEX_COLOR_CNT];
+    size_t levels_cnt[LIMIT_INDEX_COLOR_CNT];
+    // (levels_cnt+1)^3 cells, NULL when the red-sorted fallback is used
+    uint64_t* prefix_games_cnt;
+    uint64_t* prefix_id_sum;
+} limit_index_t;
+
+typedef struct {
+    uint64_t games_cnt;
+    uint64_t id_sum;
+} limit_query_result_t;
+
+// max_dice[color][game] is the largest count of that color shown in the game
+bool try_building_limit_index(const uint64_t* ids,
+                              const uint16_t* const max_dice[LIMIT_INDEX_COLOR_CNT],
+                              size_t games_cnt,
+                              limit_index_t* index);
+void destroy_limit_index(limit_index_t* index);
+
+// Games whose max counts are all within the limits (red, green, blue)
+limit_query_result_t query_limit_index(const limit_index_t* index, const uint32_t limits[LIMIT_INDEX_COLOR_CNT]);
+
+#endif
@@ -0,0 +1,42 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "input.h"
+#include "utils.h"
+#include "schematic_binary.h"
+
+// Converter
+// ################################################
+//
+// Precompiles a text schematic into the binary format of schematic_binary.h.
+// The 03 solver (and the runner) accept the result in place of the text input:
+//   ./convert_schematic input_very_big.txt input_very_big.bin
+//   ./main input_very_big.bin
+
+int main(int argc, char* argv[]) {
+
+    if(argc != 3) {
+        fprintf(stderr, "Usage: %s input.txt output.bin\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int64_t start = millis();
+
+    input_t input;
+    if(!try_loading_input(argv[1], &input)) {
+        return EXIT_FAILURE;
+    }
+    if(is_binary_schematic(input.data, input.size)) {
+        fprintf(stderr, "Error: %s is already a binary schematic\n", argv[1]);
+        release_input(&input);
+        return EXIT_FAILURE;
+    }
+    bool converted = try_converting_schematic(input.data, input.size, argv[2]);
+    release_input(&input);
+    if(!converted) {
+        return EXIT_FAILURE;
+    }
+
+    fprintf(stdout, "Converted %s to %s in %ld ms\n", argv[1], argv[2], (long)(millis() - start));
+    return EXIT_SUCCESS;
+}
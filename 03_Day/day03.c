@@ -0,0 +1,761 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>   // int64_t
+#include <unistd.h>     // ssize_t
+#include <errno.h>      // errno
+#include <ctype.h>      // isdigit
+#include <stdbool.h>    // bool
+#include <regex.h>      // regex
+
+#include "input.h"
+#include "input_stream.h"
+#include "export_writer.h"
+#include "mem_stats.h"
+#include "profiler.h"
+#include "solver.h"
+#include "swar.h"
+#include "day03.h"
+#include "schematic.h"
+#include "packed_grid.h"
+#include "tiled_scan.h"
+#include "row_memo.h"
+#include "width_kernels.h"
+#include "gears.h"
+#include "schematic_binary.h"
+
+// Debugging
+// ################################################
+
+#define DEBUG (0)
+#define DEBUG_LEVEL (0) // Everything below this level will be printed (incl. this level)
+#ifdef DEBUG
+    #define DEBUG_START(level) if (DEBUG_LEVEL >= (level)) {
+    #define DEBUG_END }
+#else
+    #define DEBUG_START(level) if(0) {
+    #define DEBUG_END }
+#endif
+
+// Definitions
+// ################################################
+
+#define SOLVER_VERSION (5)
+
+// Modes that take a parameter after a ':'
+#define TILED_MODE_PREFIX "tiled"
+#define MEMO_MODE_PREFIX "memo"
+
+// Per-number export (-e), binary records follow an export_binary_header_t
+#define EXPORT_MAGIC "AOC03PN"
+#define EXPORT_VERSION (1)
+#define EXPORT_CSV_HEADER "value,x,y,length,valid"
+
+typedef struct {
+    int32_t value;
+    uint32_t x;
+    uint32_t y;
+    uint8_t length;
+    uint8_t valid;
+    uint8_t reserved[2];
+} number_record_t;
+
+// Function Prototypes
+// ################################################
+
+// AoC Functions
+static bool decrypt_riddle_value(void* state,
+                                 const solver_options_t* options,
+                                 const char* input,
+                                 size_t input_size,
+                                 solver_result_t* result);
+static bool decrypt_riddle_value_lines(void* state,
+                                       const solver_options_t* options,
+                                       line_reader_t* reader,
+                                       solver_result_t* result);
+static bool is_digit(const char *c);
+static bool is_symbol(const char *c);
+static bool has_adjacent_symbol(const number_t* number, 
+                                const char** matrix, 
+                                const uint32_t matrix_number_of_rows, 
+                                const uint32_t matrix_number_of_cols);
+static bool position_is_in_bounds(const position_t* pos, 
+                                  const uint32_t max_x_pos, 
+                                  const uint32_t max_y_pos);
+static bool try_parsing_tiled_mode(const solver_options_t* options, bool* use_tiles, uint32_t* tile_width);
+static bool try_parsing_memo_mode(const solver_options_t* options, bool* use_memo, uint32_t* memo_entries);
+static bool try_opening_number_export(const char* file_name, export_writer_t** writer);
+static bool try_exporting_number(export_writer_t* writer, bool binary, const number_t* number, bool is_valid);
+
+const solver_t DAY03_SOLVER = {
+    .name = "03",
+    .directory = "03_Day",
+    .default_input = "input_big.txt",
+    .version = SOLVER_VERSION,
+    .init = NULL,
+    .solve = decrypt_riddle_value,
+    .solve_lines = decrypt_riddle_value_lines,
+    .destroy = NULL
+};
+
+// AoC Functions
+// ################################################
+
+static bool is_digit(const char* c) {
+    
+    if(c == NULL) {
+        return false;
+    }
+
+    if(*c == '\0') {
+        return false;
+    }
+
+    if((*c >= '0') && (*c <= '9')) {
+        return true;
+    }
+
+    return false;
+}
+
+static bool is_symbol(const char* c) {
+    
+    if(c == NULL) {
+        return false;
+    }
+
+    if(*c == '\0') {
+        return false;
+    }
+
+    // '.': empty cell
+    if(!is_digit(c) && (*c != '.') && (*c != '\n') && (*c != ' ')) {
+        return true;
+    }
+
+    return false;
+}
+
+static bool position_is_in_bounds(const position_t* pos, 
+                                  const uint32_t max_x_pos, 
+                                  const uint32_t max_y_pos) {
+
+    if(pos == NULL) {
+        return false;
+    }
+
+    if((pos->x < 0) || ((int64_t)pos->x > (int64_t)max_x_pos-1)) {
+        return false;
+    }
+
+    if((pos->y < 0) || ((int64_t)pos->y > (int64_t)max_y_pos-1)) {
+        return false;
+    }
+
+    return true;
+}
+
+static bool has_adjacent_symbol(const number_t* number, 
+                                const char** matrix, 
+                                const uint32_t matrix_number_of_rows, 
+                                const uint32_t matrix_number_of_cols) {
+
+    position_t pos_to_check = {0, 0};
+
+    // Check above (including diagonals)
+    pos_to_check.y = number->pos.y-1;
+    if(pos_to_check.y >= 0) {
+        for(int32_t i=-1; i<=number->length; ++i) {
+            pos_to_check.x = number->pos.x+i;
+            if(position_is_in_bounds(&pos_to_check, matrix_number_of_cols, matrix_number_of_rows)) {
+                if(is_symbol(&matrix[pos_to_check.y][pos_to_check.x])) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    // Check below (including diagonals)
+    pos_to_check.y = number->pos.y+1;
+    if(pos_to_check.y < (int64_t)matrix_number_of_rows) {
+        for(int32_t i=-1; i<=number->length; ++i) {
+            pos_to_check.x = number->pos.x+i;
+            if(position_is_in_bounds(&pos_to_check, matrix_number_of_cols, matrix_number_of_rows)) {
+                if(is_symbol(&matrix[pos_to_check.y][pos_to_check.x])) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    // Check left
+    pos_to_check.x = number->pos.x-1;
+    pos_to_check.y = number->pos.y;
+    if(position_is_in_bounds(&pos_to_check, matrix_number_of_cols, matrix_number_of_rows)) {
+        if(is_symbol(&matrix[pos_to_check.y][pos_to_check.x])) {
+            return true;
+        }
+    }
+
+    // Check right
+    pos_to_check.x = number->pos.x+number->length;
+    pos_to_check.y = number->pos.y;
+    if(position_is_in_bounds(&pos_to_check, matrix_number_of_cols, matrix_number_of_rows)) {
+        if(is_symbol(&matrix[pos_to_check.y][pos_to_check.x])) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// "tiled" or "tiled:<columns>" selects the column-tiled scan
+static bool try_parsing_tiled_mode(const solver_options_t* options, bool* use_tiles, uint32_t* tile_width) {
+
+    *use_tiles = false;
+    *tile_width = TILED_DEFAULT_TILE_WIDTH;
+    size_t prefix_len = strlen(TILED_MODE_PREFIX);
+    if(options->mode == NULL || strncmp(options->mode, TILED_MODE_PREFIX, prefix_len) != 0) {
+        return true;
+    }
+
+    const char* width_string = options->mode + prefix_len;
+    if(*width_string == '\0') {
+        *use_tiles = true;
+        return true;
+    }
+    if(*width_string != ':') {
+        return true;
+    }
+    width_string++;
+
+    uint64_t parsed_width;
+    size_t consumed;
+    size_t width_string_len = strlen(width_string);
+    if(!swar_try_parsing_uint(width_string, width_string_len, UINT32_MAX, &parsed_width, &consumed)
+    || consumed == 0 || consumed != width_string_len || parsed_width == 0) {
+        fprintf(stderr, "Error: Invalid tile width \"%s\" (1 - %u columns)\n", width_string, UINT32_MAX);
+        return false;
+    }
+    *use_tiles = true;
+    *tile_width = (uint32_t)parsed_width;
+    return true;
+}
+
+// "memo" or "memo:<entries>" selects the row triple memo
+static bool try_parsing_memo_mode(const solver_options_t* options, bool* use_memo, uint32_t* memo_entries) {
+
+    *use_memo = false;
+    *memo_entries = ROW_MEMO_DEFAULT_ENTRIES;
+    size_t prefix_len = strlen(MEMO_MODE_PREFIX);
+    if(options->mode == NULL || strncmp(options->mode, MEMO_MODE_PREFIX, prefix_len) != 0) {
+        return true;
+    }
+
+    const char* entries_string = options->mode + prefix_len;
+    if(*entries_string == '\0') {
+        *use_memo = true;
+        return true;
+    }
+    if(*entries_string != ':') {
+        return true;
+    }
+    entries_string++;
+
+    uint64_t parsed_entries;
+    size_t consumed;
+    size_t entries_string_len = strlen(entries_string);
+    if(!swar_try_parsing_uint(entries_string, entries_string_len, ROW_MEMO_MAX_ENTRIES, &parsed_entries, &consumed)
+    || consumed == 0 || consumed != entries_string_len || parsed_entries == 0) {
+        fprintf(stderr, "Error: Invalid memo size \"%s\" (1 - %u entries)\n", entries_string, ROW_MEMO_MAX_ENTRIES);
+        return false;
+    }
+    *use_memo = true;
+    *memo_entries = (uint32_t)parsed_entries;
+    return true;
+}
+
+static bool try_opening_number_export(const char* file_name, export_writer_t** writer) {
+
+    export_binary_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, EXPORT_MAGIC, strlen(EXPORT_MAGIC));
+    header.version = EXPORT_VERSION;
+    header.record_size = sizeof(number_record_t);
+    return try_opening_export_writer(file_name, EXPORT_CSV_HEADER, &header, writer);
+}
+
+static bool try_exporting_number(export_writer_t* writer, bool binary, const number_t* number, bool is_valid) {
+
+    char* out = export_reserve(writer, binary ? sizeof(number_record_t) : EXPORT_MAX_RECORD_LEN);
+    if(out == NULL) {
+        return false;
+    }
+    if(binary) {
+        number_record_t record = {
+            .value = number->value,
+            .x = (uint32_t)number->pos.x,
+            .y = (uint32_t)number->pos.y,
+            .length = number->length,
+            .valid = is_valid ? 1 : 0,
+            .reserved = {0, 0}
+        };
+        memcpy(out, &record, sizeof(record));
+        export_commit(writer, out + sizeof(record));
+        return true;
+    }
+    out = export_format_i64(out, number->value);
+    *out++ = ',';
+    out = export_format_i64(out, number->pos.x);
+    *out++ = ',';
+    out = export_format_i64(out, number->pos.y);
+    *out++ = ',';
+    out = export_format_u64(out, number->length);
+    *out++ = ',';
+    *out++ = is_valid ? '1' : '0';
+    *out++ = '\n';
+    export_commit(writer, out);
+    return true;
+}
+
+static bool decrypt_riddle_value(void* state,
+                                 const solver_options_t* options,
+                                 const char* input,
+                                 size_t input_size,
+                                 solver_result_t* result) {
+
+    // Precompiled schematics are answered straight from the mapped buffer
+    if(is_binary_schematic(input, input_size)) {
+        if(options->export_file_name != NULL) {
+            fprintf(stderr, "Error: Export is not available for binary schematics\n");
+            return false;
+        }
+        return try_solving_binary_schematic(input, input_size, result);
+    }
+
+    line_reader_t reader;
+    init_buffer_line_reader(&reader, input, input_size);
+    return decrypt_riddle_value_lines(state, options, &reader, result);
+}
+
+static bool decrypt_riddle_value_lines(void* state,
+                                       const solver_options_t* options,
+                                       line_reader_t* reader,
+                                       solver_result_t* result) {
+
+    // Cleanup struct with bitfield
+    struct cleanup {
+        bool matrix_allocated: 1;
+        bool packed_grid_allocated: 1;
+        bool padded_grid_allocated: 1;
+        bool validity_allocated: 1;
+        bool numbers_allocated: 1;
+        bool valid_numbers_allocated: 1;
+        bool invalid_numbers_allocated: 1;
+        bool gears_allocated: 1;
+        bool export_opened: 1;
+        bool successful: 1;
+    } cleanup = {
+        .matrix_allocated = false,
+        .packed_grid_allocated = false,
+        .padded_grid_allocated = false,
+        .validity_allocated = false,
+        .numbers_allocated = false,
+        .valid_numbers_allocated = false,
+        .invalid_numbers_allocated = false,
+        .gears_allocated = false,
+        .export_opened = false,
+        .successful = false
+    };
+
+    // Declared up front, so every goto below reaches the cleanup with initialized pointers
+    uint64_t number_sum = 0;
+    number_t* valid_numbers = NULL;
+    number_t* invalid_numbers = NULL;
+
+    // "packed" keeps only 2 bits per cell instead of the character matrix,
+    // "tiled" keeps the character matrix but checks numbers tile by tile,
+    // "generic" never switches to a width-specialised kernel (see width_kernels.h),
+    // "memo" keeps the character matrix and reuses the sums of repeated row triples
+    bool use_packed_grid = solver_mode_is(options, "packed");
+    bool use_generic_check = solver_mode_is(options, "generic");
+    bool use_tiles;
+    uint32_t tile_width;
+    if(!try_parsing_tiled_mode(options, &use_tiles, &tile_width)) {
+        return false;
+    }
+    bool use_memo;
+    uint32_t memo_entries;
+    if(!try_parsing_memo_mode(options, &use_memo, &memo_entries)) {
+        return false;
+    }
+    if(!use_packed_grid && !use_tiles && !use_memo && !use_generic_check && !solver_mode_is(options, "default")) {
+        fprintf(stderr, "Error: Unknown mode \"%s\" (default, generic, packed, tiled[:columns], memo[:entries])\n",
+                options->mode);
+        return false;
+    }
+    row_memo_stats_t memo_stats;
+    memset(&memo_stats, 0, sizeof(memo_stats));
+
+    // Per-number results are formatted here and written on the export thread
+    export_writer_t* exporter = NULL;
+    bool export_binary = false;
+    if(options->export_file_name != NULL) {
+        if(!try_opening_number_export(options->export_file_name, &exporter)) {
+            return false;
+        }
+        export_binary = export_format_for(options->export_file_name) == EXPORT_FORMAT_BINARY;
+        cleanup.export_opened = true;
+    }
+
+    // Read input line by line and create 2D array of its values
+    number_t* numbers = NULL;
+    size_t numbers_cnt = 0;
+    cleanup.numbers_allocated = true;
+
+    char** matrix = NULL;
+    uint32_t matrix_number_of_rows = 0;
+    uint32_t matrix_number_of_cols = 0;
+    cleanup.matrix_allocated = true;
+
+    packed_grid_t packed_grid;
+
+    // Set after the first line if the default mode has a kernel for its width
+    width_kernel_t width_kernel = NULL;
+    padded_grid_t padded_grid;
+    bool* number_validity = NULL;
+
+    // Positions of every '*' for part 2
+    uint32_t* gear_x = NULL;
+    uint32_t* gear_y = NULL;
+    size_t gears_cnt = 0;
+    size_t gears_capacity = 0;
+    cleanup.gears_allocated = true;
+
+    const char* line = NULL;
+    size_t read_bytes = 0;
+
+    // Stage tags for AOC_PROFILE, restored in the cleanup
+    const char* previous_stage = profiler_enter_stage("03 parse");
+    while(read_line(reader, &line, &read_bytes)) {
+
+        // Test if the input text is well formed
+        if(matrix_number_of_cols != 0) {
+            if(read_bytes/sizeof(char) != matrix_number_of_cols) {
+                fprintf(stderr, "Error: Line %u has different length than previous lines\n", matrix_number_of_rows);
+                goto cleanup;
+            }
+        } else {
+            if(read_bytes > UINT32_MAX) {
+                fprintf(stderr, "Error: Line %u is too long\n", matrix_number_of_rows);
+                goto cleanup;
+            }
+            matrix_number_of_cols = (uint32_t)(read_bytes/sizeof(char));
+            if(use_packed_grid) {
+                init_packed_grid(&packed_grid, matrix_number_of_cols);
+                cleanup.packed_grid_allocated = true;
+            } else if(!use_tiles && !use_memo && !use_generic_check) {
+                width_kernel = find_width_kernel(matrix_number_of_cols);
+                if(width_kernel != NULL) {
+                    if(!try_initializing_padded_grid(&padded_grid, matrix_number_of_cols)) {
+                        goto cleanup;
+                    }
+                    cleanup.padded_grid_allocated = true;
+                }
+            }
+        }
+
+        if(use_packed_grid) {
+            if(!try_appending_packed_row(&packed_grid, line)) {
+                goto cleanup;
+            }
+            matrix_number_of_rows++;
+        } else if(width_kernel != NULL) {
+            if(!try_appending_padded_row(&padded_grid, line)) {
+                goto cleanup;
+            }
+            matrix_number_of_rows++;
+        } else {
+            // Copy line into matrix
+            matrix = (char**)realloc(matrix, (matrix_number_of_rows+1) * sizeof(char*));
+            if(matrix == NULL) {
+                fprintf(stderr, "Error allocating memory for matrix row %u\n", matrix_number_of_rows);
+                goto cleanup;
+            }
+            matrix[matrix_number_of_rows] = (char*)malloc(read_bytes * sizeof(char));
+            if(matrix[matrix_number_of_rows] == NULL) {
+                fprintf(stderr, "Error allocating memory for matrix row %u\n", matrix_number_of_rows);
+                goto cleanup;
+            }
+            memcpy(matrix[matrix_number_of_rows], line, read_bytes);
+            matrix_number_of_rows++;
+        }
+
+        // Put number into list, each digit run is parsed in one go
+        for(uint32_t i=0; i<read_bytes; ++i) {
+            if(!is_digit(&line[i])) {
+                continue;
+            }
+            uint64_t value;
+            size_t length;
+            if(!swar_try_parsing_uint(&line[i], read_bytes - i, INT32_MAX, &value, &length)) {
+                fprintf(stderr, "Error: Number at row %u col %u does not fit into 32 bits\n",
+                        matrix_number_of_rows-1, i);
+                goto cleanup;
+            }
+            if(length > UINT8_MAX) {
+                fprintf(stderr, "Error: Number at row %u col %u is too long\n", matrix_number_of_rows-1, i);
+                goto cleanup;
+            }
+            numbers = realloc(numbers, (numbers_cnt+1) * sizeof(number_t));
+            if(numbers == NULL) {
+                fprintf(stderr, "Error allocating memory for number %zu\n", numbers_cnt);
+                goto cleanup;
+            }
+            numbers[numbers_cnt].length = (uint8_t)length;
+            numbers[numbers_cnt].pos.x = (int32_t)i;
+            numbers[numbers_cnt].pos.y = (int32_t)matrix_number_of_rows-1; // -1 because we already incremented the row counter
+            numbers[numbers_cnt].value = (int32_t)value;
+            numbers_cnt++;
+
+            // Skip the rest of the digit run
+            i += (uint32_t)length - 1;
+        }
+
+        // Remember gear candidates
+        const char* gear = memchr(line, '*', read_bytes);
+        while(gear != NULL) {
+            if(gears_cnt == gears_capacity) {
+                gears_capacity = (gears_capacity > 0) ? gears_capacity * 2 : 64;
+                uint32_t* grown_gear_x = realloc(gear_x, gears_capacity * sizeof(uint32_t));
+                if(grown_gear_x == NULL) {
+                    fprintf(stderr, "Error allocating memory for gears\n");
+                    goto cleanup;
+                }
+                gear_x = grown_gear_x;
+                uint32_t* grown_gear_y = realloc(gear_y, gears_capacity * sizeof(uint32_t));
+                if(grown_gear_y == NULL) {
+                    fprintf(stderr, "Error allocating memory for gears\n");
+                    goto cleanup;
+                }
+                gear_y = grown_gear_y;
+            }
+            gear_x[gears_cnt] = (uint32_t)(gear - line);
+            gear_y[gears_cnt] = matrix_number_of_rows-1;
+            gears_cnt++;
+            gear = memchr(gear + 1, '*', read_bytes - (size_t)(gear + 1 - line));
+        }
+    }
+
+    DEBUG_START(1)
+    fprintf(stdout, "Parsed numbers: %zu\n", numbers_cnt);
+    fprintf(stdout, "Matrix number of rows: %u\n", matrix_number_of_rows);
+    fprintf(stdout, "Matrix number of cols: %u\n", matrix_number_of_cols);
+    if(use_packed_grid) {
+        fprintf(stdout, "Packed grid bytes: %zu\n", packed_grid_bytes(&packed_grid));
+    }
+    if(width_kernel != NULL) {
+        fprintf(stdout, "Width kernel: %u columns\n", matrix_number_of_cols);
+    }
+    fprintf(stdout, "\n");
+    DEBUG_END
+
+    DEBUG_START(2)
+    // Print numbers list
+    for(size_t i=0; i<numbers_cnt; i++) {
+        fprintf(stdout, "%4ld. x: %3d, y: %3d, value: %3d, length: %d\n", 
+            i+1, numbers[i].pos.x, numbers[i].pos.y, numbers[i].value, numbers[i].length);
+    }
+    fprintf(stdout, "\n");
+
+    // Print matrix
+    fprintf(stdout, "Matrix:\n");
+    for(size_t i=0; i<matrix_number_of_rows && !use_packed_grid; i++) {
+        const char* row = (width_kernel != NULL) ? padded_cell(&padded_grid, 0, (uint32_t)i) : matrix[i];
+        fprintf(stdout, "%.*s", (int)matrix_number_of_cols, row);
+    }
+    fprintf(stdout, "\n");
+    fprintf(stdout, "\n");
+    DEBUG_END
+
+    // Find numbers with adjacent symbols (normal or diagonal)
+    profiler_enter_stage("03 adjacency");
+    uint64_t valid_numbers_cnt = 0;
+    uint64_t invalid_numbers_cnt = 0;
+    cleanup.valid_numbers_allocated = true;
+    cleanup.invalid_numbers_allocated = true;
+    if(use_tiles || use_memo) {
+        if(use_tiles && !try_summing_part_numbers_tiled(numbers, numbers_cnt, (const char**)matrix,
+                                                        matrix_number_of_rows, matrix_number_of_cols,
+                                                        tile_width, &number_sum)) {
+            goto cleanup;
+        }
+        if(use_memo && !try_summing_part_numbers_memoized(numbers, numbers_cnt, (const char**)matrix,
+                                                          matrix_number_of_rows, matrix_number_of_cols,
+                                                          memo_entries, &number_sum, &memo_stats)) {
+            goto cleanup;
+        }
+        // The tiled scan and the memo only sum, the export classifies every number on its own
+        for(size_t i=0; i<numbers_cnt && exporter != NULL; i++) {
+            bool is_valid = has_adjacent_symbol(&numbers[i], (const char**)matrix,
+                                                matrix_number_of_rows, matrix_number_of_cols);
+            if(!try_exporting_number(exporter, export_binary, &numbers[i], is_valid)) {
+                goto cleanup;
+            }
+        }
+    }
+    // The width kernel classifies all numbers in one go
+    if(width_kernel != NULL) {
+        number_validity = malloc((numbers_cnt > 0 ? numbers_cnt : 1) * sizeof(bool));
+        if(number_validity == NULL) {
+            fprintf(stderr, "Error allocating memory for number validity\n");
+            goto cleanup;
+        }
+        cleanup.validity_allocated = true;
+        width_kernel(&padded_grid, numbers, numbers_cnt, number_validity);
+    }
+    for(size_t i=0; i<numbers_cnt && !use_tiles && !use_memo; i++) {
+        bool is_valid;
+        if(width_kernel != NULL) {
+            is_valid = number_validity[i];
+        } else if(use_packed_grid) {
+            is_valid = packed_has_adjacent_symbol(&packed_grid, &numbers[i]);
+        } else {
+            is_valid = has_adjacent_symbol(&numbers[i], (const char**)matrix, matrix_number_of_rows, matrix_number_of_cols);
+        }
+        if(exporter != NULL && !try_exporting_number(exporter, export_binary, &numbers[i], is_valid)) {
+            goto cleanup;
+        }
+        if(is_valid) {
+            // fprintf(stdout, "v::%4d | x:%4d | y:%6d\n", numbers[i].value, numbers[i].pos.x, numbers[i].pos.y);
+            DEBUG_START(1)
+            valid_numbers = realloc(valid_numbers, (valid_numbers_cnt+1) * sizeof(number_t));
+            valid_numbers[valid_numbers_cnt] = numbers[i];
+            valid_numbers_cnt++;
+            DEBUG_END
+            number_sum += (uint64_t)numbers[i].value;
+        } else {
+            DEBUG_START(1)
+            invalid_numbers = realloc(invalid_numbers, (invalid_numbers_cnt+1) * sizeof(number_t));
+            invalid_numbers[invalid_numbers_cnt] = numbers[i];
+            invalid_numbers_cnt++;
+            DEBUG_END
+        }
+    }
+
+    DEBUG_START(1)
+    fprintf(stdout, "Valid numbers: %ld\n", valid_numbers_cnt);
+    fprintf(stdout, "Invalid numbers: %ld\n", invalid_numbers_cnt);
+    fprintf(stdout, "Number sum: %ld\n", number_sum);
+    fprintf(stdout, "\n");
+    if(use_memo) {
+        double hit_rate = memo_stats.lookups > 0 ? 100.0 * (double)memo_stats.hits / (double)memo_stats.lookups : 0.0;
+        fprintf(stdout, "Row memo: %" PRIu64 " lookups, %" PRIu64 " hits (%.1f%%), %" PRIu64 " evictions, "
+                "%" PRIu64 " collisions, %u entries\n", memo_stats.lookups, memo_stats.hits, hit_rate,
+                memo_stats.evictions, memo_stats.collisions, memo_entries);
+        fprintf(stdout, "\n");
+    }
+    DEBUG_END
+
+    DEBUG_START(2)
+    // Print valid numbers list
+    fprintf(stdout, "Valid numbers:\n");
+    for(size_t i=0; i<valid_numbers_cnt; i++) {
+        fprintf(stdout, "%4ld. x: %3d, y: %3d, value: %3d, length: %d\n", 
+            i+1, valid_numbers[i].pos.x, valid_numbers[i].pos.y, valid_numbers[i].value, valid_numbers[i].length);
+    }
+    fprintf(stdout, "\n");
+
+    // Print invalid numbers list
+    fprintf(stdout, "Invalid numbers:\n");
+    for(size_t i=0; i<invalid_numbers_cnt; i++) {
+        fprintf(stdout, "%4ld. x: %3d, y: %3d, value: %3d, length: %d\n", 
+            i+1, invalid_numbers[i].pos.x, invalid_numbers[i].pos.y, invalid_numbers[i].value, invalid_numbers[i].length);
+    }
+    fprintf(stdout, "\n");
+    DEBUG_END
+
+    // Part 2: gear ratios, independent of the grid representation
+    profiler_enter_stage("03 gears");
+    number_table_t number_table;
+    if(!try_building_number_table(numbers, numbers_cnt, matrix_number_of_rows, &number_table)) {
+        goto cleanup;
+    }
+    uint64_t gear_ratio_sum = sum_gear_ratios(&number_table, gear_x, gear_y, gears_cnt);
+    destroy_number_table(&number_table);
+
+    // Footprint of the parsed input, reported in the end banner
+    if(use_packed_grid) {
+        mem_stats_record("packed grid", packed_grid_bytes(&packed_grid));
+    } else if(width_kernel != NULL) {
+        mem_stats_record("padded grid", padded_grid_bytes(&padded_grid));
+    } else {
+        mem_stats_record("matrix rows", (size_t)matrix_number_of_rows * (matrix_number_of_cols + sizeof(char*)));
+    }
+    if(use_memo) {
+        mem_stats_record("row memo", memo_stats.bytes);
+    }
+    mem_stats_record("numbers", numbers_cnt * sizeof(number_t));
+    mem_stats_record("number table", ((size_t)matrix_number_of_rows + 1) * sizeof(uint64_t)
+                                     + numbers_cnt * (sizeof(uint32_t) + sizeof(uint8_t) + sizeof(int32_t)));
+    mem_stats_record("gears", gears_capacity * 2 * sizeof(uint32_t));
+
+    DEBUG_START(1)
+    fprintf(stdout, "Gears: %zu\n", gears_cnt);
+    fprintf(stdout, "Gear ratio sum: %" PRIu64 "\n", gear_ratio_sum);
+    fprintf(stdout, "\n");
+    DEBUG_END
+
+    result->part_one = (int64_t)number_sum;
+    result->part_two = (int64_t)gear_ratio_sum;
+    result->has_part_two = true;
+    cleanup.successful = true;
+
+    cleanup:
+    if(cleanup.matrix_allocated) {
+        if(matrix != NULL) {
+            for(uint32_t i = 0; i < matrix_number_of_rows; i++) {
+                if(matrix[i] != NULL) {
+                    free(matrix[i]);
+                }
+            }
+            free(matrix);
+        }
+    }
+    if(cleanup.packed_grid_allocated) {
+        destroy_packed_grid(&packed_grid);
+    }
+    if(cleanup.padded_grid_allocated) {
+        destroy_padded_grid(&padded_grid);
+    }
+    if(cleanup.validity_allocated) {
+        free(number_validity);
+    }
+    if(cleanup.numbers_allocated) {
+        if(numbers != NULL) {
+            free(numbers);
+        }
+    }
+    if(cleanup.valid_numbers_allocated) {
+        if(valid_numbers != NULL) {
+            free(valid_numbers);
+        }
+    }
+    if(cleanup.invalid_numbers_allocated) {
+        if(invalid_numbers != NULL) {
+            free(invalid_numbers);
+        }
+    }
+    if(cleanup.gears_allocated) {
+        free(gear_x);
+        free(gear_y);
+    }
+    if(cleanup.export_opened) {
+        if(!try_closing_export_writer(exporter)) {
+            cleanup.successful = false;
+        }
+    }
+    profiler_exit_stage(previous_stage);
+
+    return cleanup.successful;
+}
@@ -0,0 +1,8 @@
+#ifndef DAY03_SOLVER_H
+#define DAY03_SOLVER_H
+
+#include "solver.h"
+
+extern const solver_t DAY03_SOLVER;
+
+#endif
@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gears.h"
+
+// Definitions
+// ################################################
+
+#define GEAR_NUMBER_CNT (2)
+
+// Number Table
+// ################################################
+
+uint64_t find_first_number_ending_at_or_after(const number_table_t* table, uint32_t y, int64_t x_first) {
+    // Numbers of a row do not overlap, so their end columns are sorted as well
+    uint64_t low = table->row_first[y];
+    uint64_t high = table->row_first[y+1];
+    while(low < high) {
+        uint64_t mid = low + (high - low) / 2;
+        int64_t last_digit_x = (int64_t)table->x[mid] + table->length[mid] - 1;
+        if(last_digit_x < x_first) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+bool try_building_number_table(const number_t* numbers,
+                               size_t numbers_cnt,
+                               uint32_t number_of_rows,
+                               number_table_t* table) {
+
+    uint64_t* row_first = malloc(((size_t)number_of_rows + 1) * sizeof(uint64_t));
+    uint32_t* x = malloc((numbers_cnt > 0 ? numbers_cnt : 1) * sizeof(uint32_t));
+    uint8_t* length = malloc((numbers_cnt > 0 ? numbers_cnt : 1) * sizeof(uint8_t));
+    int32_t* value = malloc((numbers_cnt > 0 ? numbers_cnt : 1) * sizeof(int32_t));
+    if(row_first == NULL || x == NULL || length == NULL || value == NULL) {
+        fprintf(stderr, "Error allocating memory for number table\n");
+        free(row_first);
+        free(x);
+        free(length);
+        free(value);
+        return false;
+    }
+
+    size_t n = 0;
+    for(uint32_t y=0; y<number_of_rows; ++y) {
+        row_first[y] = n;
+        while(n < numbers_cnt && (uint32_t)numbers[n].pos.y == y) {
+            x[n] = (uint32_t)numbers[n].pos.x;
+            length[n] = numbers[n].length;
+            value[n] = numbers[n].value;
+            n++;
+        }
+    }
+    row_first[number_of_rows] = n;
+
+    table->number_of_rows = number_of_rows;
+    table->numbers_cnt = n;
+    table->row_first = row_first;
+    table->x = x;
+    table->length = length;
+    table->value = value;
+    return true;
+}
+
+void destroy_number_table(number_table_t* table) {
+    free((void*)table->row_first);
+    free((void*)table->x);
+    free((void*)table->length);
+    free((void*)table->value);
+    table->row_first = NULL;
+    table->x = NULL;
+    table->length = NULL;
+    table->value = NULL;
+}
+
+// Gears
+// ################################################
+
+uint64_t sum_gear_ratios(const number_table_t* table,
+                         const uint32_t* gear_x,
+                         const uint32_t* gear_y,
+                         size_t gears_cnt) {
+
+    uint64_t ratio_sum = 0;
+    for(size_t g=0; g<gears_cnt; ++g) {
+        int64_t x_first = (int64_t)gear_x[g] - 1;
+        int64_t x_last = (int64_t)gear_x[g] + 1;
+        uint32_t y_first = (gear_y[g] > 0) ? gear_y[g] - 1 : 0;
+        uint32_t y_last = (gear_y[g] + 1 < table->number_of_rows) ? gear_y[g] + 1 : table->number_of_rows - 1;
+
+        // Collect the adjacent numbers, more than two disqualify the gear
+        uint64_t adjacent_values[GEAR_NUMBER_CNT];
+        size_t adjacent_cnt = 0;
+        for(uint32_t y=y_first; y<=y_last && adjacent_cnt<=GEAR_NUMBER_CNT; ++y) {
+            uint64_t end = table->row_first[y+1];
+            for(uint64_t i=find_first_number_ending_at_or_after(table, y, x_first);
+                i<end && (int64_t)table->x[i] <= x_last; ++i) {
+                if(adjacent_cnt < GEAR_NUMBER_CNT) {
+                    adjacent_values[adjacent_cnt] = (uint64_t)table->value[i];
+                }
+                adjacent_cnt++;
+                if(adjacent_cnt > GEAR_NUMBER_CNT) {
+                    break;
+                }
+            }
+        }
+        if(adjacent_cnt == GEAR_NUMBER_CNT) {
+            ratio_sum += adjacent_values[0] * adjacent_values[1];
+        }
+    }
+    return ratio_sum;
+}
@@ -0,0 +1,45 @@
+#ifndef DAY03_GEARS_H
+#define DAY03_GEARS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "schematic.h"
+
+// Number Table
+// ################################################
+//
+// Numbers in structure-of-arrays layout, grouped by row and sorted by x inside
+// a row. The text parser builds it from its number_t list, the binary
+// schematic format maps it directly from the file.
+
+typedef struct {
+    uint32_t number_of_rows;
+    uint64_t numbers_cnt;
+    const uint64_t* row_first;  // number_of_rows+1 entries, row y owns [row_first[y], row_first[y+1])
+    const uint32_t* x;
+    const uint8_t* length;
+    const int32_t* value;
+} number_table_t;
+
+// numbers must be in row-major order, as produced by the parser
+bool try_building_number_table(const number_t* numbers,
+                               size_t numbers_cnt,
+                               uint32_t number_of_rows,
+                               number_table_t* table);
+// Only for tables created by try_building_number_table
+void destroy_number_table(number_table_t* table);
+// First number of row y whose last digit is at or right of x_first (row_first[y+1] if none)
+uint64_t find_first_number_ending_at_or_after(const number_table_t* table, uint32_t y, int64_t x_first);
+
+// Gears
+// ################################################
+
+// Part 2: every '*' adjacent to exactly two numbers adds the product of both
+uint64_t sum_gear_ratios(const number_table_t* table,
+                         const uint32_t* gear_x,
+                         const uint32_t* gear_y,
+                         size_t gears_cnt);
+
+#endif
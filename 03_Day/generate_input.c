@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>   // uint64_t
+#include <stdbool.h>    // bool
+
+#include "swar.h"
+
+// Input Generator
+// ################################################
+//
+// Writes a random schematic with the given number of columns and rows to
+// stdout, e.g. to validate the tiled scan on 1K to 1M column wide inputs:
+//   ./generate_input 1000000 64 > input_1m.txt
+// Numbers have 1-3 digits, roughly every 16th cell is a symbol.
+
+#define DEFAULT_SEED (42)
+
+static const char SYMBOLS[] = "*#+$/@=%&-";
+
+static uint64_t next_random(uint64_t* state) {
+    // xorshift64*
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+static bool try_parsing_argument(const char* argument, uint64_t max_value, uint64_t* value) {
+    size_t consumed;
+    size_t argument_len = strlen(argument);
+    if(!swar_try_parsing_uint(argument, argument_len, max_value, value, &consumed)
+    || consumed == 0 || consumed != argument_len) {
+        fprintf(stderr, "Error: Invalid argument \"%s\"\n", argument);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+
+    if(argc < 3 || argc > 4) {
+        fprintf(stderr, "Usage: %s columns rows [seed]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    uint64_t number_of_cols, number_of_rows, seed = DEFAULT_SEED;
+    if(!try_parsing_argument(argv[1], UINT32_MAX - 1, &number_of_cols)
+    || !try_parsing_argument(argv[2], UINT32_MAX, &number_of_rows)
+    || (argc == 4 && !try_parsing_argument(argv[3], UINT64_MAX, &seed))) {
+        return EXIT_FAILURE;
+    }
+    if(number_of_cols == 0) {
+        fprintf(stderr, "Error: At least one column is needed\n");
+        return EXIT_FAILURE;
+    }
+
+    char* row = malloc(number_of_cols + 1);
+    if(row == NULL) {
+        perror("Error allocating memory for row");
+        return EXIT_FAILURE;
+    }
+
+    uint64_t state = seed ? seed : DEFAULT_SEED;
+    for(uint64_t y=0; y<number_of_rows; ++y) {
+        uint64_t x = 0;
+        while(x < number_of_cols) {
+            uint64_t r = next_random(&state);
+            if((r & 0xF) == 0) {
+                row[x++] = SYMBOLS[(r >> 8) % (sizeof(SYMBOLS) - 1)];
+            } else if((r & 0xF) < 3) {
+                // Digit run followed by a '.', so runs never merge
+                uint64_t digits = 1 + (r >> 8) % 3;
+                for(uint64_t d=0; d<digits && x<number_of_cols; ++d) {
+                    row[x++] = (char)('0' + (r >> (16 + 4*d)) % 10);
+                }
+                if(x < number_of_cols) {
+                    row[x++] = '.';
+                }
+            } else {
+                row[x++] = '.';
+            }
+        }
+        row[number_of_cols] = '\n';
+        if(fwrite(row, 1, number_of_cols + 1, stdout) != number_of_cols + 1) {
+            perror("Error writing row");
+            free(row);
+            return EXIT_FAILURE;
+        }
+    }
+
+    free(row);
+    return EXIT_SUCCESS;
+}
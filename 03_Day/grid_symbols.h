@@ -0,0 +1,56 @@
+#ifndef DAY03_GRID_SYMBOLS_H
+#define DAY03_GRID_SYMBOLS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "schematic.h"
+
+// Grid Symbols
+// ################################################
+//
+// Cell classification of the character grid (the same as is_symbol in
+// day03.c) and the neighbourhood check of a number on the row matrix, for
+// the scans and converters outside day03.c that work on the text rows.
+
+static inline bool is_symbol_char(char c) {
+    if(c >= '0' && c <= '9') {
+        return false;
+    }
+    return c != '\0' && c != '.' && c != '\n' && c != ' ';
+}
+
+// True if any cell in [x_first, x_last] of row is a symbol (already clamped)
+static inline bool row_range_has_symbol(const char* row, uint32_t x_first, uint32_t x_last) {
+    for(uint32_t x=x_first; x<=x_last; ++x) {
+        if(is_symbol_char(row[x])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static inline bool matrix_has_adjacent_symbol(const number_t* number,
+                                              const char** matrix,
+                                              uint32_t matrix_number_of_rows,
+                                              uint32_t matrix_number_of_cols) {
+
+    uint32_t x = (uint32_t)number->pos.x;
+    uint32_t y = (uint32_t)number->pos.y;
+    uint32_t x_first = (x > 0) ? x - 1 : 0;
+    uint32_t x_last = x + number->length;
+    if(x_last > matrix_number_of_cols - 1) {
+        x_last = matrix_number_of_cols - 1;
+    }
+
+    // Above and below including diagonals, then left and right
+    if(y > 0 && row_range_has_symbol(matrix[y-1], x_first, x_last)) {
+        return true;
+    }
+    if(y+1 < matrix_number_of_rows && row_range_has_symbol(matrix[y+1], x_first, x_last)) {
+        return true;
+    }
+    return is_symbol_char(matrix[y][x_first]) || is_symbol_char(matrix[y][x_last]);
+}
+
+#endif
@@ -0,0 +1,129 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "packed_grid.h"
+
+// Definitions
+// ################################################
+
+#define WORDS_PER_CACHE_LINE (PACKED_ROW_ALIGNMENT / sizeof(uint64_t))
+// High bit of every 2-bit cell, set for CELL_SYMBOL only
+#define SYMBOL_BITS (0xAAAAAAAAAAAAAAAAULL)
+#define INITIAL_ROWS (64)
+
+// Helper Functions
+// ################################################
+
+static cell_class_t classify_cell(char c) {
+    // Same classification as is_digit/is_symbol of the character grid
+    if(c >= '0' && c <= '9') {
+        return CELL_DIGIT;
+    }
+    if(c == '\0' || c == '.' || c == '\n' || c == ' ') {
+        return CELL_EMPTY;
+    }
+    return CELL_SYMBOL;
+}
+
+// Bits of the cells [first, last] inside one word
+static uint64_t cell_range_mask(uint32_t first, uint32_t last) {
+    uint64_t upper = (last == PACKED_CELLS_PER_WORD - 1) ? ~0ULL : ((1ULL << (2 * (last + 1))) - 1);
+    uint64_t lower = (1ULL << (2 * first)) - 1;
+    return upper & ~lower;
+}
+
+// True if any cell in [x_first, x_last] of row y is a symbol (clamped to the grid)
+static bool row_range_has_symbol(const packed_grid_t* grid, int64_t y, int64_t x_first, int64_t x_last) {
+
+    if(y < 0 || y >= grid->number_of_rows) {
+        return false;
+    }
+    if(x_first < 0) {
+        x_first = 0;
+    }
+    if(x_last >= grid->number_of_cols) {
+        x_last = (int64_t)grid->number_of_cols - 1;
+    }
+    if(x_first > x_last) {
+        return false;
+    }
+
+    const uint64_t* row = grid->words + (size_t)y * grid->words_per_row;
+    size_t first_word = (size_t)x_first / PACKED_CELLS_PER_WORD;
+    size_t last_word = (size_t)x_last / PACKED_CELLS_PER_WORD;
+    for(size_t w=first_word; w<=last_word; ++w) {
+        uint32_t first = (w == first_word) ? (uint32_t)(x_first % PACKED_CELLS_PER_WORD) : 0;
+        uint32_t last = (w == last_word) ? (uint32_t)(x_last % PACKED_CELLS_PER_WORD) : PACKED_CELLS_PER_WORD - 1;
+        if(row[w] & SYMBOL_BITS & cell_range_mask(first, last)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Packed Grid
+// ################################################
+
+void init_packed_grid(packed_grid_t* grid, uint32_t number_of_cols) {
+
+    size_t words = (number_of_cols + PACKED_CELLS_PER_WORD - 1) / PACKED_CELLS_PER_WORD;
+    grid->words_per_row = (words + WORDS_PER_CACHE_LINE - 1) / WORDS_PER_CACHE_LINE * WORDS_PER_CACHE_LINE;
+    grid->number_of_rows = 0;
+    grid->number_of_cols = number_of_cols;
+    grid->allocated_rows = 0;
+    grid->words = NULL;
+}
+
+bool try_appending_packed_row(packed_grid_t* grid, const char* line) {
+
+    // Grow by doubling; posix_memalign keeps the rows cache line aligned
+    if(grid->number_of_rows >= grid->allocated_rows) {
+        size_t new_allocated_rows = (grid->allocated_rows > 0) ? grid->allocated_rows * 2 : INITIAL_ROWS;
+        void* new_words = NULL;
+        if(posix_memalign(&new_words, PACKED_ROW_ALIGNMENT,
+                          new_allocated_rows * grid->words_per_row * sizeof(uint64_t)) != 0) {
+            fprintf(stderr, "Error allocating memory for packed grid\n");
+            return false;
+        }
+        if(grid->words != NULL) {
+            memcpy(new_words, grid->words, grid->number_of_rows * grid->words_per_row * sizeof(uint64_t));
+            free(grid->words);
+        }
+        grid->words = new_words;
+        grid->allocated_rows = new_allocated_rows;
+    }
+
+    uint64_t* row = grid->words + (size_t)grid->number_of_rows * grid->words_per_row;
+    memset(row, 0, grid->words_per_row * sizeof(uint64_t));
+    for(uint32_t x=0; x<grid->number_of_cols; ++x) {
+        uint64_t cell = (uint64_t)classify_cell(line[x]);
+        row[x / PACKED_CELLS_PER_WORD] |= cell << (2 * (x % PACKED_CELLS_PER_WORD));
+    }
+    grid->number_of_rows++;
+    return true;
+}
+
+void destroy_packed_grid(packed_grid_t* grid) {
+    free(grid->words);
+    grid->words = NULL;
+    grid->number_of_rows = 0;
+    grid->allocated_rows = 0;
+}
+
+size_t packed_grid_bytes(const packed_grid_t* grid) {
+    return grid->allocated_rows * grid->words_per_row * sizeof(uint64_t);
+}
+
+bool packed_has_adjacent_symbol(const packed_grid_t* grid, const number_t* number) {
+
+    int64_t x_first = (int64_t)number->pos.x - 1;
+    int64_t x_last = (int64_t)number->pos.x + number->length;
+    int64_t y = number->pos.y;
+
+    // Above and below including diagonals, then left and right
+    return row_range_has_symbol(grid, y-1, x_first, x_last)
+        || row_range_has_symbol(grid, y+1, x_first, x_last)
+        || row_range_has_symbol(grid, y, x_first, x_first)
+        || row_range_has_symbol(grid, y, x_last, x_last);
+}
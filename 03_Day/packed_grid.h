@@ -0,0 +1,49 @@
+#ifndef DAY03_PACKED_GRID_H
+#define DAY03_PACKED_GRID_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "schematic.h"
+
+// Packed Grid
+// ################################################
+//
+// Stores only the class of every cell in 2 bits (32 cells per 64-bit word).
+// Each row starts on its own cache line. Digit values are not kept here,
+// they live in the numbers table.
+
+#define PACKED_CELLS_PER_WORD (32)
+#define PACKED_ROW_ALIGNMENT (64)
+
+typedef enum {
+    CELL_EMPTY = 0,
+    CELL_DIGIT = 1,
+    CELL_SYMBOL = 2
+} cell_class_t;
+
+typedef struct {
+    uint64_t* words;
+    uint32_t number_of_rows;
+    uint32_t number_of_cols;
+    size_t words_per_row;
+    size_t allocated_rows;
+} packed_grid_t;
+
+// Allocates nothing, rows are allocated as they are appended
+void init_packed_grid(packed_grid_t* grid, uint32_t number_of_cols);
+// line must have exactly number_of_cols characters
+bool try_appending_packed_row(packed_grid_t* grid, const char* line);
+void destroy_packed_grid(packed_grid_t* grid);
+size_t packed_grid_bytes(const packed_grid_t* grid);
+
+bool packed_has_adjacent_symbol(const packed_grid_t* grid, const number_t* number);
+
+static inline cell_class_t get_packed_cell(const packed_grid_t* grid, uint32_t x, uint32_t y) {
+    const uint64_t* row = grid->words + (size_t)y * grid->words_per_row;
+    uint64_t word = row[x / PACKED_CELLS_PER_WORD];
+    return (cell_class_t)((word >> (2 * (x % PACKED_CELLS_PER_WORD))) & 0x3);
+}
+
+#endif
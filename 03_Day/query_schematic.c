@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>   // PRIu64
+
+#include "input.h"
+#include "utils.h"
+#include "schematic_query.h"
+
+// Query Tool
+// ################################################
+//
+// Indexes a text schematic once and answers queries read from stdin, one per line:
+//   symbol X Y              symbol at (X, Y)
+//   touch X Y               numbers adjacent to (X, Y), e.g. the parts of a symbol
+//   rows Y0 Y1              sum of part numbers in rows Y0..Y1
+//   rect X0 Y0 X1 Y1        sum of part numbers with a digit inside the rectangle
+// Example:
+//   printf 'touch 3 1\nrows 0 9\n' | ./query_schematic input_small.txt
+
+#define TOUCH_CAPACITY (8)
+
+static bool try_answering_query(const schematic_index_t* index, const char* line) {
+
+    unsigned int a, b, c, d;
+    if(sscanf(line, "symbol %u %u", &a, &b) == 2) {
+        char symbol = schematic_symbol_at(index, a, b);
+        printf("symbol %u %u: %c\n", a, b, symbol != '\0' ? symbol : '-');
+        return true;
+    }
+    if(sscanf(line, "touch %u %u", &a, &b) == 2) {
+        uint64_t found[TOUCH_CAPACITY];
+        size_t found_cnt = schematic_numbers_touching(index, a, b, found, TOUCH_CAPACITY);
+        printf("touch %u %u:", a, b);
+        for(size_t i=0; i<found_cnt && i<TOUCH_CAPACITY; ++i) {
+            printf(" %d", index->numbers.value[found[i]]);
+        }
+        printf("\n");
+        return true;
+    }
+    if(sscanf(line, "rows %u %u", &a, &b) == 2) {
+        printf("rows %u %u: %" PRIu64 "\n", a, b, schematic_part_sum_in_rows(index, a, b));
+        return true;
+    }
+    if(sscanf(line, "rect %u %u %u %u", &a, &b, &c, &d) == 4) {
+        printf("rect %u %u %u %u: %" PRIu64 "\n", a, b, c, d, schematic_part_sum_in_rect(index, a, b, c, d));
+        return true;
+    }
+    return false;
+}
+
+int main(int argc, char* argv[]) {
+
+    if(argc != 2) {
+        fprintf(stderr, "Usage: %s input.txt < queries.txt\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int64_t start = millis();
+    input_t input;
+    if(!try_loading_input(argv[1], &input)) {
+        return EXIT_FAILURE;
+    }
+    schematic_index_t index;
+    bool indexed = try_building_schematic_index(input.data, input.size, &index);
+    release_input(&input);
+    if(!indexed) {
+        return EXIT_FAILURE;
+    }
+    fprintf(stderr, "Indexed %" PRIu64 " numbers in %u rows in %ld ms\n",
+            index.numbers.numbers_cnt, index.number_of_rows, (long)(millis() - start));
+
+    char* line = NULL;
+    size_t line_size = 0;
+    size_t line_number = 0;
+    int exit_code = EXIT_SUCCESS;
+    while(getline(&line, &line_size, stdin) != -1) {
+        line_number++;
+        if(line[0] == '\n' || line[0] == '#') {
+            continue;
+        }
+        if(!try_answering_query(&index, line)) {
+            fprintf(stderr, "Error: Invalid query at line %zu\n", line_number);
+            exit_code = EXIT_FAILURE;
+            break;
+        }
+    }
+
+    free(line);
+    destroy_schematic_index(&index);
+    return exit_code;
+}
@@ -0,0 +1,241 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hash.h"
+#include "grid_symbols.h"
+#include "row_memo.h"
+
+// Definitions
+// ################################################
+
+#define NO_INDEX (UINT32_MAX)
+#define TRIPLE_ROWS (3)
+// Stands in for the missing row above the first and below the last row
+#define NO_ROW_HASH (0x9E3779B97F4A7C15ULL)
+
+typedef struct {
+    uint64_t key;
+    uint64_t sum;
+    uint32_t rows[TRIPLE_ROWS];     // Rows the sum was computed on, NO_INDEX above/below the grid
+    uint32_t bucket_next;
+    uint32_t lru_prev;              // Towards the most recently used entry
+    uint32_t lru_next;
+} memo_entry_t;
+
+typedef struct {
+    memo_entry_t* entries;
+    uint32_t* buckets;
+    uint32_t bucket_mask;
+    uint32_t capacity;
+    uint32_t used;
+    uint32_t lru_head;              // Most recently used
+    uint32_t lru_tail;              // Evicted next
+} row_memo_t;
+
+// Helper Functions
+// ################################################
+
+static uint64_t triple_key(const uint64_t row_hashes[TRIPLE_ROWS]) {
+    return xxh64(row_hashes, TRIPLE_ROWS * sizeof(uint64_t), 0);
+}
+
+static bool rows_are_equal(const char** matrix, uint32_t matrix_number_of_cols, uint32_t a, uint32_t b) {
+    if(a == NO_INDEX || b == NO_INDEX) {
+        return a == b;
+    }
+    return a == b || memcmp(matrix[a], matrix[b], matrix_number_of_cols) == 0;
+}
+
+// Memo
+// ################################################
+
+static bool try_initializing_memo(row_memo_t* memo, uint32_t capacity) {
+
+    uint32_t bucket_cnt = 1;
+    while(bucket_cnt < capacity) {
+        bucket_cnt <<= 1;
+    }
+    memo->entries = malloc((size_t)capacity * sizeof(memo_entry_t));
+    memo->buckets = malloc((size_t)bucket_cnt * sizeof(uint32_t));
+    if(memo->entries == NULL || memo->buckets == NULL) {
+        fprintf(stderr, "Error allocating memory for row memo (%u entries)\n", capacity);
+        free(memo->entries);
+        free(memo->buckets);
+        return false;
+    }
+    for(uint32_t i=0; i<bucket_cnt; ++i) {
+        memo->buckets[i] = NO_INDEX;
+    }
+    memo->bucket_mask = bucket_cnt - 1;
+    memo->capacity = capacity;
+    memo->used = 0;
+    memo->lru_head = NO_INDEX;
+    memo->lru_tail = NO_INDEX;
+    return true;
+}
+
+static void destroy_memo(row_memo_t* memo) {
+    free(memo->entries);
+    free(memo->buckets);
+}
+
+static size_t memo_bytes(const row_memo_t* memo) {
+    return (size_t)memo->capacity * sizeof(memo_entry_t) + ((size_t)memo->bucket_mask + 1) * sizeof(uint32_t);
+}
+
+static void unlink_lru(row_memo_t* memo, uint32_t index) {
+    memo_entry_t* entry = &memo->entries[index];
+    if(entry->lru_prev != NO_INDEX) {
+        memo->entries[entry->lru_prev].lru_next = entry->lru_next;
+    } else {
+        memo->lru_head = entry->lru_next;
+    }
+    if(entry->lru_next != NO_INDEX) {
+        memo->entries[entry->lru_next].lru_prev = entry->lru_prev;
+    } else {
+        memo->lru_tail = entry->lru_prev;
+    }
+}
+
+static void push_lru_front(row_memo_t* memo, uint32_t index) {
+    memo_entry_t* entry = &memo->entries[index];
+    entry->lru_prev = NO_INDEX;
+    entry->lru_next = memo->lru_head;
+    if(memo->lru_head != NO_INDEX) {
+        memo->entries[memo->lru_head].lru_prev = index;
+    } else {
+        memo->lru_tail = index;
+    }
+    memo->lru_head = index;
+}
+
+static void unlink_bucket(row_memo_t* memo, uint32_t index) {
+    uint32_t* link = &memo->buckets[memo->entries[index].key & memo->bucket_mask];
+    while(*link != index) {
+        link = &memo->entries[*link].bucket_next;
+    }
+    *link = memo->entries[index].bucket_next;
+}
+
+static uint32_t find_entry(const row_memo_t* memo, uint64_t key) {
+    uint32_t index = memo->buckets[key & memo->bucket_mask];
+    while(index != NO_INDEX && memo->entries[index].key != key) {
+        index = memo->entries[index].bucket_next;
+    }
+    return index;
+}
+
+// New entry for key, the least recently used one is recycled once the memo is full
+static uint32_t claim_entry(row_memo_t* memo, uint64_t key, row_memo_stats_t* stats) {
+
+    uint32_t index;
+    if(memo->used < memo->capacity) {
+        index = memo->used++;
+    } else {
+        index = memo->lru_tail;
+        unlink_lru(memo, index);
+        unlink_bucket(memo, index);
+        stats->evictions++;
+    }
+    memo_entry_t* entry = &memo->entries[index];
+    entry->key = key;
+    uint32_t* bucket = &memo->buckets[key & memo->bucket_mask];
+    entry->bucket_next = *bucket;
+    *bucket = index;
+    push_lru_front(memo, index);
+    return index;
+}
+
+// Memoized Sum
+// ################################################
+
+bool try_summing_part_numbers_memoized(const number_t* numbers,
+                                       size_t numbers_cnt,
+                                       const char** matrix,
+                                       uint32_t matrix_number_of_rows,
+                                       uint32_t matrix_number_of_cols,
+                                       uint32_t max_entries,
+                                       uint64_t* number_sum,
+                                       row_memo_stats_t* stats) {
+
+    *number_sum = 0;
+    memset(stats, 0, sizeof(*stats));
+    if(numbers_cnt == 0) {
+        return true;
+    }
+    if(max_entries == 0) {
+        max_entries = ROW_MEMO_DEFAULT_ENTRIES;
+    }
+
+    row_memo_t memo;
+    if(!try_initializing_memo(&memo, max_entries)) {
+        return false;
+    }
+    stats->bytes = memo_bytes(&memo);
+
+    // Sliding window of row hashes: above, current, below
+    uint64_t row_hashes[TRIPLE_ROWS] = {
+        NO_ROW_HASH,
+        xxh64(matrix[0], matrix_number_of_cols, 0),
+        NO_ROW_HASH
+    };
+    size_t n = 0;
+    for(uint32_t y=0; y<matrix_number_of_rows; ++y) {
+        bool has_below = y+1 < matrix_number_of_rows;
+        row_hashes[2] = has_below ? xxh64(matrix[y+1], matrix_number_of_cols, 0) : NO_ROW_HASH;
+
+        size_t row_first = n;
+        while(n < numbers_cnt && (uint32_t)numbers[n].pos.y == y) {
+            n++;
+        }
+
+        // Rows without numbers add nothing and need no lookup
+        if(n > row_first) {
+            const uint32_t rows[TRIPLE_ROWS] = {y > 0 ? y - 1 : NO_INDEX, y, has_below ? y + 1 : NO_INDEX};
+            uint64_t key = triple_key(row_hashes);
+            stats->lookups++;
+
+            uint32_t index = find_entry(&memo, key);
+            bool hit = false;
+            if(index != NO_INDEX) {
+                const memo_entry_t* entry = &memo.entries[index];
+                hit = rows_are_equal(matrix, matrix_number_of_cols, entry->rows[0], rows[0])
+                   && rows_are_equal(matrix, matrix_number_of_cols, entry->rows[1], rows[1])
+                   && rows_are_equal(matrix, matrix_number_of_cols, entry->rows[2], rows[2]);
+                if(!hit) {
+                    stats->collisions++;
+                }
+            }
+
+            if(hit) {
+                stats->hits++;
+                unlink_lru(&memo, index);
+                push_lru_front(&memo, index);
+            } else {
+                uint64_t row_sum = 0;
+                for(size_t i=row_first; i<n; ++i) {
+                    if(matrix_has_adjacent_symbol(&numbers[i], matrix, matrix_number_of_rows, matrix_number_of_cols)) {
+                        row_sum += (uint64_t)numbers[i].value;
+                    }
+                }
+                // A colliding entry is taken over by the newer triple
+                if(index == NO_INDEX) {
+                    index = claim_entry(&memo, key, stats);
+                } else {
+                    unlink_lru(&memo, index);
+                    push_lru_front(&memo, index);
+                }
+                memo.entries[index].sum = row_sum;
+                memcpy(memo.entries[index].rows, rows, sizeof(rows));
+            }
+            *number_sum += memo.entries[index].sum;
+        }
+
+        row_hashes[0] = row_hashes[1];
+        row_hashes[1] = row_hashes[2];
+    }
+
+    destroy_memo(&memo);
+    return true;
+}
@@ -0,0 +1,43 @@
+#ifndef DAY03_ROW_MEMO_H
+#define DAY03_ROW_MEMO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "schematic.h"
+
+// Row Triple Memo
+// ################################################
+//
+// Whether a number touches a symbol only depends on its own row and the rows
+// above and below, so the part number sum of a row is a function of that row
+// triple. Generated schematics repeat rows and whole blocks of rows; the memo
+// keys each triple by the hashes of its three rows and reuses the sum of a
+// triple it has already seen. Entries remember the rows they were computed
+// on and a hit is only taken after comparing them, so hash collisions cost
+// time, never correctness. The memo holds at most max_entries triples and
+// evicts the least recently used one when it is full.
+
+#define ROW_MEMO_DEFAULT_ENTRIES (4096)
+#define ROW_MEMO_MAX_ENTRIES (1u << 24)
+
+typedef struct {
+    uint64_t lookups;       // Rows with at least one number
+    uint64_t hits;
+    uint64_t evictions;
+    uint64_t collisions;    // Same key, different rows
+    size_t bytes;           // Memo footprint
+} row_memo_stats_t;
+
+// numbers must be in row-major order, as produced by the parser
+bool try_summing_part_numbers_memoized(const number_t* numbers,
+                                       size_t numbers_cnt,
+                                       const char** matrix,
+                                       uint32_t matrix_number_of_rows,
+                                       uint32_t matrix_number_of_cols,
+                                       uint32_t max_entries,
+                                       uint64_t* number_sum,
+                                       row_memo_stats_t* stats);
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef DAY03_SCHEMATIC_H
+#define DAY03_SCHEMATIC_H
+
+#include <stdint.h>
+
+// Structs, Typedefs, Enums
+// ################################################
+
+typedef struct {
+    int32_t x;
+    int32_t y;
+} position_t;
+
+typedef struct {
+    int32_t value;
+    uint8_t length;
+    position_t pos;
+} number_t;
+
+#endif
@@ -0,0 +1,360 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>   // uint64_t
+#include <unistd.h>     // getpid
+
+#include "columns.h"
+#include "input.h"
+#include "swar.h"
+#include "gears.h"
+#include "grid_symbols.h"
+#include "schematic_binary.h"
+
+// Definitions
+// ################################################
+
+#define BITS_PER_WORD (64)
+
+// Growable arrays of the converter
+typedef struct {
+    uint64_t* row_first;
+    uint32_t* number_x;
+    uint8_t* number_length;
+    int32_t* number_value;
+    uint64_t* symbol_bitmap;
+    uint32_t* gear_x;
+    uint32_t* gear_y;
+    size_t rows_capacity;
+    size_t numbers_capacity;
+    size_t gears_capacity;
+    uint32_t number_of_rows;
+    uint32_t number_of_cols;
+    uint64_t numbers_cnt;
+    uint64_t gears_cnt;
+    uint64_t bitmap_words_per_row;
+} schematic_builder_t;
+
+// Helper Functions
+// ################################################
+
+// True if any bit in [x_first, x_last] of the bitmap row is set
+static bool bitmap_range_has_symbol(const uint64_t* row, uint64_t x_first, uint64_t x_last) {
+    uint64_t first_word = x_first / BITS_PER_WORD;
+    uint64_t last_word = x_last / BITS_PER_WORD;
+    for(uint64_t w=first_word; w<=last_word; ++w) {
+        uint64_t mask = ~0ULL;
+        if(w == first_word) {
+            mask &= ~0ULL << (x_first % BITS_PER_WORD);
+        }
+        if(w == last_word && (x_last % BITS_PER_WORD) != BITS_PER_WORD - 1) {
+            mask &= (1ULL << (x_last % BITS_PER_WORD + 1)) - 1;
+        }
+        if(row[w] & mask) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void destroy_builder(schematic_builder_t* builder) {
+    free(builder->row_first);
+    free(builder->number_x);
+    free(builder->number_length);
+    free(builder->number_value);
+    free(builder->symbol_bitmap);
+    free(builder->gear_x);
+    free(builder->gear_y);
+}
+
+// Converter
+// ################################################
+
+static bool try_parsing_schematic_row(schematic_builder_t* builder, const char* line) {
+
+    uint32_t y = builder->number_of_rows;
+    void** row_arrays[] = {(void**)&builder->row_first, (void**)&builder->symbol_bitmap};
+    const size_t row_element_sizes[] = {sizeof(uint64_t), builder->bitmap_words_per_row * sizeof(uint64_t)};
+    // +2: the row index also holds the end of the last row
+    if(!try_growing_arrays(row_arrays, row_element_sizes, 2,
+                           &builder->rows_capacity, (size_t)y + 2, "binary schematic")) {
+        return false;
+    }
+    uint64_t* bitmap_row = builder->symbol_bitmap + (size_t)y * builder->bitmap_words_per_row;
+    memset(bitmap_row, 0, builder->bitmap_words_per_row * sizeof(uint64_t));
+    builder->row_first[y] = builder->numbers_cnt;
+
+    for(uint32_t x=0; x<builder->number_of_cols; ++x) {
+        char c = line[x];
+        if(c >= '0' && c <= '9') {
+            uint64_t value;
+            size_t length;
+            if(!swar_try_parsing_uint(&line[x], builder->number_of_cols - x, INT32_MAX, &value, &length)
+            || length > UINT8_MAX) {
+                fprintf(stderr, "Error: Number at row %u col %u does not fit into 32 bits\n", y, x);
+                return false;
+            }
+            void** number_arrays[] = {(void**)&builder->number_x, (void**)&builder->number_length,
+                                      (void**)&builder->number_value};
+            const size_t number_element_sizes[] = {sizeof(uint32_t), sizeof(uint8_t), sizeof(int32_t)};
+            if(!try_growing_arrays(number_arrays, number_element_sizes, 3,
+                                   &builder->numbers_capacity, (size_t)builder->numbers_cnt + 1, "binary schematic")) {
+                return false;
+            }
+            builder->number_x[builder->numbers_cnt] = x;
+            builder->number_length[builder->numbers_cnt] = (uint8_t)length;
+            builder->number_value[builder->numbers_cnt] = (int32_t)value;
+            builder->numbers_cnt++;
+            x += (uint32_t)length - 1;
+            continue;
+        }
+        if(!is_symbol_char(c)) {
+            continue;
+        }
+        bitmap_row[x / BITS_PER_WORD] |= 1ULL << (x % BITS_PER_WORD);
+        if(c == '*') {
+            void** gear_arrays[] = {(void**)&builder->gear_x, (void**)&builder->gear_y};
+            const size_t gear_element_sizes[] = {sizeof(uint32_t), sizeof(uint32_t)};
+            if(!try_growing_arrays(gear_arrays, gear_element_sizes, 2,
+                                   &builder->gears_capacity, (size_t)builder->gears_cnt + 1, "binary schematic")) {
+                return false;
+            }
+            builder->gear_x[builder->gears_cnt] = x;
+            builder->gear_y[builder->gears_cnt] = y;
+            builder->gears_cnt++;
+        }
+    }
+
+    builder->number_of_rows++;
+    builder->row_first[builder->number_of_rows] = builder->numbers_cnt;
+    return true;
+}
+
+static bool try_writing_section(FILE* file, uint64_t* written, uint64_t offset, const void* data, uint64_t size) {
+    static const char padding[SCHEMATIC_BINARY_ALIGNMENT] = {0};
+    while(*written < offset) {
+        uint64_t padding_size = offset - *written;
+        if(padding_size > sizeof(padding)) {
+            padding_size = sizeof(padding);
+        }
+        if(fwrite(padding, 1, padding_size, file) != padding_size) {
+            return false;
+        }
+        *written += padding_size;
+    }
+    if(size > 0 && fwrite(data, 1, size, file) != size) {
+        return false;
+    }
+    *written += size;
+    return true;
+}
+
+static bool try_writing_schematic(const schematic_builder_t* builder, const char* output_file_name) {
+
+    schematic_binary_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SCHEMATIC_BINARY_MAGIC, SCHEMATIC_BINARY_MAGIC_LEN);
+    header.version = SCHEMATIC_BINARY_VERSION;
+    header.header_size = sizeof(header);
+    header.number_of_rows = builder->number_of_rows;
+    header.number_of_cols = builder->number_of_cols;
+    header.numbers_cnt = builder->numbers_cnt;
+    header.gears_cnt = builder->gears_cnt;
+    header.bitmap_words_per_row = builder->bitmap_words_per_row;
+
+    uint64_t rows = builder->number_of_rows;
+    header.row_index_offset = align_up(sizeof(header), SCHEMATIC_BINARY_ALIGNMENT);
+    header.number_x_offset = align_up(header.row_index_offset + (rows + 1) * sizeof(uint64_t),
+                                      SCHEMATIC_BINARY_ALIGNMENT);
+    header.number_length_offset = align_up(header.number_x_offset + header.numbers_cnt * sizeof(uint32_t),
+                                           SCHEMATIC_BINARY_ALIGNMENT);
+    header.number_value_offset = align_up(header.number_length_offset + header.numbers_cnt * sizeof(uint8_t),
+                                          SCHEMATIC_BINARY_ALIGNMENT);
+    header.symbol_bitmap_offset = align_up(header.number_value_offset + header.numbers_cnt * sizeof(int32_t),
+                                           SCHEMATIC_BINARY_ALIGNMENT);
+    header.gear_x_offset = align_up(header.symbol_bitmap_offset + rows * header.bitmap_words_per_row * sizeof(uint64_t),
+                                    SCHEMATIC_BINARY_ALIGNMENT);
+    header.gear_y_offset = align_up(header.gear_x_offset + header.gears_cnt * sizeof(uint32_t),
+                                    SCHEMATIC_BINARY_ALIGNMENT);
+
+    // Write next to the target and rename, so readers never map a half written file
+    char temp_path[4096];
+    int temp_path_len = snprintf(temp_path, sizeof(temp_path), "%s.%ld.tmp", output_file_name, (long)getpid());
+    if(temp_path_len < 0 || (size_t)temp_path_len >= sizeof(temp_path)) {
+        fprintf(stderr, "Error: Output path too long\n");
+        return false;
+    }
+    FILE* file = fopen(temp_path, "wb");
+    if(file == NULL) {
+        perror("Error opening binary schematic for writing");
+        return false;
+    }
+
+    uint64_t written = 0;
+    uint64_t empty_row_index = 0;
+    const uint64_t* row_first = (rows > 0) ? builder->row_first : &empty_row_index;
+    bool success = try_writing_section(file, &written, 0, &header, sizeof(header))
+        && try_writing_section(file, &written, header.row_index_offset, row_first, (rows + 1) * sizeof(uint64_t))
+        && try_writing_section(file, &written, header.number_x_offset, builder->number_x, header.numbers_cnt * sizeof(uint32_t))
+        && try_writing_section(file, &written, header.number_length_offset, builder->number_length, header.numbers_cnt * sizeof(uint8_t))
+        && try_writing_section(file, &written, header.number_value_offset, builder->number_value, header.numbers_cnt * sizeof(int32_t))
+        && try_writing_section(file, &written, header.symbol_bitmap_offset, builder->symbol_bitmap,
+                               rows * header.bitmap_words_per_row * sizeof(uint64_t))
+        && try_writing_section(file, &written, header.gear_x_offset, builder->gear_x, header.gears_cnt * sizeof(uint32_t))
+        && try_writing_section(file, &written, header.gear_y_offset, builder->gear_y, header.gears_cnt * sizeof(uint32_t));
+    if(fclose(file) != 0) {
+        success = false;
+    }
+    if(!success) {
+        perror("Error writing binary schematic");
+        remove(temp_path);
+        return false;
+    }
+    if(rename(temp_path, output_file_name) == -1) {
+        perror("Error renaming binary schematic");
+        remove(temp_path);
+        return false;
+    }
+    return true;
+}
+
+bool is_binary_schematic(const char* input, size_t input_size) {
+    return input_size >= SCHEMATIC_BINARY_MAGIC_LEN
+        && memcmp(input, SCHEMATIC_BINARY_MAGIC, SCHEMATIC_BINARY_MAGIC_LEN) == 0;
+}
+
+bool try_converting_schematic(const char* input, size_t input_size, const char* output_file_name) {
+
+    schematic_builder_t builder;
+    memset(&builder, 0, sizeof(builder));
+    bool success = false;
+
+    const char* line = NULL;
+    size_t read_bytes = 0;
+    const char* cursor = input;
+    const char* input_end = input + input_size;
+    while(next_line(&cursor, input_end, &line, &read_bytes)) {
+
+        // Same well-formedness rules as the text solver
+        if(builder.number_of_cols != 0) {
+            if(read_bytes != builder.number_of_cols) {
+                fprintf(stderr, "Error: Line %u has different length than previous lines\n", builder.number_of_rows);
+                goto cleanup;
+            }
+        } else {
+            if(read_bytes > UINT32_MAX) {
+                fprintf(stderr, "Error: Line %u is too long\n", builder.number_of_rows);
+                goto cleanup;
+            }
+            builder.number_of_cols = (uint32_t)read_bytes;
+            builder.bitmap_words_per_row = (read_bytes + BITS_PER_WORD - 1) / BITS_PER_WORD;
+        }
+        if(builder.number_of_rows == UINT32_MAX) {
+            fprintf(stderr, "Error: Too many rows\n");
+            goto cleanup;
+        }
+        if(!try_parsing_schematic_row(&builder, line)) {
+            goto cleanup;
+        }
+    }
+
+    success = try_writing_schematic(&builder, output_file_name);
+
+    cleanup:
+        destroy_builder(&builder);
+        return success;
+}
+
+// Loader
+// ################################################
+
+bool try_solving_binary_schematic(const char* input, size_t input_size, solver_result_t* result) {
+
+    schematic_binary_header_t header;
+    if(input_size < sizeof(header) || !is_binary_schematic(input, input_size)) {
+        fprintf(stderr, "Error: Not a binary schematic\n");
+        return false;
+    }
+    memcpy(&header, input, sizeof(header));
+    if(header.version != SCHEMATIC_BINARY_VERSION || header.header_size != sizeof(header)) {
+        fprintf(stderr, "Error: Binary schematic version %u is not supported (expected %u), convert it again\n",
+                header.version, SCHEMATIC_BINARY_VERSION);
+        return false;
+    }
+    if((uintptr_t)input % sizeof(uint64_t) != 0) {
+        fprintf(stderr, "Error: Binary schematic buffer is not aligned\n");
+        return false;
+    }
+
+    uint64_t rows = header.number_of_rows;
+    uint64_t cols = header.number_of_cols;
+    if(header.bitmap_words_per_row != (cols + BITS_PER_WORD - 1) / BITS_PER_WORD
+    || !section_is_valid(header.row_index_offset, rows + 1, sizeof(uint64_t), input_size)
+    || !section_is_valid(header.number_x_offset, header.numbers_cnt, sizeof(uint32_t), input_size)
+    || !section_is_valid(header.number_length_offset, header.numbers_cnt, sizeof(uint8_t), input_size)
+    || !section_is_valid(header.number_value_offset, header.numbers_cnt, sizeof(int32_t), input_size)
+    || !section_is_valid(header.symbol_bitmap_offset, rows * header.bitmap_words_per_row, sizeof(uint64_t), input_size)
+    || !section_is_valid(header.gear_x_offset, header.gears_cnt, sizeof(uint32_t), input_size)
+    || !section_is_valid(header.gear_y_offset, header.gears_cnt, sizeof(uint32_t), input_size)) {
+        fprintf(stderr, "Error: Binary schematic is truncated or corrupt\n");
+        return false;
+    }
+
+    // Point straight into the mapped file, nothing is copied or parsed
+    number_table_t table = {
+        .number_of_rows = header.number_of_rows,
+        .numbers_cnt = header.numbers_cnt,
+        .row_first = (const uint64_t*)(const void*)(input + header.row_index_offset),
+        .x = (const uint32_t*)(const void*)(input + header.number_x_offset),
+        .length = (const uint8_t*)(const void*)(input + header.number_length_offset),
+        .value = (const int32_t*)(const void*)(input + header.number_value_offset)
+    };
+    const uint64_t* symbol_bitmap = (const uint64_t*)(const void*)(input + header.symbol_bitmap_offset);
+    const uint32_t* gear_x = (const uint32_t*)(const void*)(input + header.gear_x_offset);
+    const uint32_t* gear_y = (const uint32_t*)(const void*)(input + header.gear_y_offset);
+
+    // Part 1: numbers with a symbol in their neighbourhood
+    uint64_t number_sum = 0;
+    for(uint64_t y=0; y<rows; ++y) {
+        uint64_t first = table.row_first[y];
+        uint64_t end = table.row_first[y+1];
+        if(first > end || end > header.numbers_cnt) {
+            fprintf(stderr, "Error: Binary schematic row index is corrupt\n");
+            return false;
+        }
+        const uint64_t* row = symbol_bitmap + y * header.bitmap_words_per_row;
+        for(uint64_t i=first; i<end; ++i) {
+            uint64_t x = table.x[i];
+            if(table.length[i] == 0 || x + table.length[i] > cols) {
+                fprintf(stderr, "Error: Binary schematic number %" PRIu64 " is out of bounds\n", i);
+                return false;
+            }
+            uint64_t x_first = (x > 0) ? x - 1 : 0;
+            uint64_t x_last = (x + table.length[i] < cols) ? x + table.length[i] : cols - 1;
+            if((y > 0 && bitmap_range_has_symbol(row - header.bitmap_words_per_row, x_first, x_last))
+            || (y+1 < rows && bitmap_range_has_symbol(row + header.bitmap_words_per_row, x_first, x_last))
+            || bitmap_range_has_symbol(row, x_first, x_first)
+            || bitmap_range_has_symbol(row, x_last, x_last)) {
+                number_sum += (uint64_t)table.value[i];
+            }
+        }
+    }
+    if(rows > 0 && table.row_first[rows] != header.numbers_cnt) {
+        fprintf(stderr, "Error: Binary schematic row index is corrupt\n");
+        return false;
+    }
+
+    // Part 2: gear ratios
+    for(uint64_t g=0; g<header.gears_cnt; ++g) {
+        if(gear_x[g] >= cols || gear_y[g] >= rows) {
+            fprintf(stderr, "Error: Binary schematic gear %" PRIu64 " is out of bounds\n", g);
+            return false;
+        }
+    }
+    uint64_t ratio_sum = sum_gear_ratios(&table, gear_x, gear_y, (size_t)header.gears_cnt);
+
+    result->part_one = (int64_t)number_sum;
+    result->part_two = (int64_t)ratio_sum;
+    result->has_part_two = true;
+    return true;
+}
@@ -0,0 +1,58 @@
+#ifndef DAY03_SCHEMATIC_BINARY_H
+#define DAY03_SCHEMATIC_BINARY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "solver.h"
+
+// Binary Schematic Format
+// ################################################
+//
+// Precompiled schematic that is solved straight from the mapped file, without
+// any parsing. Layout (native little-endian, every section 64-byte aligned):
+//
+//   header                      schematic_binary_header_t
+//   row index                   uint64_t[rows+1], numbers of row y: [index[y], index[y+1])
+//   number x                    uint32_t[numbers_cnt]
+//   number length               uint8_t[numbers_cnt]
+//   number value                int32_t[numbers_cnt]
+//   symbol bitmap               uint64_t[rows * bitmap_words_per_row], 1 bit per cell
+//   gear x, gear y              uint32_t[gears_cnt] each, positions of every '*'
+//
+// Bump SCHEMATIC_BINARY_VERSION on any layout change.
+
+#define SCHEMATIC_BINARY_MAGIC "AOC03SCH"
+#define SCHEMATIC_BINARY_MAGIC_LEN (8)
+#define SCHEMATIC_BINARY_VERSION (1)
+#define SCHEMATIC_BINARY_ALIGNMENT (64)
+
+typedef struct {
+    char magic[SCHEMATIC_BINARY_MAGIC_LEN];
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t number_of_rows;
+    uint32_t number_of_cols;
+    uint64_t numbers_cnt;
+    uint64_t gears_cnt;
+    uint64_t bitmap_words_per_row;
+    uint64_t row_index_offset;
+    uint64_t number_x_offset;
+    uint64_t number_length_offset;
+    uint64_t number_value_offset;
+    uint64_t symbol_bitmap_offset;
+    uint64_t gear_x_offset;
+    uint64_t gear_y_offset;
+} schematic_binary_header_t;
+
+// True if input starts with the binary schematic magic
+bool is_binary_schematic(const char* input, size_t input_size);
+
+// Parses a text schematic and writes it in the binary format
+bool try_converting_schematic(const char* input, size_t input_size, const char* output_file_name);
+
+// Answers part 1 and 2 from a mapped binary schematic (validated before use)
+bool try_solving_binary_schematic(const char* input, size_t input_size, solver_result_t* result);
+
+#endif
@@ -0,0 +1,308 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "columns.h"
+#include "input.h"
+#include "swar.h"
+#include "grid_symbols.h"
+#include "schematic_query.h"
+
+// Definitions
+// ################################################
+
+// Growable arrays while parsing
+typedef struct {
+    uint64_t* number_row_first;
+    uint32_t* number_x;
+    uint8_t* number_length;
+    int32_t* number_value;
+    uint64_t* symbol_row_first;
+    uint32_t* symbol_x;
+    char* symbol_char;
+    size_t rows_capacity;
+    size_t numbers_capacity;
+    size_t symbols_capacity;
+    uint64_t numbers_cnt;
+    uint64_t symbols_cnt;
+} index_builder_t;
+
+// Helper Functions
+// ################################################
+
+// First symbol of row y at or right of x_first
+static uint64_t find_first_symbol_at_or_after(const schematic_index_t* index, uint32_t y, int64_t x_first) {
+    uint64_t low = index->symbol_row_first[y];
+    uint64_t high = index->symbol_row_first[y+1];
+    while(low < high) {
+        uint64_t mid = low + (high - low) / 2;
+        if((int64_t)index->symbol_x[mid] < x_first) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// First number of row y that starts right of x_last
+static uint64_t find_first_number_starting_after(const number_table_t* table, uint32_t y, int64_t x_last) {
+    uint64_t low = table->row_first[y];
+    uint64_t high = table->row_first[y+1];
+    while(low < high) {
+        uint64_t mid = low + (high - low) / 2;
+        if((int64_t)table->x[mid] <= x_last) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static bool has_symbol_in_range(const schematic_index_t* index, uint32_t y, int64_t x_first, int64_t x_last) {
+    uint64_t s = find_first_symbol_at_or_after(index, y, x_first);
+    return s < index->symbol_row_first[y+1] && (int64_t)index->symbol_x[s] <= x_last;
+}
+
+static void destroy_builder(index_builder_t* builder) {
+    free(builder->number_row_first);
+    free(builder->number_x);
+    free(builder->number_length);
+    free(builder->number_value);
+    free(builder->symbol_row_first);
+    free(builder->symbol_x);
+    free(builder->symbol_char);
+}
+
+// Building
+// ################################################
+
+static bool try_parsing_index_row(index_builder_t* builder, uint32_t y, const char* line, uint32_t cols) {
+
+    void** row_arrays[] = {(void**)&builder->number_row_first, (void**)&builder->symbol_row_first};
+    const size_t row_element_sizes[] = {sizeof(uint64_t), sizeof(uint64_t)};
+    // +2: the row indices also hold the end of the last row
+    if(!try_growing_arrays(row_arrays, row_element_sizes, 2,
+                           &builder->rows_capacity, (size_t)y + 2, "schematic index")) {
+        return false;
+    }
+    builder->number_row_first[y] = builder->numbers_cnt;
+    builder->symbol_row_first[y] = builder->symbols_cnt;
+
+    for(uint32_t x=0; x<cols; ++x) {
+        char c = line[x];
+        if(c >= '0' && c <= '9') {
+            uint64_t value;
+            size_t length;
+            if(!swar_try_parsing_uint(&line[x], cols - x, INT32_MAX, &value, &length) || length > UINT8_MAX) {
+                fprintf(stderr, "Error: Number at row %u col %u does not fit into 32 bits\n", y, x);
+                return false;
+            }
+            void** number_arrays[] = {(void**)&builder->number_x, (void**)&builder->number_length,
+                                      (void**)&builder->number_value};
+            const size_t number_element_sizes[] = {sizeof(uint32_t), sizeof(uint8_t), sizeof(int32_t)};
+            if(!try_growing_arrays(number_arrays, number_element_sizes, 3,
+                                   &builder->numbers_capacity, (size_t)builder->numbers_cnt + 1, "schematic index")) {
+                return false;
+            }
+            builder->number_x[builder->numbers_cnt] = x;
+            builder->number_length[builder->numbers_cnt] = (uint8_t)length;
+            builder->number_value[builder->numbers_cnt] = (int32_t)value;
+            builder->numbers_cnt++;
+            x += (uint32_t)length - 1;
+            continue;
+        }
+        if(!is_symbol_char(c)) {
+            continue;
+        }
+        void** symbol_arrays[] = {(void**)&builder->symbol_x, (void**)&builder->symbol_char};
+        const size_t symbol_element_sizes[] = {sizeof(uint32_t), sizeof(char)};
+        if(!try_growing_arrays(symbol_arrays, symbol_element_sizes, 2,
+                               &builder->symbols_capacity, (size_t)builder->symbols_cnt + 1, "schematic index")) {
+            return false;
+        }
+        builder->symbol_x[builder->symbols_cnt] = x;
+        builder->symbol_char[builder->symbols_cnt] = c;
+        builder->symbols_cnt++;
+    }
+
+    builder->number_row_first[y+1] = builder->numbers_cnt;
+    builder->symbol_row_first[y+1] = builder->symbols_cnt;
+    return true;
+}
+
+// Marks part numbers and sums their values in table order
+static bool try_classifying_numbers(schematic_index_t* index) {
+
+    const number_table_t* numbers = &index->numbers;
+    uint8_t* is_part = malloc((numbers->numbers_cnt > 0 ? numbers->numbers_cnt : 1) * sizeof(uint8_t));
+    uint64_t* part_prefix = malloc((numbers->numbers_cnt + 1) * sizeof(uint64_t));
+    if(is_part == NULL || part_prefix == NULL) {
+        fprintf(stderr, "Error allocating memory for schematic index\n");
+        free(is_part);
+        free(part_prefix);
+        return false;
+    }
+
+    part_prefix[0] = 0;
+    for(uint32_t y=0; y<index->number_of_rows; ++y) {
+        uint32_t y_first = (y > 0) ? y - 1 : 0;
+        uint32_t y_last = (y + 1 < index->number_of_rows) ? y + 1 : y;
+        for(uint64_t n=numbers->row_first[y]; n<numbers->row_first[y+1]; ++n) {
+            int64_t x_first = (int64_t)numbers->x[n] - 1;
+            int64_t x_last = (int64_t)numbers->x[n] + numbers->length[n];
+            bool found = false;
+            for(uint32_t row=y_first; row<=y_last && !found; ++row) {
+                found = has_symbol_in_range(index, row, x_first, x_last);
+            }
+            is_part[n] = found ? 1 : 0;
+            part_prefix[n+1] = part_prefix[n] + (found ? (uint64_t)numbers->value[n] : 0);
+        }
+    }
+
+    index->is_part = is_part;
+    index->part_prefix = part_prefix;
+    return true;
+}
+
+bool try_building_schematic_index(const char* input, size_t input_size, schematic_index_t* index) {
+
+    memset(index, 0, sizeof(schematic_index_t));
+    index_builder_t builder;
+    memset(&builder, 0, sizeof(index_builder_t));
+
+    const char* cursor = input;
+    const char* end = input + input_size;
+    const char* line;
+    size_t line_len;
+    uint32_t rows = 0;
+    uint32_t cols = 0;
+    bool successful = true;
+    while(successful && next_line(&cursor, end, &line, &line_len)) {
+        // Line lengths include the '\n', like the solver compares them
+        if(rows == 0) {
+            if(line_len > UINT32_MAX) {
+                fprintf(stderr, "Error: Line 0 is too long\n");
+                successful = false;
+                break;
+            }
+            cols = (uint32_t)line_len;
+        } else if(line_len != cols) {
+            fprintf(stderr, "Error: Line %u has different length than previous lines\n", rows);
+            successful = false;
+            break;
+        }
+        successful = try_parsing_index_row(&builder, rows, line, cols);
+        rows++;
+    }
+    if(successful && rows == 0) {
+        successful = try_parsing_index_row(&builder, 0, "", 0);
+    }
+    if(!successful) {
+        destroy_builder(&builder);
+        return false;
+    }
+
+    index->number_of_rows = rows;
+    index->number_of_cols = (cols > 0 && input[cols-1] == '\n') ? cols - 1 : cols;
+    index->numbers.number_of_rows = rows;
+    index->numbers.numbers_cnt = builder.numbers_cnt;
+    index->numbers.row_first = builder.number_row_first;
+    index->numbers.x = builder.number_x;
+    index->numbers.length = builder.number_length;
+    index->numbers.value = builder.number_value;
+    index->symbol_row_first = builder.symbol_row_first;
+    index->symbol_x = builder.symbol_x;
+    index->symbol_char = builder.symbol_char;
+
+    if(!try_classifying_numbers(index)) {
+        destroy_schematic_index(index);
+        return false;
+    }
+    return true;
+}
+
+void destroy_schematic_index(schematic_index_t* index) {
+    destroy_number_table(&index->numbers);
+    free((void*)index->is_part);
+    free((void*)index->part_prefix);
+    free((void*)index->symbol_row_first);
+    free((void*)index->symbol_x);
+    free((void*)index->symbol_char);
+    memset(index, 0, sizeof(schematic_index_t));
+}
+
+// Queries
+// ################################################
+
+char schematic_symbol_at(const schematic_index_t* index, uint32_t x, uint32_t y) {
+    if(y >= index->number_of_rows) {
+        return '\0';
+    }
+    uint64_t s = find_first_symbol_at_or_after(index, y, x);
+    if(s < index->symbol_row_first[y+1] && index->symbol_x[s] == x) {
+        return index->symbol_char[s];
+    }
+    return '\0';
+}
+
+size_t schematic_numbers_touching(const schematic_index_t* index,
+                                  uint32_t x,
+                                  uint32_t y,
+                                  uint64_t* found,
+                                  size_t capacity) {
+
+    if(y >= index->number_of_rows) {
+        return 0;
+    }
+    const number_table_t* numbers = &index->numbers;
+    uint32_t y_first = (y > 0) ? y - 1 : 0;
+    uint32_t y_last = (y + 1 < index->number_of_rows) ? y + 1 : y;
+    size_t found_cnt = 0;
+    for(uint32_t row=y_first; row<=y_last; ++row) {
+        uint64_t end = numbers->row_first[row+1];
+        for(uint64_t n=find_first_number_ending_at_or_after(numbers, row, (int64_t)x - 1);
+            n<end && (int64_t)numbers->x[n] <= (int64_t)x + 1; ++n) {
+            if(found_cnt < capacity) {
+                found[found_cnt] = n;
+            }
+            found_cnt++;
+        }
+    }
+    return found_cnt;
+}
+
+uint64_t schematic_part_sum_in_rows(const schematic_index_t* index, uint32_t y_first, uint32_t y_last) {
+    if(index->number_of_rows == 0 || y_first >= index->number_of_rows || y_first > y_last) {
+        return 0;
+    }
+    if(y_last >= index->number_of_rows) {
+        y_last = index->number_of_rows - 1;
+    }
+    const uint64_t* row_first = index->numbers.row_first;
+    return index->part_prefix[row_first[y_last+1]] - index->part_prefix[row_first[y_first]];
+}
+
+uint64_t schematic_part_sum_in_rect(const schematic_index_t* index,
+                                    uint32_t x_first,
+                                    uint32_t y_first,
+                                    uint32_t x_last,
+                                    uint32_t y_last) {
+
+    if(index->number_of_rows == 0 || y_first >= index->number_of_rows || y_first > y_last || x_first > x_last) {
+        return 0;
+    }
+    if(y_last >= index->number_of_rows) {
+        y_last = index->number_of_rows - 1;
+    }
+    uint64_t sum = 0;
+    for(uint32_t y=y_first; y<=y_last; ++y) {
+        uint64_t first = find_first_number_ending_at_or_after(&index->numbers, y, x_first);
+        uint64_t end = find_first_number_starting_after(&index->numbers, y, x_last);
+        if(first < end) {
+            sum += index->part_prefix[end] - index->part_prefix[first];
+        }
+    }
+    return sum;
+}
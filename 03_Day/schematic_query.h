@@ -0,0 +1,56 @@
+#ifndef DAY03_SCHEMATIC_QUERY_H
+#define DAY03_SCHEMATIC_QUERY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "gears.h"
+
+// Schematic Index
+// ################################################
+//
+// Built once from a text schematic, then answers queries without looking at
+// the grid again: numbers and symbols are bucketed by row and sorted by x,
+// every number knows if it is a part number, and a running sum of part values
+// in table order turns any contiguous run of numbers into one subtraction.
+//
+//   symbol / touching point     O(log n) per row, 3 rows
+//   part sum of a row range     O(1)
+//   part sum of a rectangle     O(log n) per row
+
+typedef struct {
+    uint32_t number_of_rows;
+    uint32_t number_of_cols;
+    number_table_t numbers;
+    const uint8_t* is_part;         // Per number: adjacent to a symbol
+    const uint64_t* part_prefix;    // numbers_cnt+1 entries, part value sum of numbers [0, n)
+    const uint64_t* symbol_row_first;
+    const uint32_t* symbol_x;
+    const char* symbol_char;
+} schematic_index_t;
+
+bool try_building_schematic_index(const char* input, size_t input_size, schematic_index_t* index);
+void destroy_schematic_index(schematic_index_t* index);
+
+// Symbol at (x, y), '\0' if the cell holds none
+char schematic_symbol_at(const schematic_index_t* index, uint32_t x, uint32_t y);
+
+// Numbers with a digit in the 8-neighbourhood of (x, y). Stores up to capacity
+// number table indices in found and returns the total count.
+size_t schematic_numbers_touching(const schematic_index_t* index,
+                                  uint32_t x,
+                                  uint32_t y,
+                                  uint64_t* found,
+                                  size_t capacity);
+
+// Part number sums, bounds are inclusive and clamped to the schematic.
+// A number counts for a rectangle if any of its digits lies inside.
+uint64_t schematic_part_sum_in_rows(const schematic_index_t* index, uint32_t y_first, uint32_t y_last);
+uint64_t schematic_part_sum_in_rect(const schematic_index_t* index,
+                                    uint32_t x_first,
+                                    uint32_t y_first,
+                                    uint32_t x_last,
+                                    uint32_t y_last);
+
+#endif
@@ -0,0 +1,61 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "grid_symbols.h"
+#include "tiled_scan.h"
+
+// Tiled Scan
+// ################################################
+
+bool try_summing_part_numbers_tiled(const number_t* numbers,
+                                    size_t numbers_cnt,
+                                    const char** matrix,
+                                    uint32_t matrix_number_of_rows,
+                                    uint32_t matrix_number_of_cols,
+                                    uint32_t tile_width,
+                                    uint64_t* number_sum) {
+
+    *number_sum = 0;
+    if(numbers_cnt == 0) {
+        return true;
+    }
+    if(tile_width == 0) {
+        tile_width = TILED_DEFAULT_TILE_WIDTH;
+    }
+
+    // Per row: index of the next number not yet checked, row_end[y] is one past its last number
+    size_t* row_cursor = malloc(matrix_number_of_rows * sizeof(size_t));
+    size_t* row_end = malloc(matrix_number_of_rows * sizeof(size_t));
+    if(row_cursor == NULL || row_end == NULL) {
+        fprintf(stderr, "Error allocating memory for tiled row index\n");
+        free(row_cursor);
+        free(row_end);
+        return false;
+    }
+    size_t n = 0;
+    for(uint32_t y=0; y<matrix_number_of_rows; ++y) {
+        row_cursor[y] = n;
+        while(n < numbers_cnt && (uint32_t)numbers[n].pos.y == y) {
+            n++;
+        }
+        row_end[y] = n;
+    }
+
+    for(uint64_t tile_start=0; tile_start<matrix_number_of_cols; tile_start+=tile_width) {
+        uint64_t tile_end = tile_start + tile_width;
+        for(uint32_t y=0; y<matrix_number_of_rows; ++y) {
+            size_t i = row_cursor[y];
+            while(i < row_end[y] && (uint64_t)numbers[i].pos.x < tile_end) {
+                if(matrix_has_adjacent_symbol(&numbers[i], matrix, matrix_number_of_rows, matrix_number_of_cols)) {
+                    *number_sum += (uint64_t)numbers[i].value;
+                }
+                i++;
+            }
+            row_cursor[y] = i;
+        }
+    }
+
+    free(row_cursor);
+    free(row_end);
+    return true;
+}
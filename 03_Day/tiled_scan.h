@@ -0,0 +1,31 @@
+#ifndef DAY03_TILED_SCAN_H
+#define DAY03_TILED_SCAN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "schematic.h"
+
+// Tiled Scan
+// ################################################
+//
+// For very wide schematics the rows above and below a number are far apart
+// in memory, so walking all numbers row by row evicts them before the next
+// row reuses them. The tiled scan splits the columns into tiles and walks
+// every row inside one tile before moving on, so the row triple around the
+// current number stays cached. A number belongs to the tile it starts in;
+// its neighbourhood check may read a few columns into the next tile.
+
+#define TILED_DEFAULT_TILE_WIDTH (4096)
+
+// numbers must be in row-major order, as produced by the parser
+bool try_summing_part_numbers_tiled(const number_t* numbers,
+                                    size_t numbers_cnt,
+                                    const char** matrix,
+                                    uint32_t matrix_number_of_rows,
+                                    uint32_t matrix_number_of_cols,
+                                    uint32_t tile_width,
+                                    uint64_t* number_sum);
+
+#endif
@@ -0,0 +1,141 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "width_kernels.h"
+
+// Definitions
+// ################################################
+
+#define INITIAL_ALLOCATED_ROWS (64)
+
+// Same classification as is_symbol of the character grid, without branches
+#define IS_SYMBOL(c) ((unsigned char)((c) - '0') > 9 && (c) != '.' && (c) != '\n' && (c) != ' ' && (c) != '\0')
+
+// Kernels
+// ################################################
+
+// Inlined into every kernel below, where stride is a constant
+static inline bool has_adjacent_symbol_at_stride(const char* first_cell, size_t stride, uint8_t length) {
+
+    // Rows above, of and below the number, starting one cell left of it
+    const char* above = first_cell - stride - 1;
+    const char* row = first_cell - 1;
+    const char* below = first_cell + stride - 1;
+
+    switch(length) {
+        case 1:
+            return IS_SYMBOL(above[0]) | IS_SYMBOL(above[1]) | IS_SYMBOL(above[2])
+                 | IS_SYMBOL(row[0]) | IS_SYMBOL(row[2])
+                 | IS_SYMBOL(below[0]) | IS_SYMBOL(below[1]) | IS_SYMBOL(below[2]);
+        case 2:
+            return IS_SYMBOL(above[0]) | IS_SYMBOL(above[1]) | IS_SYMBOL(above[2]) | IS_SYMBOL(above[3])
+                 | IS_SYMBOL(row[0]) | IS_SYMBOL(row[3])
+                 | IS_SYMBOL(below[0]) | IS_SYMBOL(below[1]) | IS_SYMBOL(below[2]) | IS_SYMBOL(below[3]);
+        case 3:
+            return IS_SYMBOL(above[0]) | IS_SYMBOL(above[1]) | IS_SYMBOL(above[2]) | IS_SYMBOL(above[3])
+                 | IS_SYMBOL(above[4])
+                 | IS_SYMBOL(row[0]) | IS_SYMBOL(row[4])
+                 | IS_SYMBOL(below[0]) | IS_SYMBOL(below[1]) | IS_SYMBOL(below[2]) | IS_SYMBOL(below[3])
+                 | IS_SYMBOL(below[4]);
+        default:
+            if(IS_SYMBOL(row[0]) || IS_SYMBOL(row[length + 1])) {
+                return true;
+            }
+            for(size_t i=0; i<(size_t)length + 2; ++i) {
+                if(IS_SYMBOL(above[i]) || IS_SYMBOL(below[i])) {
+                    return true;
+                }
+            }
+            return false;
+    }
+}
+
+static inline void classify_numbers_at_stride(const char* cells, size_t stride,
+                                              const number_t* numbers, size_t numbers_cnt, bool* is_valid) {
+    for(size_t i=0; i<numbers_cnt; ++i) {
+        const char* first_cell = cells + ((size_t)numbers[i].pos.y + 1) * stride + (size_t)numbers[i].pos.x + 1;
+        is_valid[i] = has_adjacent_symbol_at_stride(first_cell, stride, numbers[i].length);
+    }
+}
+
+// One kernel per line length (incl. '\n'), the stride is fixed at compile time
+#define DEFINE_WIDTH_KERNEL(cols) \
+    static void classify_numbers_##cols(const padded_grid_t* grid, const number_t* numbers, \
+                                        size_t numbers_cnt, bool* is_valid) { \
+        classify_numbers_at_stride(grid->cells, (size_t)(cols) + 2, numbers, numbers_cnt, is_valid); \
+    }
+
+// The example schematic and the 140 column puzzle inputs
+DEFINE_WIDTH_KERNEL(11)
+DEFINE_WIDTH_KERNEL(141)
+
+typedef struct {
+    uint32_t number_of_cols;
+    width_kernel_t kernel;
+} width_kernel_entry_t;
+
+static const width_kernel_entry_t WIDTH_KERNELS[] = {
+    {11, classify_numbers_11},
+    {141, classify_numbers_141},
+};
+
+#define WIDTH_KERNELS_CNT (sizeof(WIDTH_KERNELS) / sizeof(WIDTH_KERNELS[0]))
+
+width_kernel_t find_width_kernel(uint32_t number_of_cols) {
+    for(size_t i=0; i<WIDTH_KERNELS_CNT; ++i) {
+        if(WIDTH_KERNELS[i].number_of_cols == number_of_cols) {
+            return WIDTH_KERNELS[i].kernel;
+        }
+    }
+    return NULL;
+}
+
+// Padded Grid
+// ################################################
+
+bool try_initializing_padded_grid(padded_grid_t* grid, uint32_t number_of_cols) {
+
+    grid->number_of_rows = 0;
+    grid->number_of_cols = number_of_cols;
+    grid->stride = (size_t)number_of_cols + 2;
+    grid->allocated_rows = INITIAL_ALLOCATED_ROWS;
+    grid->cells = malloc(grid->allocated_rows * grid->stride);
+    if(grid->cells == NULL) {
+        fprintf(stderr, "Error allocating memory for padded grid\n");
+        return false;
+    }
+    // Top border and the bottom border of the still empty grid
+    memset(grid->cells, '.', 2 * grid->stride);
+    return true;
+}
+
+bool try_appending_padded_row(padded_grid_t* grid, const char* line) {
+
+    // The row goes where the bottom border is, which moves one row down
+    if((size_t)grid->number_of_rows + 3 > grid->allocated_rows) {
+        size_t allocated_rows = grid->allocated_rows * 2;
+        char* grown_cells = realloc(grid->cells, allocated_rows * grid->stride);
+        if(grown_cells == NULL) {
+            fprintf(stderr, "Error allocating memory for padded grid row %u\n", grid->number_of_rows);
+            return false;
+        }
+        grid->cells = grown_cells;
+        grid->allocated_rows = allocated_rows;
+    }
+    char* row = grid->cells + ((size_t)grid->number_of_rows + 1) * grid->stride;
+    memcpy(row + 1, line, grid->number_of_cols);
+    row[grid->stride - 1] = '.';
+    memset(row + grid->stride, '.', grid->stride);
+    grid->number_of_rows++;
+    return true;
+}
+
+void destroy_padded_grid(padded_grid_t* grid) {
+    free(grid->cells);
+    grid->cells = NULL;
+}
+
+size_t padded_grid_bytes(const padded_grid_t* grid) {
+    return grid->allocated_rows * grid->stride;
+}
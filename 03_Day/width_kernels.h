@@ -0,0 +1,46 @@
+#ifndef DAY03_WIDTH_KERNELS_H
+#define DAY03_WIDTH_KERNELS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "schematic.h"
+
+// Width-Specialised Kernels
+// ################################################
+//
+// Most schematics come in a few fixed widths. For those the rows are kept in
+// one buffer with a border of '.' around them, so a number's neighbours are
+// at fixed offsets from its first cell and need no bounds checks. Each known
+// width gets its own kernel with the row stride as a compile-time constant
+// and the offsets of the usual number lengths unrolled; find_width_kernel
+// picks it when the first line is read. Other widths keep the row matrix and
+// the generic has_adjacent_symbol check.
+
+typedef struct {
+    char* cells;                // (number_of_rows + 2) * stride, border cells are '.'
+    uint32_t number_of_rows;
+    uint32_t number_of_cols;    // Line length incl. '\n', as in the row matrix
+    size_t stride;              // number_of_cols + 2
+    size_t allocated_rows;      // Incl. both border rows
+} padded_grid_t;
+
+// Sets is_valid[i] if numbers[i] touches a symbol
+typedef void (*width_kernel_t)(const padded_grid_t* grid, const number_t* numbers, size_t numbers_cnt, bool* is_valid);
+
+// Kernel specialised for the line length, NULL if there is none
+width_kernel_t find_width_kernel(uint32_t number_of_cols);
+
+bool try_initializing_padded_grid(padded_grid_t* grid, uint32_t number_of_cols);
+// line must have exactly number_of_cols characters
+bool try_appending_padded_row(padded_grid_t* grid, const char* line);
+void destroy_padded_grid(padded_grid_t* grid);
+size_t padded_grid_bytes(const padded_grid_t* grid);
+
+// Cell (x, y) of the schematic, without the border
+static inline const char* padded_cell(const padded_grid_t* grid, uint32_t x, uint32_t y) {
+    return grid->cells + ((size_t)y + 1) * grid->stride + x + 1;
+}
+
+#endif
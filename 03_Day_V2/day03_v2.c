@@ -0,0 +1,421 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>   // int64_t
+#include <unistd.h>     // ssize_t
+#include <errno.h>      // errno
+#include <ctype.h>      // isdigit
+#include <stdbool.h>    // bool
+#include <regex.h>      // regex
+
+#include "input.h"
+#include "input_stream.h"
+#include "mem_stats.h"
+#include "solver.h"
+#include "swar.h"
+#include "day03_v2.h"
+
+// Debugging
+// ################################################
+
+#define DEBUG (0)
+#define DEBUG_LEVEL (0) // Everything below this level will be printed (incl. this level)
+#ifdef DEBUG
+    #define DEBUG_START(level) if (DEBUG_LEVEL >= (level)) {
+    #define DEBUG_END }
+#else
+    #define DEBUG_START(level) if(0) {
+    #define DEBUG_END }
+#endif
+
+// Definitions
+// ################################################
+
+#define SOLVER_VERSION (2)
+
+// Structs, Typedefs, Enums and Global Variables
+// ################################################
+
+typedef struct {
+    int16_t x;
+    int16_t y;
+} position_t;
+
+typedef struct {
+    int16_t value;
+    uint8_t length;
+    position_t pos;
+} number_t;
+
+// Function Prototypes
+// ################################################
+
+// AoC Functions
+static bool decrypt_riddle_value(void* state,
+                                 const solver_options_t* options,
+                                 const char* input,
+                                 size_t input_size,
+                                 solver_result_t* result);
+static bool decrypt_riddle_value_lines(void* state,
+                                       const solver_options_t* options,
+                                       line_reader_t* reader,
+                                       solver_result_t* result);
+static bool is_digit(const char *c);
+static bool is_symbol(const char *c);
+static bool has_adjacent_symbol(const number_t* number, 
+                                const char** matrix, 
+                                const uint8_t matrix_number_of_rows, 
+                                const uint8_t matrix_number_of_cols);
+static bool position_is_in_bounds(const position_t* pos, 
+                                  const uint8_t max_x_pos, 
+                                  const uint8_t max_y_pos);
+
+const solver_t DAY03_V2_SOLVER = {
+    .name = "03_V2",
+    .directory = "03_Day_V2",
+    .default_input = "input_big.txt",
+    .version = SOLVER_VERSION,
+    .init = NULL,
+    .solve = decrypt_riddle_value,
+    .solve_lines = decrypt_riddle_value_lines,
+    .destroy = NULL
+};
+
+// AoC Functions
+// ################################################
+
+static bool is_digit(const char* c) {
+    
+    if(c == NULL) {
+        return false;
+    }
+
+    if(*c == '\0') {
+        return false;
+    }
+
+    if((*c >= '0') && (*c <= '9')) {
+        return true;
+    }
+
+    return false;
+}
+
+static bool is_symbol(const char* c) {
+    
+    if(c == NULL) {
+        return false;
+    }
+
+    if(*c == '\0') {
+        return false;
+    }
+
+    // '.': empty cell
+    if(!is_digit(c) && (*c != '.') && (*c != '\n') && (*c != ' ')) {
+        return true;
+    }
+
+    return false;
+}
+
+static bool position_is_in_bounds(const position_t* pos, 
+                                  const uint8_t max_x_pos, 
+                                  const uint8_t max_y_pos) {
+
+    if(pos == NULL) {
+        return false;
+    }
+
+    if((pos->x < 0) || (pos->x > (max_x_pos-1))) {
+        return false;
+    }
+
+    if((pos->y < 0) || (pos->y > (max_y_pos-1))) {
+        return false;
+    }
+
+    return true;
+}
+
+static bool has_adjacent_symbol(const number_t* number, 
+                                const char** matrix, 
+                                const uint8_t matrix_number_of_rows, 
+                                const uint8_t matrix_number_of_cols) {
+
+    position_t pos_to_check = {0, 0};
+
+    // Check above (including diagonals)
+    pos_to_check.y = number->pos.y-1;
+    if(pos_to_check.y > 0) {
+        for(int8_t i=-1; i<=number->length; ++i) {
+            pos_to_check.x = number->pos.x+i;
+            if(position_is_in_bounds(&pos_to_check, matrix_number_of_cols, matrix_number_of_rows)) {
+                if(is_symbol(&matrix[pos_to_check.y][pos_to_check.x])) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    // Check below (including diagonals)
+    pos_to_check.y = number->pos.y+1;
+    if(pos_to_check.y < matrix_number_of_rows) {
+        for(int8_t i=-1; i<=number->length; ++i) {
+            pos_to_check.x = number->pos.x+i;
+            if(position_is_in_bounds(&pos_to_check, matrix_number_of_cols, matrix_number_of_rows)) {
+                if(is_symbol(&matrix[pos_to_check.y][pos_to_check.x])) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    // Check left
+    pos_to_check.x = number->pos.x-1;
+    pos_to_check.y = number->pos.y;
+    if(position_is_in_bounds(&pos_to_check, matrix_number_of_cols, matrix_number_of_rows)) {
+        if(is_symbol(&matrix[pos_to_check.y][pos_to_check.x])) {
+            return true;
+        }
+    }
+
+    // Check right
+    pos_to_check.x = number->pos.x+number->length;
+    pos_to_check.y = number->pos.y;
+    if(position_is_in_bounds(&pos_to_check, matrix_number_of_cols, matrix_number_of_rows)) {
+        if(is_symbol(&matrix[pos_to_check.y][pos_to_check.x])) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool decrypt_riddle_value(void* state,
+                                 const solver_options_t* options,
+                                 const char* input,
+                                 size_t input_size,
+                                 solver_result_t* result) {
+
+    line_reader_t reader;
+    init_buffer_line_reader(&reader, input, input_size);
+    return decrypt_riddle_value_lines(state, options, &reader, result);
+}
+
+static bool decrypt_riddle_value_lines(void* state,
+                                       const solver_options_t* options,
+                                       line_reader_t* reader,
+                                       solver_result_t* result) {
+
+    // Cleanup struct with bitfield
+    struct cleanup {
+        bool matrix_allocated: 1;
+        bool numbers_allocated: 1;
+        bool valid_numbers_allocated: 1;
+        bool invalid_numbers_allocated: 1;
+        bool successful: 1;
+    } cleanup = {
+        .matrix_allocated = false,
+        .numbers_allocated = false,
+        .valid_numbers_allocated = false,
+        .invalid_numbers_allocated = false,
+        .successful = false
+    };
+
+    // Declared up front, so every goto below reaches the cleanup with initialized pointers
+    uint64_t number_sum = 0;
+    number_t* valid_numbers = NULL;
+    number_t* invalid_numbers = NULL;
+
+    // Read input line by line and create 2D array of its values
+    number_t* numbers = NULL;
+    uint16_t numbers_cnt = 0;
+    cleanup.numbers_allocated = true;
+
+    char** matrix = NULL;
+    uint8_t matrix_number_of_rows = 0;
+    uint8_t matrix_number_of_cols = 0;
+    uint8_t matrix_allocated_number_of_rows = 0;
+    uint8_t allocation_growth = 32; // Number of additional rows to be allocated, if needed
+    uint8_t allocated_blocks[32];
+    uint8_t allocated_blocks_cnt = 0;
+    cleanup.matrix_allocated = true;
+
+    const char* line = NULL;
+    size_t read_bytes = 0;
+
+    while(read_line(reader, &line, &read_bytes)) {
+
+        // Test if the input text is well formed
+        if(matrix_number_of_cols != 0) {
+            if(read_bytes/sizeof(char) != matrix_number_of_cols) {
+                fprintf(stderr, "Error: Line %d has different length than previous lines\n", matrix_number_of_rows);
+                goto cleanup;
+            }
+        } else {
+            matrix_number_of_cols = read_bytes/sizeof(char);
+        }
+
+        // Copy line into matrix
+        if(matrix_number_of_rows >= matrix_allocated_number_of_rows) {
+            // Reallocate the array of pointers
+            // temp matrix is used, so that if realloc fails, the original matrix is not lost and can be freed
+            char **temp_matrix = (char**)realloc(matrix, (matrix_number_of_rows + allocation_growth) * sizeof(char*));
+            if(temp_matrix == NULL) {
+                fprintf(stderr, "Error reallocating memory for matrix pointers\n");
+                goto cleanup;
+            }
+            matrix = temp_matrix;
+            matrix_allocated_number_of_rows += allocation_growth;
+
+            // Allocate new rows in a contiguous block
+            char *new_rows = (char*)malloc(allocation_growth * matrix_number_of_cols * sizeof(char));
+            if(new_rows == NULL) {
+                fprintf(stderr, "Error allocating memory for new rows\n");
+                goto cleanup;
+            }
+            allocated_blocks[allocated_blocks_cnt] = matrix_number_of_rows;
+            allocated_blocks_cnt++;
+
+            // Assign new row pointers to the appropriate locations in the new block
+            for(int i = 0; i < allocation_growth; ++i) {
+                matrix[matrix_number_of_rows+i] = new_rows + i*matrix_number_of_cols;
+            }
+        }
+        memcpy(matrix[matrix_number_of_rows], line, read_bytes);
+        matrix_number_of_rows++;
+
+        // Put number into list, each digit run is parsed in one go
+        for(uint8_t i=0; i<read_bytes; ++i) {
+            if(!is_digit(&line[i])) {
+                continue;
+            }
+            uint64_t value;
+            size_t length;
+            if(!swar_try_parsing_uint(&line[i], read_bytes - i, INT16_MAX, &value, &length)) {
+                fprintf(stderr, "Error: Number at row %d col %d does not fit into 16 bits\n", matrix_number_of_rows-1, i);
+                goto cleanup;
+            }
+            numbers = realloc(numbers, (numbers_cnt+1) * sizeof(number_t));
+            numbers[numbers_cnt].length = length;
+            numbers[numbers_cnt].pos.x = i;
+            numbers[numbers_cnt].pos.y = matrix_number_of_rows-1; // -1 because we already incremented the row counter
+            numbers[numbers_cnt].value = value;
+            numbers_cnt++;
+
+            // Skip the rest of the digit run
+            i += length - 1;
+        }
+    }
+
+    DEBUG_START(1) // #region DEBUG: Print results of parsing
+    fprintf(stdout, "Parsed numbers: %d\n", numbers_cnt);
+    fprintf(stdout, "Matrix number of rows: %d\n", matrix_number_of_rows);
+    fprintf(stdout, "Matrix number of cols: %d\n", matrix_number_of_cols);
+    fprintf(stdout, "\n");
+    DEBUG_END // #endregion
+
+    DEBUG_START(2) // #region DEBUG: Print numbers and matrix
+
+    // Print numbers list
+    for(size_t i=0; i<numbers_cnt; i++) {
+        fprintf(stdout, "%4ld. x: %3d, y: %3d, value: %3d, length: %d\n", 
+            i+1, numbers[i].pos.x, numbers[i].pos.y, numbers[i].value, numbers[i].length);
+    }
+    fprintf(stdout, "\n");
+
+    // Print matrix
+    fprintf(stdout, "Matrix:\n");
+    for(size_t i=0; i<matrix_number_of_rows-1; i++) {
+        fprintf(stdout, "%s", matrix[i]);
+    }
+    fprintf(stdout, "\n");
+    fprintf(stdout, "\n");
+    DEBUG_END // #endregion
+
+    // Find numbers with adjacent symbols (normal or diagonal)
+    uint16_t valid_numbers_cnt = 0;
+    uint16_t invalid_numbers_cnt = 0;
+    cleanup.valid_numbers_allocated = true;
+    cleanup.invalid_numbers_allocated = true;
+    for(size_t i=0; i<numbers_cnt; i++) {
+        if(has_adjacent_symbol(&numbers[i], (const char**)matrix, matrix_number_of_rows, matrix_number_of_cols)) {
+            DEBUG_START(1)
+            valid_numbers = realloc(valid_numbers, (valid_numbers_cnt+1) * sizeof(number_t));
+            valid_numbers[valid_numbers_cnt] = numbers[i];
+            valid_numbers_cnt++;
+            DEBUG_END
+            number_sum += numbers[i].value;
+        } else {
+            DEBUG_START(1)
+            invalid_numbers = realloc(invalid_numbers, (invalid_numbers_cnt+1) * sizeof(number_t));
+            invalid_numbers[invalid_numbers_cnt] = numbers[i];
+            invalid_numbers_cnt++;
+            DEBUG_END
+        }
+    }
+
+    DEBUG_START(1) // #region DEBUG: Print results of parsing
+    fprintf(stdout, "Valid numbers: %d\n", valid_numbers_cnt);
+    fprintf(stdout, "Invalid numbers: %d\n", invalid_numbers_cnt);
+    fprintf(stdout, "Number sum: %ld\n", number_sum);
+    fprintf(stdout, "\n");
+    DEBUG_END // #endregion
+
+    DEBUG_START(2) // #region DEBUG: Print valid and invalid numbers
+    
+    // Print valid numbers list
+    fprintf(stdout, "Valid numbers:\n");
+    for(size_t i=0; i<valid_numbers_cnt; i++) {
+        fprintf(stdout, "%4ld. x: %3d, y: %3d, value: %3d, length: %d\n", 
+            i+1, valid_numbers[i].pos.x, valid_numbers[i].pos.y, valid_numbers[i].value, valid_numbers[i].length);
+    }
+    fprintf(stdout, "\n");
+
+    // Print invalid numbers list
+    fprintf(stdout, "Invalid numbers:\n");
+    for(size_t i=0; i<invalid_numbers_cnt; i++) {
+        fprintf(stdout, "%4ld. x: %3d, y: %3d, value: %3d, length: %d\n", 
+            i+1, invalid_numbers[i].pos.x, invalid_numbers[i].pos.y, invalid_numbers[i].value, invalid_numbers[i].length);
+    }
+    fprintf(stdout, "\n");
+    DEBUG_END // #endregion
+
+    // Footprint of the parsed input, reported in the end banner
+    mem_stats_record("matrix rows", (size_t)matrix_allocated_number_of_rows * (matrix_number_of_cols + sizeof(char*)));
+    mem_stats_record("numbers", numbers_cnt * sizeof(number_t));
+
+    result->part_one = (int64_t)number_sum;
+    result->has_part_two = false;
+    cleanup.successful = true;
+
+    cleanup:
+    if(cleanup.matrix_allocated) {
+        if(matrix != NULL) {
+            for(int i = 0; i < allocated_blocks_cnt; ++i) {
+                if(matrix[allocated_blocks[i]] != NULL) {
+                    free(matrix[allocated_blocks[i]]);
+                }
+            }
+            free(matrix);
+        }
+    }
+    if(cleanup.numbers_allocated) {
+        if(numbers != NULL) {
+            free(numbers);
+        }
+    }
+    if(cleanup.valid_numbers_allocated) {
+        if(valid_numbers != NULL) {
+            free(valid_numbers);
+        }
+    }
+    if(cleanup.invalid_numbers_allocated) {
+        if(invalid_numbers != NULL) {
+            free(invalid_numbers);
+        }
+    }
+
+    return cleanup.successful;
+}
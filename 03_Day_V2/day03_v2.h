@@ -0,0 +1,8 @@
+#ifndef DAY03_V2_SOLVER_H
+#define DAY03_V2_SOLVER_H
+
+#include "solver.h"
+
+extern const solver_t DAY03_V2_SOLVER;
+
+#endif
@@ -0,0 +1,287 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>   // int64_t
+#include <stdbool.h>    // bool
+
+#include "arena.h"
+#include "input_stream.h"
+#include "scheduler.h"
+#include "solver.h"
+#include "swar.h"
+#include "dayXX.h"
+
+// Day Template
+// ################################################
+//
+// Copied by new_day.sh, which replaces XX with the day number and registers
+// the solver with the runner and the benchmark. The placeholder puzzle sums
+// all numbers (part one) and the largest number of every line (part two);
+// replace decode_line and line_result_t, the plumbing around them is done:
+// buffered and compressed inputs, the result cache, -j chunks on the
+// work-stealing scheduler and a warm arena per solver state.
+
+// Debugging
+// ################################################
+
+#define DEBUG (0)
+#define DEBUG_LEVEL (1) // Everything below this level will be printed (incl. this level)
+#ifdef DEBUG
+    #define DEBUG_START(level) if (DEBUG_LEVEL >= (level)) {
+    #define DEBUG_END }
+#else
+    #define DEBUG_START(level) if(0) {
+    #define DEBUG_END }
+#endif
+
+// Definitions
+// ################################################
+
+// Bump when results may change, so cached results are not reused
+#define SOLVER_VERSION (1)
+
+// Parallel mode: newline aligned chunks of about this size are the scheduler's items
+// (unless options->chunk_size is set, see -j auto)
+#define DEFAULT_CHUNK_SIZE (64 * 1024)
+
+// Structs, Typedefs, Enums and Global Variables
+// ################################################
+
+// Reused across inputs, see try_initializing_state
+typedef struct {
+    arena_t arena;      // Scratch for per-line allocations, reset after every input
+} solver_state_t;
+
+// Contribution of one line, also the partial result of the parallel mode
+// (all-zero is the empty result)
+typedef struct {
+    uint64_t part_one;
+    uint64_t part_two;
+} line_result_t;
+
+// Chunk i of the parallel mode spans [bounds[i], bounds[i+1])
+typedef struct {
+    const char** bounds;
+} chunk_list_t;
+
+// Function Prototypes
+// ################################################
+
+// AoC Functions
+static bool try_initializing_state(void** state);
+static void destroy_state(void* state);
+static bool decrypt_riddle_value(void* state,
+                                 const solver_options_t* options,
+                                 const char* input,
+                                 size_t input_size,
+                                 solver_result_t* result);
+static bool decrypt_riddle_value_lines(void* state,
+                                       const solver_options_t* options,
+                                       line_reader_t* reader,
+                                       solver_result_t* result);
+static bool decode_line(const char* line, size_t line_len, line_result_t* line_result);
+static bool try_decrypting_parallel(const char* input, size_t input_size, const solver_options_t* options,
+                                    line_result_t* total);
+
+const solver_t DAYXX_SOLVER = {
+    .name = "XX",
+    .directory = "XX_Day",
+    .default_input = "input_small.txt",
+    .version = SOLVER_VERSION,
+    .init = try_initializing_state,
+    .solve = decrypt_riddle_value,
+    .solve_lines = decrypt_riddle_value_lines,
+    .destroy = destroy_state,
+    .supports_threads = true
+};
+
+// ################################################
+
+static bool try_initializing_state(void** state) {
+
+    solver_state_t* solver_state = malloc(sizeof(solver_state_t));
+    if(solver_state == NULL) {
+        perror("Error allocating memory for solver state");
+        return false;
+    }
+    init_arena(&solver_state->arena, ARENA_DEFAULT_BLOCK_SIZE);
+    *state = solver_state;
+    return true;
+}
+
+static void destroy_state(void* state) {
+
+    solver_state_t* solver_state = (solver_state_t*)state;
+    if(solver_state == NULL) {
+        return;
+    }
+    destroy_arena(&solver_state->arena);
+    free(solver_state);
+}
+
+// AoC Functions
+// ################################################
+
+static bool decrypt_riddle_value(void* state,
+                                 const solver_options_t* options,
+                                 const char* input,
+                                 size_t input_size,
+                                 solver_result_t* result) {
+
+    if(options->thread_cnt <= 1) {
+        line_reader_t reader;
+        init_buffer_line_reader(&reader, input, input_size);
+        return decrypt_riddle_value_lines(state, options, &reader, result);
+    }
+
+    line_result_t total;
+    if(!try_decrypting_parallel(input, input_size, options, &total)) {
+        return false;
+    }
+    result->part_one = (int64_t)total.part_one;
+    result->part_two = (int64_t)total.part_two;
+    result->has_part_two = true;
+    return true;
+}
+
+// Streamed inputs cannot be split up front, so they are always decoded serially
+static bool decrypt_riddle_value_lines(void* state,
+                                       const solver_options_t* options,
+                                       line_reader_t* reader,
+                                       solver_result_t* result) {
+
+    solver_state_t* solver_state = (solver_state_t*)state;
+    line_result_t total = {0, 0};
+    bool successful = true;
+
+    const char* line = NULL;
+    size_t line_len = 0;
+    size_t line_number = 0;
+    while(read_line(reader, &line, &line_len)) {
+        line_number++;
+        line_result_t line_result;
+        if(!decode_line(line, line_len, &line_result)) {
+            fprintf(stderr, "Error in line %zu\n", line_number);
+            successful = false;
+            break;
+        }
+
+        DEBUG_START(2)
+        fprintf(stdout, "%5zu. (%" PRIu64 ", %" PRIu64 "): %.*s",
+            line_number, line_result.part_one, line_result.part_two, (int)line_len, line);
+        DEBUG_END
+
+        total.part_one += line_result.part_one;
+        total.part_two += line_result.part_two;
+    }
+    reset_arena(&solver_state->arena);
+
+    if(!successful) {
+        return false;
+    }
+    result->part_one = (int64_t)total.part_one;
+    result->part_two = (int64_t)total.part_two;
+    result->has_part_two = true;
+    return true;
+}
+
+// Line kernel shared by the serial and the parallel path, the line may end in '\n'
+static bool decode_line(const char* line, size_t line_len, line_result_t* line_result) {
+
+    line_result->part_one = 0;
+    line_result->part_two = 0;
+    for(size_t i=0; i<line_len; ++i) {
+        if(line[i] < '0' || line[i] > '9') {
+            continue;
+        }
+        uint64_t value;
+        size_t consumed;
+        if(!swar_try_parsing_uint(&line[i], line_len - i, UINT32_MAX, &value, &consumed)) {
+            fprintf(stderr, "Error: Number at column %zu does not fit into 32 bits\n", i);
+            return false;
+        }
+        line_result->part_one += value;
+        if(value > line_result->part_two) {
+            line_result->part_two = value;
+        }
+        i += consumed - 1;
+    }
+    return true;
+}
+
+// Parallel Mode
+// ################################################
+
+static bool decrypt_chunks(void* context, size_t begin, size_t end, void* partial) {
+
+    const chunk_list_t* chunks = (const chunk_list_t*)context;
+    line_result_t* chunk_result = (line_result_t*)partial;
+
+    for(size_t chunk=begin; chunk<end; ++chunk) {
+        const char* line = chunks->bounds[chunk];
+        const char* chunk_end = chunks->bounds[chunk+1];
+        while(line < chunk_end) {
+            const char* newline = memchr(line, '\n', (size_t)(chunk_end - line));
+            const char* line_end = (newline != NULL) ? newline + 1 : chunk_end;
+            line_result_t line_result;
+            if(!decode_line(line, (size_t)(line_end - line), &line_result)) {
+                return false;
+            }
+            chunk_result->part_one += line_result.part_one;
+            chunk_result->part_two += line_result.part_two;
+            line = line_end;
+        }
+    }
+    return true;
+}
+
+static void combine_line_results(void* into, const void* from) {
+    line_result_t* into_result = (line_result_t*)into;
+    const line_result_t* from_result = (const line_result_t*)from;
+    into_result->part_one += from_result->part_one;
+    into_result->part_two += from_result->part_two;
+}
+
+static bool try_decrypting_parallel(const char* input, size_t input_size, const solver_options_t* options,
+                                    line_result_t* total) {
+
+    total->part_one = 0;
+    total->part_two = 0;
+    if(input_size == 0) {
+        return true;
+    }
+
+    // Split at newline boundaries, so every line belongs to exactly one chunk
+    size_t chunk_size = (options->chunk_size > 0) ? options->chunk_size : DEFAULT_CHUNK_SIZE;
+    size_t max_chunks_cnt = input_size / chunk_size + 1;
+    chunk_list_t chunks = {malloc((max_chunks_cnt + 1) * sizeof(const char*))};
+    if(chunks.bounds == NULL) {
+        perror("Error allocating memory for chunks");
+        return false;
+    }
+    const char* input_end = input + input_size;
+    size_t chunks_cnt = 0;
+    chunks.bounds[0] = input;
+    while(chunks.bounds[chunks_cnt] < input_end) {
+        const char* chunk_end;
+        if((size_t)(input_end - chunks.bounds[chunks_cnt]) <= chunk_size) {
+            chunk_end = input_end;
+        } else {
+            chunk_end = chunks.bounds[chunks_cnt] + chunk_size;
+            const char* newline = memchr(chunk_end, '\n', (size_t)(input_end - chunk_end));
+            chunk_end = (newline != NULL) ? newline + 1 : input_end;
+        }
+        chunks.bounds[++chunks_cnt] = chunk_end;
+    }
+
+    scheduler_t* scheduler;
+    if(!try_creating_scheduler(options->thread_cnt, options->placement, &scheduler)) {
+        free(chunks.bounds);
+        return false;
+    }
+    bool successful = parallel_reduce(scheduler, chunks_cnt, SCHEDULER_AUTO_GRAIN, decrypt_chunks, &chunks,
+                                      sizeof(line_result_t), combine_line_results, total);
+    destroy_scheduler(scheduler);
+    free(chunks.bounds);
+    return successful;
+}
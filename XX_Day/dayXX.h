@@ -0,0 +1,8 @@
+#ifndef DAYXX_SOLVER_H
+#define DAYXX_SOLVER_H
+
+#include "solver.h"
+
+extern const solver_t DAYXX_SOLVER;
+
+#endif
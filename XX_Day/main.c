@@ -1,12 +1,10 @@
-#include <stdio.h>
 #include <stdlib.h>
 
+#include "cli.h"
+#include "dayXX.h"
 
-int main (int argc, char* argv[]) {
-
-    printf("Hello World");
+// ################################################
 
-    int a = 4;
-
-    return EXIT_SUCCESS;
+int main (int argc, char* argv[]) {
+    return run_solver_main(argc, argv, &DAYXX_SOLVER);
 }
@@ -0,0 +1,40 @@
+#!/bin/sh
+# Creates DAY_Day from this template and registers it with the runner and
+# the benchmark, e.g. "XX_Day/new_day.sh 04".
+set -eu
+
+if [ $# -ne 1 ] || ! printf '%s' "$1" | grep -Eq '^[0-9]{2}$'; then
+    echo "Usage: $0 DAY (two digits, e.g. 04)" >&2
+    exit 1
+fi
+DAY=$1
+
+ROOT_DIR=$(cd "$(dirname "$0")/.." && pwd)
+TEMPLATE_DIR="$ROOT_DIR/XX_Day"
+DAY_DIR="$ROOT_DIR/${DAY}_Day"
+if [ -e "$DAY_DIR" ]; then
+    echo "Error: $DAY_DIR already exists" >&2
+    exit 1
+fi
+
+# Day sources, XX becomes the day number
+mkdir -p "$DAY_DIR"
+for file in Makefile main.c dayXX.c dayXX.h input_small.txt; do
+    target=$(printf '%s' "$file" | sed "s/XX/$DAY/g")
+    sed "s/XX/$DAY/g" "$TEMPLATE_DIR/$file" > "$DAY_DIR/$target"
+done
+cp -r "$TEMPLATE_DIR/.vscode" "$DAY_DIR/"
+
+# Runner: registry entry and objects
+last_include=$(grep -n '^#include "day' "$ROOT_DIR/runner/registry.c" | tail -n 1 | cut -d: -f1)
+sed -i "${last_include}a #include \"day$DAY.h\"" "$ROOT_DIR/runner/registry.c"
+sed -i "0,/^};/s//    \&DAY${DAY}_SOLVER,\n};/" "$ROOT_DIR/runner/registry.c"
+sed -i "s|^DAY_DIRS = .*|& ../${DAY}_Day|" "$ROOT_DIR/runner/Makefile"
+sed -i "s|^DAY_OBJECTS = .*|& ../${DAY}_Day/day$DAY.o|" "$ROOT_DIR/runner/Makefile"
+
+# Benchmark: optimised sources and one matrix entry
+sed -i "s|^DAY_DIRS = .*|& ../${DAY}_Day|" "$ROOT_DIR/bench/Makefile"
+sed -i "s|^          ../runner/registry.c|          ../${DAY}_Day/day$DAY.c \\\\\n&|" "$ROOT_DIR/bench/Makefile"
+printf '%-6s %-7s %-2s %s\n' "$DAY" "-" "1" "${DAY}_Day/input_small.txt" >> "$ROOT_DIR/bench/matrix.txt"
+
+echo "Created ${DAY}_Day, registered as solver \"$DAY\" in runner/ and bench/"
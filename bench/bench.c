@@ -0,0 +1,518 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>   // int64_t
+#include <unistd.h>     // getopt, dup
+#include <fcntl.h>      // open
+#include <stdbool.h>    // bool
+
+#include "solver.h"
+#include "utils.h"
+#include "mem_stats.h"
+#include "registry.h"
+
+// Definitions
+// ################################################
+
+#define BENCH_OPTSTRING "r:w:o:b:t:"
+#define ROOT_DIR_ENV "AOC_ROOT"
+#define DEFAULT_ROOT_DIR ".."
+#define DEFAULT_REPETITIONS (11)
+#define DEFAULT_WARMUPS (2)
+#define DEFAULT_TOLERANCE_PERCENT (15.0)
+// A slowdown must also exceed this many MADs and this absolute time to count
+#define NOISE_MAD_FACTOR (3.0)
+#define NOISE_FLOOR_US (50.0)
+#define MAX_NAME_LEN (256)
+
+// Structs, Typedefs, Enums and Global Variables
+// ################################################
+
+typedef struct {
+    char name[MAX_NAME_LEN];    // day/mode/input/jthreads, the key in the JSON files
+    size_t solver_index;
+    char* mode;                 // NULL = default
+    size_t thread_cnt;
+    char* input_file_name;
+    double min_us;
+    double median_us;
+    double mad_us;              // Median absolute deviation
+    double* samples;
+    // Memory of one solve: peak RSS (never below what the bench process holds anyway)
+    // and the largest size seen per structure
+    int64_t peak_rss_bytes;
+    size_t structures_cnt;
+    const char* structure_names[MEM_STATS_MAX_ENTRIES];
+    size_t structure_bytes[MEM_STATS_MAX_ENTRIES];
+} bench_entry_t;
+
+typedef struct {
+    bench_entry_t* entries;
+    size_t entries_cnt;
+} bench_matrix_t;
+
+// Function Prototypes
+// ################################################
+
+static void print_usage(const char* program_name);
+static bool try_reading_matrix(const char* file_name, bench_matrix_t* matrix);
+static bool try_running_matrix(bench_matrix_t* matrix, const bool* selected, size_t warmups, size_t repetitions);
+static bool try_writing_results(const char* file_name, const bench_matrix_t* matrix);
+static bool try_checking_baseline(const char* file_name, bench_matrix_t* matrix, double tolerance_percent,
+                                  size_t warmups, size_t repetitions);
+static void free_matrix(bench_matrix_t* matrix);
+
+// Main
+// ################################################
+
+int main(int argc, char* argv[]) {
+
+    size_t repetitions = DEFAULT_REPETITIONS;
+    size_t warmups = DEFAULT_WARMUPS;
+    const char* results_file_name = NULL;
+    const char* baseline_file_name = NULL;
+    double tolerance_percent = DEFAULT_TOLERANCE_PERCENT;
+
+    int option;
+    while((option = getopt(argc, argv, BENCH_OPTSTRING)) != -1) {
+        switch(option) {
+            case 'r':
+                repetitions = strtoul(optarg, NULL, 10);
+                break;
+            case 'w':
+                warmups = strtoul(optarg, NULL, 10);
+                break;
+            case 'o':
+                results_file_name = optarg;
+                break;
+            case 'b':
+                baseline_file_name = optarg;
+                break;
+            case 't':
+                tolerance_percent = strtod(optarg, NULL);
+                break;
+            default:
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if(optind != argc-1 || repetitions == 0 || tolerance_percent < 0.0) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    bench_matrix_t matrix = {NULL, 0};
+    if(!try_reading_matrix(argv[optind], &matrix)) {
+        free_matrix(&matrix);
+        return EXIT_FAILURE;
+    }
+
+    bool failure = !try_running_matrix(&matrix, NULL, warmups, repetitions);
+    if(!failure && baseline_file_name != NULL) {
+        failure = !try_checking_baseline(baseline_file_name, &matrix, tolerance_percent, warmups, repetitions);
+    }
+    destroy_solver_states();
+
+    // Results are written even if the check failed, to inspect them
+    if(results_file_name != NULL && matrix.entries_cnt > 0 && matrix.entries[0].samples != NULL) {
+        failure = !try_writing_results(results_file_name, &matrix) || failure;
+    }
+
+    free_matrix(&matrix);
+    return failure ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// Helper Functions
+// ################################################
+
+static void print_usage(const char* program_name) {
+    fprintf(stderr, "Usage: %s [options] matrix_file\n", program_name);
+    fprintf(stderr, "  -r n        Timed repetitions per benchmark (default %d)\n", DEFAULT_REPETITIONS);
+    fprintf(stderr, "  -w n        Untimed warm-up runs per benchmark (default %d)\n", DEFAULT_WARMUPS);
+    fprintf(stderr, "  -o file     Write the results as JSON\n");
+    fprintf(stderr, "  -b file     Compare against a baseline JSON, fail on a slowdown\n");
+    fprintf(stderr, "  -t percent  Allowed slowdown of median and min (default %.0f)\n", DEFAULT_TOLERANCE_PERCENT);
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Sorts values in place
+static double median(double* values, size_t values_cnt) {
+    qsort(values, values_cnt, sizeof(double), compare_doubles);
+    if(values_cnt % 2 == 1) {
+        return values[values_cnt / 2];
+    }
+    return (values[values_cnt / 2 - 1] + values[values_cnt / 2]) / 2.0;
+}
+
+static char* join_root(const char* relative_path) {
+    if(relative_path[0] == '/') {
+        return strdup(relative_path);
+    }
+    const char* root_dir = getenv(ROOT_DIR_ENV);
+    if(root_dir == NULL || *root_dir == '\0') {
+        root_dir = DEFAULT_ROOT_DIR;
+    }
+    size_t path_len = strlen(root_dir) + strlen(relative_path) + 2;
+    char* path = malloc(path_len);
+    if(path != NULL) {
+        snprintf(path, path_len, "%s/%s", root_dir, relative_path);
+    }
+    return path;
+}
+
+// Bench Functions
+// ################################################
+
+static bool try_reading_matrix(const char* file_name, bench_matrix_t* matrix) {
+
+    FILE* file;
+    if(!try_opening_file(file_name, &file)) {
+        return false;
+    }
+
+    // One "DAY MODE THREADS INPUT" per line, MODE "-" selects the default mode
+    bool successful = true;
+    char* line = NULL;
+    size_t line_size = 0;
+    size_t line_number = 0;
+    while(getline(&line, &line_size, file) != -1) {
+        line_number++;
+        char* rest = line;
+        char* day = strtok_r(line, " \t\r\n", &rest);
+        if(day == NULL || day[0] == '#') {
+            continue;
+        }
+        char* mode = strtok_r(NULL, " \t\r\n", &rest);
+        char* threads = strtok_r(NULL, " \t\r\n", &rest);
+        char* input_file_name = strtok_r(NULL, " \t\r\n", &rest);
+        long solver_index = find_solver(day);
+        if(input_file_name == NULL || solver_index < 0 || strtoul(threads, NULL, 10) == 0) {
+            fprintf(stderr, "Error in matrix file %s at line %zu\n", file_name, line_number);
+            successful = false;
+            break;
+        }
+
+        bench_entry_t* entries = realloc(matrix->entries, (matrix->entries_cnt+1) * sizeof(bench_entry_t));
+        if(entries == NULL) {
+            perror("Error allocating memory for benchmark");
+            successful = false;
+            break;
+        }
+        matrix->entries = entries;
+        bench_entry_t* entry = &matrix->entries[matrix->entries_cnt];
+        memset(entry, 0, sizeof(*entry));
+        entry->solver_index = (size_t)solver_index;
+        entry->thread_cnt = strtoul(threads, NULL, 10);
+        entry->mode = (strcmp(mode, "-") != 0) ? strdup(mode) : NULL;
+        entry->input_file_name = join_root(input_file_name);
+        matrix->entries_cnt++;
+        if(entry->input_file_name == NULL || (strcmp(mode, "-") != 0 && entry->mode == NULL)) {
+            perror("Error allocating memory for benchmark");
+            successful = false;
+            break;
+        }
+        snprintf(entry->name, sizeof(entry->name), "%s/%s/%s/j%zu", day, mode, input_file_name, entry->thread_cnt);
+    }
+
+    free(line);
+    fclose(file);
+    return successful;
+}
+
+static bool try_solving_entry(bench_entry_t* entry, int64_t* elapsed) {
+
+    const solver_t* solver = SOLVER_REGISTRY[entry->solver_index];
+    void* state = NULL;
+    if(!try_getting_solver_state(entry->solver_index, &state)) {
+        return false;
+    }
+    solver_options_t options = SOLVER_OPTIONS_DEFAULT;
+    options.thread_cnt = entry->thread_cnt;
+    options.mode = entry->mode;
+
+    solver_result_t result;
+    bool cache_hit;
+    mem_stats_reset();
+    int64_t start = micros();
+    bool solved = try_solving_file(solver, state, &options, entry->input_file_name, &result, &cache_hit);
+    *elapsed = micros() - start;
+    if(!solved) {
+        fprintf(stderr, "Error: Benchmark %s failed\n", entry->name);
+        return false;
+    }
+
+    int64_t peak = peak_rss_bytes();
+    if(peak > entry->peak_rss_bytes) {
+        entry->peak_rss_bytes = peak;
+    }
+    const char* name;
+    size_t bytes;
+    for(size_t i=0; mem_stats_entry(i, &name, &bytes); ++i) {
+        size_t s = 0;
+        while(s < entry->structures_cnt && strcmp(entry->structure_names[s], name) != 0) {
+            s++;
+        }
+        if(s == entry->structures_cnt) {
+            entry->structure_names[s] = name;
+            entry->structure_bytes[s] = 0;
+            entry->structures_cnt++;
+        }
+        if(bytes > entry->structure_bytes[s]) {
+            entry->structure_bytes[s] = bytes;
+        }
+    }
+    return true;
+}
+
+static void summarize_samples(bench_entry_t* entry, size_t repetitions) {
+    double* deviations = entry->samples + repetitions;
+    entry->median_us = median(entry->samples, repetitions);
+    entry->min_us = entry->samples[0];
+    for(size_t i=0; i<repetitions; ++i) {
+        double sample = entry->samples[i];
+        deviations[i] = sample > entry->median_us ? sample - entry->median_us : entry->median_us - sample;
+    }
+    entry->mad_us = median(deviations, repetitions);
+}
+
+// Runs the selected entries (all if selected is NULL) round-robin, one solve per
+// entry and round, so a slow phase of the machine hits every entry alike
+static bool try_running_matrix(bench_matrix_t* matrix, const bool* selected, size_t warmups, size_t repetitions) {
+
+    for(size_t i=0; i<matrix->entries_cnt; ++i) {
+        if(matrix->entries[i].samples == NULL) {
+            // Second half holds the deviations for the MAD
+            matrix->entries[i].samples = malloc(2 * repetitions * sizeof(double));
+            if(matrix->entries[i].samples == NULL) {
+                perror("Error allocating memory for samples");
+                return false;
+            }
+        }
+    }
+
+    // Solver debug output would end up in the measurement table, silence it
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+    int null_fd = open("/dev/null", O_WRONLY);
+    if(saved_stdout == -1 || null_fd == -1) {
+        perror("Error redirecting stdout");
+        return false;
+    }
+    dup2(null_fd, STDOUT_FILENO);
+    close(null_fd);
+
+    bool successful = true;
+    for(size_t round=0; round<warmups+repetitions && successful; ++round) {
+        for(size_t i=0; i<matrix->entries_cnt && successful; ++i) {
+            if(selected != NULL && !selected[i]) {
+                continue;
+            }
+            int64_t elapsed = 0;
+            successful = try_solving_entry(&matrix->entries[i], &elapsed);
+            if(successful && round >= warmups) {
+                matrix->entries[i].samples[round - warmups] = (double)elapsed;
+            }
+        }
+    }
+
+    fflush(stdout);
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(saved_stdout);
+    if(!successful) {
+        return false;
+    }
+
+    printf("%-48s %12s %12s %12s\n", "benchmark", "min [us]", "median [us]", "mad [us]");
+    for(size_t i=0; i<matrix->entries_cnt; ++i) {
+        bench_entry_t* entry = &matrix->entries[i];
+        if(selected != NULL && !selected[i]) {
+            continue;
+        }
+        summarize_samples(entry, repetitions);
+        printf("%-48s %12.1f %12.1f %12.1f\n", entry->name, entry->min_us, entry->median_us, entry->mad_us);
+    }
+    return true;
+}
+
+static bool try_writing_results(const char* file_name, const bench_matrix_t* matrix) {
+
+    FILE* file = fopen(file_name, "w");
+    if(file == NULL) {
+        perror("Error opening results file");
+        return false;
+    }
+
+    // One benchmark per line, so try_checking_baseline can read it back without a JSON parser
+    fprintf(file, "{\n  \"benchmarks\": [\n");
+    for(size_t i=0; i<matrix->entries_cnt; ++i) {
+        const bench_entry_t* entry = &matrix->entries[i];
+        fprintf(file, "    {\"name\": \"%s\", \"min_us\": %.1f, \"median_us\": %.1f, \"mad_us\": %.1f, "
+                      "\"peak_rss_kib\": %ld, \"memory_bytes\": {",
+                entry->name, entry->min_us, entry->median_us, entry->mad_us, (long)(entry->peak_rss_bytes / 1024));
+        for(size_t s=0; s<entry->structures_cnt; ++s) {
+            fprintf(file, "%s\"%s\": %zu", (s > 0) ? ", " : "", entry->structure_names[s], entry->structure_bytes[s]);
+        }
+        fprintf(file, "}}%s\n", (i+1 < matrix->entries_cnt) ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+
+    if(fclose(file) != 0) {
+        perror("Error writing results file");
+        return false;
+    }
+    return true;
+}
+
+static bool try_reading_baseline_field(const char* line, const char* key, double* value) {
+    const char* field = strstr(line, key);
+    if(field == NULL) {
+        return false;
+    }
+    char* end;
+    *value = strtod(field + strlen(key), &end);
+    return end != field + strlen(key);
+}
+
+// Slower than the tolerance in median and min, clearly outside the noise of both runs and not just a few us
+static bool is_regression(const bench_entry_t* entry, const bench_entry_t* base, double tolerance_percent) {
+    double factor = 1.0 + tolerance_percent / 100.0;
+    double slowdown = entry->median_us - base->median_us;
+    double noise = NOISE_MAD_FACTOR * (base->mad_us > entry->mad_us ? base->mad_us : entry->mad_us);
+    return entry->median_us > base->median_us * factor
+        && entry->min_us > base->min_us * factor
+        && slowdown > noise
+        && slowdown > NOISE_FLOOR_US;
+}
+
+static bool try_reading_baseline(const char* file_name, const bench_matrix_t* matrix,
+                                 bench_entry_t* baseline, bool* has_baseline) {
+
+    FILE* file;
+    if(!try_opening_file(file_name, &file)) {
+        return false;
+    }
+
+    char* line = NULL;
+    size_t line_size = 0;
+    while(getline(&line, &line_size, file) != -1) {
+        const char* name_start = strstr(line, "\"name\": \"");
+        if(name_start == NULL) {
+            continue;
+        }
+        name_start += strlen("\"name\": \"");
+        const char* name_end = strchr(name_start, '"');
+        bench_entry_t base;
+        if(name_end == NULL
+        || !try_reading_baseline_field(line, "\"min_us\": ", &base.min_us)
+        || !try_reading_baseline_field(line, "\"median_us\": ", &base.median_us)
+        || !try_reading_baseline_field(line, "\"mad_us\": ", &base.mad_us)) {
+            continue;
+        }
+        size_t name_len = (size_t)(name_end - name_start);
+        for(size_t i=0; i<matrix->entries_cnt; ++i) {
+            if(strlen(matrix->entries[i].name) == name_len
+            && strncmp(matrix->entries[i].name, name_start, name_len) == 0) {
+                baseline[i] = base;
+                has_baseline[i] = true;
+                break;
+            }
+        }
+    }
+    free(line);
+    fclose(file);
+    return true;
+}
+
+static bool try_checking_baseline(const char* file_name, bench_matrix_t* matrix, double tolerance_percent,
+                                  size_t warmups, size_t repetitions) {
+
+    bench_entry_t* baseline = calloc(matrix->entries_cnt, sizeof(bench_entry_t));
+    bool* has_baseline = calloc(matrix->entries_cnt, sizeof(bool));
+    bool* suspects = calloc(matrix->entries_cnt, sizeof(bool));
+    if(baseline == NULL || has_baseline == NULL || suspects == NULL) {
+        perror("Error allocating memory for baseline");
+        free(baseline);
+        free(has_baseline);
+        free(suspects);
+        return false;
+    }
+    bool successful = try_reading_baseline(file_name, matrix, baseline, has_baseline);
+
+    // Suspected regressions are measured once more, only a slowdown that shows up
+    // in both runs counts (the faster run is kept)
+    size_t suspects_cnt = 0;
+    for(size_t i=0; i<matrix->entries_cnt && successful; ++i) {
+        suspects[i] = has_baseline[i] && is_regression(&matrix->entries[i], &baseline[i], tolerance_percent);
+        suspects_cnt += suspects[i] ? 1 : 0;
+    }
+    if(suspects_cnt > 0 && successful) {
+        printf("\nRe-measuring %zu suspected regression(s)\n", suspects_cnt);
+        bench_entry_t* first_runs = malloc(matrix->entries_cnt * sizeof(bench_entry_t));
+        successful = first_runs != NULL;
+        if(successful) {
+            memcpy(first_runs, matrix->entries, matrix->entries_cnt * sizeof(bench_entry_t));
+            successful = try_running_matrix(matrix, suspects, warmups, repetitions);
+        }
+        for(size_t i=0; i<matrix->entries_cnt && successful; ++i) {
+            if(suspects[i] && first_runs[i].median_us < matrix->entries[i].median_us) {
+                matrix->entries[i].min_us = first_runs[i].min_us;
+                matrix->entries[i].median_us = first_runs[i].median_us;
+                matrix->entries[i].mad_us = first_runs[i].mad_us;
+            }
+        }
+        free(first_runs);
+    }
+
+    size_t regressions_cnt = 0;
+    size_t missing_cnt = 0;
+    if(successful) {
+        printf("\n%-48s %12s %12s %9s  %s\n", "benchmark", "base [us]", "now [us]", "change", "verdict");
+    }
+    for(size_t i=0; i<matrix->entries_cnt && successful; ++i) {
+        const bench_entry_t* entry = &matrix->entries[i];
+        if(!has_baseline[i]) {
+            printf("%-48s %12s %12.1f %9s  %s\n", entry->name, "-", entry->median_us, "", "no baseline");
+            missing_cnt++;
+            continue;
+        }
+        bool regressed = is_regression(entry, &baseline[i], tolerance_percent);
+        double change_percent = (baseline[i].median_us > 0.0)
+            ? 100.0 * (entry->median_us - baseline[i].median_us) / baseline[i].median_us
+            : 0.0;
+        printf("%-48s %12.1f %12.1f %+8.1f%%  %s\n", entry->name, baseline[i].median_us, entry->median_us,
+               change_percent, regressed ? "REGRESSION" : "ok");
+        regressions_cnt += regressed ? 1 : 0;
+    }
+
+    if(successful && missing_cnt > 0) {
+        printf("%zu benchmark(s) have no baseline yet (run make bench-baseline)\n", missing_cnt);
+    }
+    if(successful && regressions_cnt > 0) {
+        printf("%zu regression(s) over %.0f%% (and %.0fx MAD, %.0f us)\n",
+               regressions_cnt, tolerance_percent, NOISE_MAD_FACTOR, NOISE_FLOOR_US);
+        successful = false;
+    } else if(successful) {
+        printf("No regressions\n");
+    }
+
+    free(baseline);
+    free(has_baseline);
+    free(suspects);
+    return successful;
+}
+
+static void free_matrix(bench_matrix_t* matrix) {
+    for(size_t i=0; i<matrix->entries_cnt; ++i) {
+        free(matrix->entries[i].mode);
+        free(matrix->entries[i].input_file_name);
+        free(matrix->entries[i].samples);
+    }
+    free(matrix->entries);
+    matrix->entries = NULL;
+    matrix->entries_cnt = 0;
+}
@@ -0,0 +1,136 @@
+// The solver is compiled into this file, so its static kernels can be timed
+#include "day01.c"
+
+#include "microbench.h"
+
+// Day 01 Kernels
+// ################################################
+
+static void* setup_lines(const char* root_dir, micro_work_t* work) {
+
+    micro_lines_t* lines = malloc(sizeof(micro_lines_t));
+    if(lines == NULL) {
+        perror("Error allocating memory for micro benchmark");
+        return NULL;
+    }
+    if(!try_loading_micro_lines(root_dir, "01_Day/input_big_letters.txt", lines)) {
+        free(lines);
+        return NULL;
+    }
+    work->calls = lines->lines_cnt;
+    work->bytes = lines->input.size;
+    return lines;
+}
+
+// isWrittenDigit is called at every position a scan passes
+static void* setup_positions(const char* root_dir, micro_work_t* work) {
+    micro_lines_t* lines = setup_lines(root_dir, work);
+    if(lines != NULL) {
+        work->calls = lines->input.size;
+    }
+    return lines;
+}
+
+static void teardown_lines(void* context) {
+    release_micro_lines((micro_lines_t*)context);
+    free(context);
+}
+
+static uint64_t run_is_written_digit(void* context) {
+    const micro_lines_t* lines = (const micro_lines_t*)context;
+    uint64_t checksum = 0;
+    for(size_t i=0; i<lines->lines_cnt; ++i) {
+        const char* line = lines->lines[i];
+        ssize_t read_bytes = (ssize_t)lines->line_lens[i];
+        for(ssize_t j=0; j<read_bytes; ++j) {
+            uint8_t word_length = (read_bytes-1-j) < 7 ? (uint8_t)(read_bytes-1-j) : 7;
+            checksum += isWrittenDigit(&line[j], word_length);
+        }
+    }
+    return checksum;
+}
+
+// First and last digit of both parts in one decode
+static uint64_t run_decode_line(void* context) {
+    const micro_lines_t* lines = (const micro_lines_t*)context;
+    uint64_t checksum = 0;
+    for(size_t i=0; i<lines->lines_cnt; ++i) {
+        line_digits_t digits;
+        if(decode_line(lines->lines[i], (ssize_t)lines->line_lens[i], &digits) == LINE_OK) {
+            checksum += (uint64_t)(digits.first_any_digit * 10 + digits.last_any_digit);
+        }
+    }
+    return checksum;
+}
+
+// Reference: the first/last digit scan before the SWAR and fused decode
+// changes, with strtoul reading the whole digit run and dividing it down
+static line_status_t decode_line_strtoul(const char* line, ssize_t read_bytes,
+                                         ssize_t* first_digit_in_line, ssize_t* last_digit_in_line) {
+
+    // Get first digit in line
+    *first_digit_in_line = -1;
+    *last_digit_in_line = -1;
+    for(ssize_t i=0; i<read_bytes; ++i) {
+        if(isdigit(line[i])) {
+            errno = 0;
+            *first_digit_in_line = (ssize_t)strtoul(&line[i], NULL, 10);
+            if(errno != 0) {
+                return LINE_CONVERSION_ERROR;
+            }
+            while(*first_digit_in_line >= 10) {
+                *first_digit_in_line /= 10;
+            }
+            break;
+        }
+        uint8_t word_length = (read_bytes-1-i) < 7 ? (uint8_t)(read_bytes-1-i) : 7;
+        uint8_t written_digit = isWrittenDigit(&line[i], word_length);
+        if(written_digit) {
+            *first_digit_in_line = written_digit;
+            break;
+        }
+    }
+    if(*first_digit_in_line == -1) {
+        return LINE_NO_DIGIT;
+    }
+
+    // Get last digit in line
+    for(ssize_t i=read_bytes-1; i>=0; --i) {
+        if(isdigit(line[i])) {
+            errno = 0;
+            *last_digit_in_line = (ssize_t)strtoul(&line[i], NULL, 10);
+            if(errno != 0) {
+                return LINE_CONVERSION_ERROR;
+            }
+            break;
+        }
+        uint8_t word_length = (read_bytes-1-i < 7) ? (uint8_t)(read_bytes-1-i) : 7;
+        uint8_t written_digit = isWrittenDigit(&line[i], word_length);
+        if(written_digit) {
+            *last_digit_in_line = written_digit;
+            break;
+        }
+    }
+    return LINE_OK;
+}
+
+static uint64_t run_decode_line_strtoul(void* context) {
+    const micro_lines_t* lines = (const micro_lines_t*)context;
+    uint64_t checksum = 0;
+    for(size_t i=0; i<lines->lines_cnt; ++i) {
+        ssize_t first_digit_in_line, last_digit_in_line;
+        if(decode_line_strtoul(lines->lines[i], (ssize_t)lines->line_lens[i],
+                               &first_digit_in_line, &last_digit_in_line) == LINE_OK) {
+            checksum += (uint64_t)(first_digit_in_line * 10 + last_digit_in_line);
+        }
+    }
+    return checksum;
+}
+
+const micro_case_t MICRO_DAY01_CASES[] = {
+    {"01 written digit", "isWrittenDigit", setup_positions, run_is_written_digit, teardown_lines},
+    {"01 digit scan", "strtoul scan (reference)", setup_lines, run_decode_line_strtoul, teardown_lines},
+    {"01 digit scan", "decode_line (fused)", setup_lines, run_decode_line, teardown_lines},
+};
+
+const size_t MICRO_DAY01_CASES_CNT = sizeof(MICRO_DAY01_CASES) / sizeof(MICRO_DAY01_CASES[0]);
@@ -0,0 +1,123 @@
+// The solver is compiled into this file, so its static kernels can be timed
+#include "day02.c"
+
+#include "microbench.h"
+
+// Day 02 Kernels
+// ################################################
+
+// try_splitting_rounds tokenizes in place, so every pass starts from fresh copies
+typedef struct {
+    micro_lines_t lines;
+    char* line_copy;
+    size_t line_capacity;
+    solver_state_t* solver_state;
+} rounds_context_t;
+
+static void teardown_rounds(void* context) {
+    rounds_context_t* rounds_context = (rounds_context_t*)context;
+    if(rounds_context->solver_state != NULL) {
+        destroy_state(rounds_context->solver_state);
+    }
+    free(rounds_context->line_copy);
+    release_micro_lines(&rounds_context->lines);
+    free(rounds_context);
+}
+
+static void* setup_rounds(const char* root_dir, micro_work_t* work) {
+
+    rounds_context_t* rounds_context = calloc(1, sizeof(rounds_context_t));
+    if(rounds_context == NULL) {
+        perror("Error allocating memory for micro benchmark");
+        return NULL;
+    }
+    if(!try_loading_micro_lines(root_dir, "02_Day/input_big.txt", &rounds_context->lines)) {
+        free(rounds_context);
+        return NULL;
+    }
+    for(size_t i=0; i<rounds_context->lines.lines_cnt; ++i) {
+        if(rounds_context->lines.line_lens[i] + 1 > rounds_context->line_capacity) {
+            rounds_context->line_capacity = rounds_context->lines.line_lens[i] + 1;
+        }
+    }
+    void* state = NULL;
+    rounds_context->line_copy = malloc(rounds_context->line_capacity > 0 ? rounds_context->line_capacity : 1);
+    if(rounds_context->line_copy == NULL || !try_initializing_state(&state)) {
+        fprintf(stderr, "Error setting up the round parser\n");
+        teardown_rounds(rounds_context);
+        return NULL;
+    }
+    rounds_context->solver_state = (solver_state_t*)state;
+    work->calls = rounds_context->lines.lines_cnt;
+    work->bytes = rounds_context->lines.input.size;
+    return rounds_context;
+}
+
+// Reference: the dice count parse before the SWAR change, strtoul on the regex match
+static bool try_parsing_rounds_strtoul(size_t* round_cnt, round_t* rounds, regex_t* regexes, size_t* max_number_of_dice) {
+
+    for(size_t round_index=0; round_index<*round_cnt; ++round_index) {
+        round_t* round = &rounds[round_index];
+        round->number_of_dice[RED] = 0;
+        round->number_of_dice[GREEN] = 0;
+        round->number_of_dice[BLUE] = 0;
+        for(int color_index=0; color_index<COLOR_CNT; ++color_index) {
+            regex_t* regex = &regexes[color_index];
+            regmatch_t match_pos[1];
+            if(regexec(regex, round->round_string, 1, match_pos, 0) == 0) {
+                size_t parsed_dice_amount = strtoul(&round->round_string[(size_t)match_pos[0].rm_so], NULL, 10);
+                if(parsed_dice_amount > 0 && parsed_dice_amount <= MAX_DICE_COUNT) {
+                    round->number_of_dice[color_index] = parsed_dice_amount;
+                    if(parsed_dice_amount > max_number_of_dice[color_index]) {
+                        max_number_of_dice[color_index] = parsed_dice_amount;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+typedef bool (*round_parser_t)(size_t* round_cnt, round_t* rounds, regex_t* regexes, size_t* max_number_of_dice);
+
+// parser NULL: only split
+static uint64_t run_rounds(rounds_context_t* rounds_context, round_parser_t parser) {
+
+    uint64_t checksum = 0;
+    for(size_t i=0; i<rounds_context->lines.lines_cnt; ++i) {
+        size_t line_len = rounds_context->lines.line_lens[i];
+        memcpy(rounds_context->line_copy, rounds_context->lines.lines[i], line_len);
+        rounds_context->line_copy[line_len] = '\0';
+
+        size_t round_cnt = 0;
+        round_t* rounds = NULL;
+        size_t max_number_of_dice[COLOR_CNT] = {0, 0, 0};
+        if(try_splitting_rounds(rounds_context->line_copy, &round_cnt, &rounds, &rounds_context->solver_state->arena)
+        && (parser == NULL || parser(&round_cnt, rounds, rounds_context->solver_state->regexes, max_number_of_dice))) {
+            checksum += round_cnt + max_number_of_dice[RED] + max_number_of_dice[GREEN] + max_number_of_dice[BLUE];
+        }
+        free(rounds);
+    }
+    reset_arena(&rounds_context->solver_state->arena);
+    return checksum;
+}
+
+static uint64_t run_splitting_rounds(void* context) {
+    return run_rounds((rounds_context_t*)context, NULL);
+}
+
+static uint64_t run_splitting_and_parsing_rounds_strtoul(void* context) {
+    return run_rounds((rounds_context_t*)context, try_parsing_rounds_strtoul);
+}
+
+static uint64_t run_splitting_and_parsing_rounds(void* context) {
+    return run_rounds((rounds_context_t*)context, try_parsing_rounds);
+}
+
+const micro_case_t MICRO_DAY02_CASES[] = {
+    {"02 rounds", "try_splitting_rounds", setup_rounds, run_splitting_rounds, teardown_rounds},
+    {"02 rounds", "+ strtoul parse (reference)", setup_rounds, run_splitting_and_parsing_rounds_strtoul, teardown_rounds},
+    {"02 rounds", "+ try_parsing_rounds (SWAR)", setup_rounds, run_splitting_and_parsing_rounds, teardown_rounds},
+};
+
+const size_t MICRO_DAY02_CASES_CNT = sizeof(MICRO_DAY02_CASES) / sizeof(MICRO_DAY02_CASES[0]);
@@ -0,0 +1,206 @@
+// The solver is compiled into this file, so its static kernels can be timed
+#include "day03.c"
+
+#include "microbench.h"
+
+// Day 03 Kernels
+// ################################################
+
+// The schematic in every representation the adjacency kernels work on
+typedef struct {
+    micro_lines_t lines;
+    char** matrix;
+    uint32_t number_of_rows;
+    uint32_t number_of_cols;
+    number_t* numbers;
+    size_t numbers_cnt;
+    size_t neighbours_cnt;      // Cells around all numbers, incl. the out of bounds ones
+    packed_grid_t packed_grid;
+    bool packed_grid_initialized;
+    padded_grid_t padded_grid;
+    bool padded_grid_initialized;
+    width_kernel_t width_kernel;
+    bool* is_valid;
+} schematic_context_t;
+
+static void teardown_schematic(void* context) {
+
+    schematic_context_t* schematic = (schematic_context_t*)context;
+    for(uint32_t i=0; i<schematic->number_of_rows && schematic->matrix != NULL; ++i) {
+        free(schematic->matrix[i]);
+    }
+    free(schematic->matrix);
+    free(schematic->numbers);
+    free(schematic->is_valid);
+    if(schematic->packed_grid_initialized) {
+        destroy_packed_grid(&schematic->packed_grid);
+    }
+    if(schematic->padded_grid_initialized) {
+        destroy_padded_grid(&schematic->padded_grid);
+    }
+    release_micro_lines(&schematic->lines);
+    free(schematic);
+}
+
+static bool try_adding_row(schematic_context_t* schematic, const char* line, size_t line_len) {
+
+    // Rows are cut or padded to the first line's length, like a well formed schematic
+    char* row = malloc(schematic->number_of_cols);
+    if(row == NULL) {
+        return false;
+    }
+    size_t copied = line_len < schematic->number_of_cols ? line_len : schematic->number_of_cols;
+    memcpy(row, line, copied);
+    memset(row + copied, '\n', schematic->number_of_cols - copied);
+    schematic->matrix[schematic->number_of_rows] = row;
+    uint32_t y = schematic->number_of_rows++;
+
+    for(uint32_t x=0; x<schematic->number_of_cols; ++x) {
+        if(!is_digit(&row[x])) {
+            continue;
+        }
+        uint64_t value;
+        size_t length;
+        swar_try_parsing_uint(&row[x], schematic->number_of_cols - x, INT32_MAX, &value, &length);
+        number_t* number = &schematic->numbers[schematic->numbers_cnt++];
+        number->value = (int32_t)value;
+        number->length = (uint8_t)length;
+        number->pos.x = (int32_t)x;
+        number->pos.y = (int32_t)y;
+        schematic->neighbours_cnt += 2 * (length + 2) + 2;
+        x += (uint32_t)length - 1;
+    }
+    return try_appending_packed_row(&schematic->packed_grid, row)
+        && try_appending_padded_row(&schematic->padded_grid, row);
+}
+
+static void* setup_schematic(const char* root_dir, micro_work_t* work) {
+
+    schematic_context_t* schematic = calloc(1, sizeof(schematic_context_t));
+    if(schematic == NULL) {
+        perror("Error allocating memory for micro benchmark");
+        return NULL;
+    }
+    if(!try_loading_micro_lines(root_dir, "03_Day/input_big.txt", &schematic->lines)) {
+        free(schematic);
+        return NULL;
+    }
+    if(schematic->lines.lines_cnt == 0) {
+        fprintf(stderr, "Error: Empty schematic\n");
+        teardown_schematic(schematic);
+        return NULL;
+    }
+
+    schematic->number_of_cols = (uint32_t)schematic->lines.line_lens[0];
+    schematic->width_kernel = find_width_kernel(schematic->number_of_cols);
+    schematic->matrix = calloc(schematic->lines.lines_cnt, sizeof(char*));
+    // A number takes at least two cells with its separator
+    schematic->numbers = malloc((schematic->lines.input.size / 2 + 1) * sizeof(number_t));
+    schematic->is_valid = malloc((schematic->lines.input.size / 2 + 1) * sizeof(bool));
+    if(schematic->width_kernel == NULL || schematic->matrix == NULL || schematic->numbers == NULL
+    || schematic->is_valid == NULL) {
+        fprintf(stderr, "Error setting up the schematic (no width kernel for %u columns?)\n", schematic->number_of_cols);
+        teardown_schematic(schematic);
+        return NULL;
+    }
+    init_packed_grid(&schematic->packed_grid, schematic->number_of_cols);
+    schematic->packed_grid_initialized = true;
+    schematic->padded_grid_initialized = try_initializing_padded_grid(&schematic->padded_grid, schematic->number_of_cols);
+    bool successful = schematic->packed_grid_initialized && schematic->padded_grid_initialized;
+    for(size_t i=0; i<schematic->lines.lines_cnt && successful; ++i) {
+        successful = try_adding_row(schematic, schematic->lines.lines[i], schematic->lines.line_lens[i]);
+    }
+    if(!successful) {
+        fprintf(stderr, "Error building the schematic\n");
+        teardown_schematic(schematic);
+        return NULL;
+    }
+
+    work->calls = schematic->numbers_cnt;
+    work->bytes = (size_t)schematic->number_of_rows * schematic->number_of_cols;
+    return schematic;
+}
+
+static void* setup_cells(const char* root_dir, micro_work_t* work) {
+    void* context = setup_schematic(root_dir, work);
+    work->calls = work->bytes;
+    return context;
+}
+
+static void* setup_neighbours(const char* root_dir, micro_work_t* work) {
+    schematic_context_t* schematic = setup_schematic(root_dir, work);
+    if(schematic != NULL) {
+        work->calls = schematic->neighbours_cnt;
+        work->bytes = 0;
+    }
+    return schematic;
+}
+
+static uint64_t run_is_symbol(void* context) {
+    const schematic_context_t* schematic = (const schematic_context_t*)context;
+    uint64_t checksum = 0;
+    for(uint32_t y=0; y<schematic->number_of_rows; ++y) {
+        for(uint32_t x=0; x<schematic->number_of_cols; ++x) {
+            checksum += is_symbol(&schematic->matrix[y][x]);
+        }
+    }
+    return checksum;
+}
+
+// Every cell has_adjacent_symbol checks, without reading the cells
+static uint64_t run_position_is_in_bounds(void* context) {
+    const schematic_context_t* schematic = (const schematic_context_t*)context;
+    uint64_t checksum = 0;
+    for(size_t i=0; i<schematic->numbers_cnt; ++i) {
+        const number_t* number = &schematic->numbers[i];
+        for(int32_t dy=-1; dy<=1; ++dy) {
+            for(int32_t dx=-1; dx<=number->length; ++dx) {
+                if(dy == 0 && dx >= 0 && dx < number->length) {
+                    continue;
+                }
+                position_t pos = {number->pos.x + dx, number->pos.y + dy};
+                checksum += position_is_in_bounds(&pos, schematic->number_of_cols, schematic->number_of_rows);
+            }
+        }
+    }
+    return checksum;
+}
+
+static uint64_t run_has_adjacent_symbol(void* context) {
+    const schematic_context_t* schematic = (const schematic_context_t*)context;
+    uint64_t checksum = 0;
+    for(size_t i=0; i<schematic->numbers_cnt; ++i) {
+        checksum += has_adjacent_symbol(&schematic->numbers[i], (const char**)schematic->matrix,
+                                        schematic->number_of_rows, schematic->number_of_cols);
+    }
+    return checksum;
+}
+
+static uint64_t run_packed_has_adjacent_symbol(void* context) {
+    const schematic_context_t* schematic = (const schematic_context_t*)context;
+    uint64_t checksum = 0;
+    for(size_t i=0; i<schematic->numbers_cnt; ++i) {
+        checksum += packed_has_adjacent_symbol(&schematic->packed_grid, &schematic->numbers[i]);
+    }
+    return checksum;
+}
+
+static uint64_t run_width_kernel(void* context) {
+    schematic_context_t* schematic = (schematic_context_t*)context;
+    schematic->width_kernel(&schematic->padded_grid, schematic->numbers, schematic->numbers_cnt, schematic->is_valid);
+    uint64_t checksum = 0;
+    for(size_t i=0; i<schematic->numbers_cnt; ++i) {
+        checksum += schematic->is_valid[i];
+    }
+    return checksum;
+}
+
+const micro_case_t MICRO_DAY03_CASES[] = {
+    {"03 cell class", "is_symbol", setup_cells, run_is_symbol, teardown_schematic},
+    {"03 bounds", "position_is_in_bounds", setup_neighbours, run_position_is_in_bounds, teardown_schematic},
+    {"03 adjacency", "has_adjacent_symbol", setup_schematic, run_has_adjacent_symbol, teardown_schematic},
+    {"03 adjacency", "packed_has_adjacent_symbol", setup_schematic, run_packed_has_adjacent_symbol, teardown_schematic},
+    {"03 adjacency", "width kernel (141 columns)", setup_schematic, run_width_kernel, teardown_schematic},
+};
+
+const size_t MICRO_DAY03_CASES_CNT = sizeof(MICRO_DAY03_CASES) / sizeof(MICRO_DAY03_CASES[0]);
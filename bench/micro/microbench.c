@@ -0,0 +1,299 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>   // PRIu64
+#include <unistd.h>     // getopt
+#include <time.h>       // clock_gettime
+#include <stdbool.h>    // bool
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>  // __rdtsc
+#define HAVE_CYCLE_COUNTER (1)
+#endif
+
+#include "placement.h"
+#include "microbench.h"
+
+// Definitions
+// ################################################
+
+#define MICRO_OPTSTRING "s:f:"
+#define ROOT_DIR_ENV "AOC_ROOT"
+#define DEFAULT_ROOT_DIR ".."
+#define DEFAULT_SAMPLES (15)
+// Warm samples repeat the pass until a sample takes at least this long
+#define MIN_WARM_SAMPLE_NS (2000000.0)
+// Larger than any last level cache: writing it evicts the prepared inputs
+#define EVICTION_BUFFER_SIZE (64 * 1024 * 1024)
+#define CACHE_LINE_SIZE (64)
+
+typedef struct {
+    const micro_case_t* cases;
+    const size_t* cases_cnt;
+} micro_suite_t;
+
+static const micro_suite_t SUITES[] = {
+    {MICRO_DAY01_CASES, &MICRO_DAY01_CASES_CNT},
+    {MICRO_DAY02_CASES, &MICRO_DAY02_CASES_CNT},
+    {MICRO_DAY03_CASES, &MICRO_DAY03_CASES_CNT},
+};
+
+#define SUITES_CNT (sizeof(SUITES) / sizeof(SUITES[0]))
+
+// Per-pass cost of one variant: median and median absolute deviation
+typedef struct {
+    double ns;
+    double cycles;
+    double mad_ns;
+} pass_cost_t;
+
+// Volatile sink for the checksums of all passes
+static volatile uint64_t checksum_sink;
+
+// Function Prototypes
+// ################################################
+
+static void print_usage(const char* program_name);
+static bool try_running_case(const micro_case_t* micro_case, const char* root_dir,
+                             char* eviction_buffer, size_t samples_cnt);
+
+// Main
+// ################################################
+
+int main(int argc, char* argv[]) {
+
+    size_t samples_cnt = DEFAULT_SAMPLES;
+    const char* filter = NULL;
+
+    int option;
+    while((option = getopt(argc, argv, MICRO_OPTSTRING)) != -1) {
+        switch(option) {
+            case 's':
+                samples_cnt = strtoul(optarg, NULL, 10);
+                if(samples_cnt == 0) {
+                    print_usage(argv[0]);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'f':
+                filter = optarg;
+                break;
+            default:
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if(optind != argc) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const char* root_dir = getenv(ROOT_DIR_ENV);
+    if(root_dir == NULL || *root_dir == '\0') {
+        root_dir = DEFAULT_ROOT_DIR;
+    }
+    char* eviction_buffer = malloc(EVICTION_BUFFER_SIZE);
+    if(eviction_buffer == NULL) {
+        perror("Error allocating memory for eviction buffer");
+        return EXIT_FAILURE;
+    }
+
+    // One CPU for the whole run, so the cycle counter and the caches stay the same
+    pin_current_thread(placement_cpu_for_worker(PLACEMENT_COMPACT, 0));
+
+    printf("%-22s %-30s %-5s %12s %12s %10s %8s\n",
+        "group", "kernel", "cache", "cycles/call", "cycles/byte", "ns/call", "mad");
+    bool successful = true;
+    for(size_t i=0; i<SUITES_CNT; ++i) {
+        for(size_t j=0; j<*SUITES[i].cases_cnt; ++j) {
+            const micro_case_t* micro_case = &SUITES[i].cases[j];
+            if(filter != NULL && strstr(micro_case->group, filter) == NULL && strstr(micro_case->name, filter) == NULL) {
+                continue;
+            }
+            successful = try_running_case(micro_case, root_dir, eviction_buffer, samples_cnt) && successful;
+        }
+    }
+
+    free(eviction_buffer);
+    return successful ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static void print_usage(const char* program_name) {
+    fprintf(stderr, "Usage: %s [options]\n", program_name);
+    fprintf(stderr, "  -s n        Samples per kernel and cache state (default %d)\n", DEFAULT_SAMPLES);
+    fprintf(stderr, "  -f text     Only kernels whose group or name contains text\n");
+}
+
+// Harness
+// ################################################
+
+bool try_loading_micro_lines(const char* root_dir, const char* relative_path, micro_lines_t* lines) {
+
+    size_t path_len = strlen(root_dir) + strlen(relative_path) + 2;
+    char* path = malloc(path_len);
+    if(path == NULL) {
+        perror("Error allocating memory for input path");
+        return false;
+    }
+    snprintf(path, path_len, "%s/%s", root_dir, relative_path);
+    bool loaded = try_loading_input(path, &lines->input);
+    free(path);
+    if(!loaded) {
+        return false;
+    }
+
+    // Upper bound: one line per '\n' plus an unterminated last line
+    size_t max_lines_cnt = 1;
+    for(size_t i=0; i<lines->input.size; ++i) {
+        max_lines_cnt += lines->input.data[i] == '\n';
+    }
+    lines->lines = malloc(max_lines_cnt * sizeof(const char*));
+    lines->line_lens = malloc(max_lines_cnt * sizeof(size_t));
+    if(lines->lines == NULL || lines->line_lens == NULL) {
+        perror("Error allocating memory for lines");
+        release_micro_lines(lines);
+        return false;
+    }
+    lines->lines_cnt = 0;
+    const char* cursor = lines->input.data;
+    const char* end = lines->input.data + lines->input.size;
+    while(next_line(&cursor, end, &lines->lines[lines->lines_cnt], &lines->line_lens[lines->lines_cnt])) {
+        lines->lines_cnt++;
+    }
+    return true;
+}
+
+void release_micro_lines(micro_lines_t* lines) {
+    free(lines->lines);
+    free(lines->line_lens);
+    lines->lines = NULL;
+    lines->line_lens = NULL;
+    release_input(&lines->input);
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static uint64_t read_cycles(void) {
+#ifdef HAVE_CYCLE_COUNTER
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double median(double* values, size_t values_cnt) {
+    qsort(values, values_cnt, sizeof(double), compare_doubles);
+    if(values_cnt % 2 == 1) {
+        return values[values_cnt / 2];
+    }
+    return (values[values_cnt / 2 - 1] + values[values_cnt / 2]) / 2.0;
+}
+
+// Writes one byte per cache line, so the next pass starts from memory
+static void evict_caches(char* eviction_buffer) {
+    static char value = 0;
+    value++;
+    for(size_t i=0; i<EVICTION_BUFFER_SIZE; i+=CACHE_LINE_SIZE) {
+        eviction_buffer[i] = value;
+    }
+    checksum_sink += (uint64_t)eviction_buffer[(unsigned char)value];
+}
+
+// cold: one pass per sample after an eviction; warm: enough passes per sample
+// for the clock, after the data set got loaded by the calibration
+static bool try_measuring(const micro_case_t* micro_case, void* context, char* eviction_buffer,
+                          size_t samples_cnt, bool cold, pass_cost_t* cost) {
+
+    double* ns_samples = malloc(samples_cnt * sizeof(double));
+    double* cycle_samples = malloc(samples_cnt * sizeof(double));
+    if(ns_samples == NULL || cycle_samples == NULL) {
+        perror("Error allocating memory for samples");
+        free(ns_samples);
+        free(cycle_samples);
+        return false;
+    }
+
+    size_t passes = 1;
+    if(!cold) {
+        double start = now_ns();
+        checksum_sink += micro_case->run(context);
+        double pass_ns = now_ns() - start;
+        while((double)passes * pass_ns < MIN_WARM_SAMPLE_NS) {
+            passes *= 2;
+        }
+    }
+
+    for(size_t i=0; i<samples_cnt; ++i) {
+        if(cold) {
+            evict_caches(eviction_buffer);
+        }
+        double start_ns = now_ns();
+        uint64_t start_cycles = read_cycles();
+        for(size_t pass=0; pass<passes; ++pass) {
+            checksum_sink += micro_case->run(context);
+        }
+        uint64_t end_cycles = read_cycles();
+        ns_samples[i] = (now_ns() - start_ns) / (double)passes;
+        cycle_samples[i] = (double)(end_cycles - start_cycles) / (double)passes;
+    }
+
+    cost->ns = median(ns_samples, samples_cnt);
+    cost->cycles = median(cycle_samples, samples_cnt);
+    for(size_t i=0; i<samples_cnt; ++i) {
+        ns_samples[i] = ns_samples[i] > cost->ns ? ns_samples[i] - cost->ns : cost->ns - ns_samples[i];
+    }
+    cost->mad_ns = median(ns_samples, samples_cnt);
+
+    free(ns_samples);
+    free(cycle_samples);
+    return true;
+}
+
+static void print_cost(const micro_case_t* micro_case, const micro_work_t* work, const char* cache,
+                       const pass_cost_t* cost) {
+
+    double calls = (double)(work->calls > 0 ? work->calls : 1);
+    printf("%-22s %-30s %-5s ", micro_case->group, micro_case->name, cache);
+#ifdef HAVE_CYCLE_COUNTER
+    printf("%12.2f ", cost->cycles / calls);
+    if(work->bytes > 0) {
+        printf("%12.3f ", cost->cycles / (double)work->bytes);
+    } else {
+        printf("%12s ", "-");
+    }
+#else
+    printf("%12s %12s ", "-", "-");
+#endif
+    printf("%10.2f %7.1f%%\n", cost->ns / calls, cost->ns > 0 ? 100.0 * cost->mad_ns / cost->ns : 0.0);
+}
+
+static bool try_running_case(const micro_case_t* micro_case, const char* root_dir,
+                             char* eviction_buffer, size_t samples_cnt) {
+
+    micro_work_t work = {0, 0};
+    void* context = micro_case->setup(root_dir, &work);
+    if(context == NULL) {
+        fprintf(stderr, "Error: Setup of %s/%s failed\n", micro_case->group, micro_case->name);
+        return false;
+    }
+
+    pass_cost_t warm;
+    pass_cost_t cold;
+    bool measured = try_measuring(micro_case, context, eviction_buffer, samples_cnt, false, &warm)
+                 && try_measuring(micro_case, context, eviction_buffer, samples_cnt, true, &cold);
+    if(measured) {
+        print_cost(micro_case, &work, "warm", &warm);
+        print_cost(micro_case, &work, "cold", &cold);
+    }
+    micro_case->teardown(context);
+    return measured;
+}
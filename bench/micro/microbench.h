@@ -0,0 +1,54 @@
+#ifndef AOC_MICROBENCH_H
+#define AOC_MICROBENCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "input.h"
+
+// Kernel Microbenchmarks
+// ################################################
+//
+// Every case times one kernel in isolation on inputs prepared by its setup.
+// One pass runs the kernel over the whole prepared data set; work tells how
+// many calls and bytes one pass covers, so results come out per call and per
+// byte. Cases of the same group measure interchangeable kernels and are
+// printed next to each other. The day sources are compiled into the
+// micro_dayXX translation units, so their static kernels are reachable.
+
+typedef struct {
+    size_t calls;
+    size_t bytes;       // 0: per-byte numbers are not meaningful
+} micro_work_t;
+
+typedef struct {
+    const char* group;
+    const char* name;
+    // Loads inputs relative to the repository root; NULL on failure (reported)
+    void* (*setup)(const char* root_dir, micro_work_t* work);
+    // One pass; the checksum keeps the compiler from dropping the work
+    uint64_t (*run)(void* context);
+    void (*teardown)(void* context);
+} micro_case_t;
+
+extern const micro_case_t MICRO_DAY01_CASES[];
+extern const size_t MICRO_DAY01_CASES_CNT;
+extern const micro_case_t MICRO_DAY02_CASES[];
+extern const size_t MICRO_DAY02_CASES_CNT;
+extern const micro_case_t MICRO_DAY03_CASES[];
+extern const size_t MICRO_DAY03_CASES_CNT;
+
+// Input file split into lines (each incl. its '\n'), shared by the setups
+typedef struct {
+    input_t input;
+    const char** lines;
+    size_t* line_lens;
+    size_t lines_cnt;
+} micro_lines_t;
+
+// relative_path is relative to root_dir
+bool try_loading_micro_lines(const char* root_dir, const char* relative_path, micro_lines_t* lines);
+void release_micro_lines(micro_lines_t* lines);
+
+#endif
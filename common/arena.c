@@ -0,0 +1,103 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+
+// Helper Functions
+// ################################################
+
+static size_t align_up(size_t size) {
+    return (size + (ARENA_ALIGNMENT - 1)) & ~((size_t)ARENA_ALIGNMENT - 1);
+}
+
+static arena_block_t* create_block(size_t size) {
+    arena_block_t* block = malloc(sizeof(arena_block_t) + size);
+    if(block == NULL) {
+        return NULL;
+    }
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+// Arena Allocator
+// ################################################
+
+void init_arena(arena_t* arena, size_t block_size) {
+    arena->blocks = NULL;
+    arena->block_size = (block_size > 0) ? block_size : ARENA_DEFAULT_BLOCK_SIZE;
+    arena->bytes_allocated = 0;
+}
+
+void* arena_alloc(arena_t* arena, size_t size) {
+
+    size = align_up(size);
+
+    // Only the newest block is bumped, older blocks are full
+    arena_block_t* block = arena->blocks;
+    if(block == NULL || block->size - block->used < size) {
+        size_t new_block_size = (size > arena->block_size) ? size : arena->block_size;
+        arena_block_t* new_block = create_block(new_block_size);
+        if(new_block == NULL) {
+            perror("Error allocating arena block");
+            return NULL;
+        }
+        new_block->next = arena->blocks;
+        arena->blocks = new_block;
+        arena->bytes_allocated += new_block_size;
+        block = new_block;
+    }
+
+    void* ptr = (char*)block->data + block->used;
+    block->used += size;
+    return ptr;
+}
+
+char* arena_strdup(arena_t* arena, const char* str) {
+    size_t length = strlen(str) + 1;
+    char* copy = arena_alloc(arena, length);
+    if(copy != NULL) {
+        memcpy(copy, str, length);
+    }
+    return copy;
+}
+
+void reset_arena(arena_t* arena) {
+
+    // Keep the largest block for the next round, free the rest
+    arena_block_t* largest = NULL;
+    arena_block_t* block = arena->blocks;
+    while(block != NULL) {
+        arena_block_t* next = block->next;
+        if(largest == NULL || block->size > largest->size) {
+            if(largest != NULL) {
+                free(largest);
+            }
+            largest = block;
+        } else {
+            free(block);
+        }
+        block = next;
+    }
+
+    arena->blocks = largest;
+    arena->bytes_allocated = 0;
+    if(largest != NULL) {
+        largest->next = NULL;
+        largest->used = 0;
+        arena->bytes_allocated = largest->size;
+    }
+}
+
+void destroy_arena(arena_t* arena) {
+    arena_block_t* block = arena->blocks;
+    while(block != NULL) {
+        arena_block_t* next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->blocks = NULL;
+    arena->bytes_allocated = 0;
+}
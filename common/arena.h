@@ -0,0 +1,36 @@
+#ifndef AOC_ARENA_H
+#define AOC_ARENA_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// Arena Allocator
+// ################################################
+//
+// Bump allocator for many small, short-lived allocations (e.g. per-line
+// strings). Everything is released at once with reset_arena(), which keeps
+// the largest block, so a warm arena serves the next input without malloc.
+
+#define ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+#define ARENA_ALIGNMENT (16)
+
+typedef struct arena_block {
+    struct arena_block* next;
+    size_t size;
+    size_t used;
+    max_align_t data[];
+} arena_block_t;
+
+typedef struct {
+    arena_block_t* blocks;
+    size_t block_size;
+    size_t bytes_allocated;
+} arena_t;
+
+void init_arena(arena_t* arena, size_t block_size);
+void* arena_alloc(arena_t* arena, size_t size);
+char* arena_strdup(arena_t* arena, const char* str);
+void reset_arena(arena_t* arena);
+void destroy_arena(arena_t* arena);
+
+#endif
@@ -0,0 +1,328 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>   // PRIu64
+#include <unistd.h>     // gethostname, sysconf, getpid
+#include <time.h>       // clock_gettime
+
+#include "autotune.h"
+
+// Definitions
+// ################################################
+
+#define MACHINE_NAME_LEN (128)
+#define SOLVER_NAME_LEN (32)
+#define PROFILE_LINE_LEN (512)
+#define PROFILE_HEADER "# machine solver version calibrated_bytes parallel_min_bytes threads chunk_size\n"
+// Calibration runs per configuration, the fastest counts
+#define CALIBRATION_RUNS (3)
+#define MIN_CALIBRATION_BYTES (16 * 1024)
+// Prefixes shrink by this factor while looking for the break-even size
+#define CALIBRATION_SHRINK (4)
+#define BYTES_PER_KIB (1024.0)
+#define BYTES_PER_MIB (1024.0 * 1024.0)
+
+static const size_t CHUNK_SIZES[] = {16 * 1024, 64 * 1024, 256 * 1024, 1024 * 1024};
+#define CHUNK_SIZES_CNT (sizeof(CHUNK_SIZES) / sizeof(CHUNK_SIZES[0]))
+
+// One line of the tuning profile
+typedef struct {
+    char machine[MACHINE_NAME_LEN];
+    char solver[SOLVER_NAME_LEN];
+    uint32_t version;
+    uint64_t calibrated_bytes;      // Largest input prefix calibrated on
+    uint64_t parallel_min_bytes;    // Smallest input where threads won
+    size_t thread_cnt;              // 1: serial won on every calibrated size
+    size_t chunk_size;
+} tuning_entry_t;
+
+// Helper Functions
+// ################################################
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static const char* profile_path(void) {
+    const char* path = getenv(AUTOTUNE_PROFILE_ENV);
+    return (path != NULL && *path != '\0') ? path : AUTOTUNE_DEFAULT_PROFILE;
+}
+
+static size_t online_cpus(void) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? (size_t)cpus : 1;
+}
+
+// "host/cpus", a profile only applies to the machine it was measured on
+static void describe_machine(char* machine, size_t machine_size) {
+    char host[MACHINE_NAME_LEN / 2];
+    if(gethostname(host, sizeof(host)) != 0) {
+        strcpy(host, "unknown");
+    }
+    host[sizeof(host) - 1] = '\0';
+    for(char* c=host; *c != '\0'; ++c) {
+        if(*c == ' ' || *c == '\t') {
+            *c = '_';
+        }
+    }
+    snprintf(machine, machine_size, "%s/%zu", host, online_cpus());
+}
+
+static void format_size(char* text, size_t text_size, uint64_t bytes) {
+    if(bytes >= BYTES_PER_MIB) {
+        snprintf(text, text_size, "%.2f MiB", (double)bytes / BYTES_PER_MIB);
+    } else if(bytes < BYTES_PER_KIB) {
+        snprintf(text, text_size, "%" PRIu64 " B", bytes);
+    } else {
+        snprintf(text, text_size, "%.1f KiB", (double)bytes / BYTES_PER_KIB);
+    }
+}
+
+// Longest prefix of at most max_size bytes that ends with a complete line
+static size_t line_aligned_prefix(const char* input, size_t input_size, size_t max_size) {
+    if(input_size <= max_size) {
+        return input_size;
+    }
+    size_t prefix = max_size;
+    while(prefix > 0 && input[prefix - 1] != '\n') {
+        prefix--;
+    }
+    return prefix;
+}
+
+// Tuning Profile
+// ################################################
+
+static bool try_parsing_entry(const char* line, tuning_entry_t* entry) {
+    return sscanf(line, "%127s %31s %" SCNu32 " %" SCNu64 " %" SCNu64 " %zu %zu",
+                  entry->machine, entry->solver, &entry->version, &entry->calibrated_bytes,
+                  &entry->parallel_min_bytes, &entry->thread_cnt, &entry->chunk_size) == 7
+        && entry->thread_cnt > 0;
+}
+
+static bool entry_matches(const tuning_entry_t* entry, const tuning_entry_t* key) {
+    return strcmp(entry->machine, key->machine) == 0 && strcmp(entry->solver, key->solver) == 0
+        && entry->version == key->version;
+}
+
+static bool try_finding_entry(const tuning_entry_t* key, tuning_entry_t* entry) {
+
+    FILE* profile = fopen(profile_path(), "r");
+    if(profile == NULL) {
+        return false;
+    }
+    char line[PROFILE_LINE_LEN];
+    bool found = false;
+    while(!found && fgets(line, sizeof(line), profile) != NULL) {
+        found = line[0] != '#' && try_parsing_entry(line, entry) && entry_matches(entry, key);
+    }
+    fclose(profile);
+    return found;
+}
+
+// Rewrites the profile with entry replacing the line of the same machine, solver and version
+static bool try_storing_entry(const tuning_entry_t* entry) {
+
+    const char* path = profile_path();
+    char temp_path[4096];
+    int temp_path_len = snprintf(temp_path, sizeof(temp_path), "%s.%ld.tmp", path, (long)getpid());
+    if(temp_path_len < 0 || (size_t)temp_path_len >= sizeof(temp_path)) {
+        fprintf(stderr, "Error: Tuning profile path too long\n");
+        return false;
+    }
+    FILE* temp = fopen(temp_path, "w");
+    if(temp == NULL) {
+        perror("Error opening tuning profile for writing");
+        return false;
+    }
+    fputs(PROFILE_HEADER, temp);
+    FILE* profile = fopen(path, "r");
+    if(profile != NULL) {
+        char line[PROFILE_LINE_LEN];
+        tuning_entry_t existing;
+        while(fgets(line, sizeof(line), profile) != NULL) {
+            if(line[0] != '#' && try_parsing_entry(line, &existing) && !entry_matches(&existing, entry)) {
+                fputs(line, temp);
+            }
+        }
+        fclose(profile);
+    }
+    fprintf(temp, "%s %s %" PRIu32 " %" PRIu64 " %" PRIu64 " %zu %zu\n",
+            entry->machine, entry->solver, entry->version, entry->calibrated_bytes,
+            entry->parallel_min_bytes, entry->thread_cnt, entry->chunk_size);
+    if(fclose(temp) != 0 || rename(temp_path, path) == -1) {
+        perror("Error writing tuning profile");
+        remove(temp_path);
+        return false;
+    }
+    return true;
+}
+
+// Calibration
+// ################################################
+
+// Fastest of CALIBRATION_RUNS solves, in ns
+static bool try_timing_solver(const solver_t* solver, void* state, const solver_options_t* options,
+                              const char* input, size_t input_size, double* best_ns) {
+    *best_ns = 0.0;
+    for(size_t run=0; run<CALIBRATION_RUNS; ++run) {
+        solver_result_t result;
+        double start = now_ns();
+        if(!try_solving_buffer(solver, state, options, input, input_size, &result)) {
+            return false;
+        }
+        double elapsed = now_ns() - start;
+        if(run == 0 || elapsed < *best_ns) {
+            *best_ns = elapsed;
+        }
+    }
+    return true;
+}
+
+static bool try_calibrating(const solver_t* solver, void* state, const solver_options_t* options,
+                            const char* input, size_t input_size, tuning_entry_t* entry) {
+
+    size_t prefix = line_aligned_prefix(input, input_size, AUTOTUNE_MAX_CALIBRATION_BYTES);
+    if(prefix == 0) {
+        prefix = input_size;
+    }
+    // Capped calibrations stand for every larger input
+    entry->calibrated_bytes = input_size <= AUTOTUNE_MAX_CALIBRATION_BYTES ? input_size : AUTOTUNE_MAX_CALIBRATION_BYTES;
+    entry->parallel_min_bytes = 0;
+    entry->thread_cnt = 1;
+    entry->chunk_size = 0;
+
+    solver_options_t serial = *options;
+    serial.thread_cnt = 1;
+    serial.chunk_size = 0;
+    double serial_ns;
+    if(!try_timing_solver(solver, state, &serial, input, prefix, &serial_ns)) {
+        return false;
+    }
+
+    // Every thread count (powers of two and all CPUs) with every chunk size
+    size_t cpus = online_cpus();
+    solver_options_t best = serial;
+    double best_ns = serial_ns;
+    for(size_t threads=2; threads<=cpus; threads=(threads * 2 > cpus && threads < cpus) ? cpus : threads * 2) {
+        for(size_t i=0; i<CHUNK_SIZES_CNT; ++i) {
+            // Fewer chunks than workers leaves workers idle
+            if(prefix / CHUNK_SIZES[i] < threads) {
+                continue;
+            }
+            solver_options_t candidate = serial;
+            candidate.thread_cnt = threads;
+            candidate.chunk_size = CHUNK_SIZES[i];
+            double candidate_ns;
+            if(!try_timing_solver(solver, state, &candidate, input, prefix, &candidate_ns)) {
+                return false;
+            }
+            if(candidate_ns < best_ns) {
+                best = candidate;
+                best_ns = candidate_ns;
+            }
+        }
+        if(threads == cpus) {
+            break;
+        }
+    }
+    if(best.thread_cnt == 1) {
+        return true;
+    }
+    entry->thread_cnt = best.thread_cnt;
+    entry->chunk_size = best.chunk_size;
+    entry->parallel_min_bytes = prefix;
+
+    // Shrink the prefix until serial wins again
+    for(size_t size=prefix / CALIBRATION_SHRINK; size>=MIN_CALIBRATION_BYTES; size/=CALIBRATION_SHRINK) {
+        size_t shrunk = line_aligned_prefix(input, prefix, size);
+        if(shrunk == 0) {
+            break;
+        }
+        double shrunk_serial_ns;
+        double shrunk_best_ns;
+        if(!try_timing_solver(solver, state, &serial, input, shrunk, &shrunk_serial_ns)
+        || !try_timing_solver(solver, state, &best, input, shrunk, &shrunk_best_ns)) {
+            return false;
+        }
+        if(shrunk_best_ns >= shrunk_serial_ns) {
+            break;
+        }
+        entry->parallel_min_bytes = shrunk;
+    }
+    return true;
+}
+
+// Auto-Tuning
+// ################################################
+
+input_backend_t autotune_input_backend(size_t input_size) {
+    return input_size <= AUTOTUNE_READ_MAX_BYTES ? INPUT_BACKEND_READ : INPUT_BACKEND_MMAP;
+}
+
+bool try_autotuning_solver(const solver_t* solver,
+                           void* state,
+                           const char* input_file_name,
+                           const char* input,
+                           size_t input_size,
+                           solver_options_t* options) {
+
+    // The log belongs between the output of earlier solves and this one
+    fflush(stdout);
+    options->thread_cnt = 1;
+    options->chunk_size = 0;
+    char size_text[32];
+    format_size(size_text, sizeof(size_text), input_size);
+    if(!solver->supports_threads) {
+        fprintf(stderr, "Autotune %s %s (%s): serial (no thread support), %s\n", solver->name, input_file_name,
+                size_text, input_backend_name(options->input_backend));
+        return true;
+    }
+
+    tuning_entry_t key;
+    memset(&key, 0, sizeof(key));
+    describe_machine(key.machine, sizeof(key.machine));
+    snprintf(key.solver, sizeof(key.solver), "%s", solver->name);
+    key.version = solver->version;
+
+    // An entry calibrated on a smaller input than this one says nothing about it
+    tuning_entry_t entry;
+    const char* source = "profile";
+    double calibration_ms = 0.0;
+    if(!try_finding_entry(&key, &entry)
+    || (entry.calibrated_bytes < AUTOTUNE_MAX_CALIBRATION_BYTES && input_size > entry.calibrated_bytes)) {
+        entry = key;
+        double start = now_ns();
+        if(!try_calibrating(solver, state, options, input, input_size, &entry)) {
+            return false;
+        }
+        calibration_ms = (now_ns() - start) / 1e6;
+        source = try_storing_entry(&entry) ? "calibrated" : "calibrated, not stored";
+    }
+
+    if(entry.thread_cnt > 1 && input_size >= entry.parallel_min_bytes) {
+        options->thread_cnt = entry.thread_cnt;
+        options->chunk_size = entry.chunk_size;
+        char chunk_text[32];
+        format_size(chunk_text, sizeof(chunk_text), entry.chunk_size);
+        fprintf(stderr, "Autotune %s %s (%s): %zu threads x %s chunks, %s", solver->name, input_file_name,
+                size_text, entry.thread_cnt, chunk_text, input_backend_name(options->input_backend));
+    } else {
+        fprintf(stderr, "Autotune %s %s (%s): serial, %s", solver->name, input_file_name,
+                size_text, input_backend_name(options->input_backend));
+    }
+    if(calibration_ms > 0.0) {
+        fprintf(stderr, " (%s in %.0f ms)\n", source, calibration_ms);
+    } else {
+        fprintf(stderr, " (%s)\n", source);
+    }
+    return true;
+}
+
+void log_streamed_input(const solver_t* solver, const char* input_file_name, input_format_t format) {
+    fflush(stdout);
+    fprintf(stderr, "Autotune %s %s: serial, streamed (%s)\n", solver->name, input_file_name,
+            input_format_name(format));
+}
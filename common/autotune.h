@@ -0,0 +1,46 @@
+#ifndef AOC_AUTOTUNE_H
+#define AOC_AUTOTUNE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "input.h"
+#include "solver.h"
+
+// Auto-Tuning
+// ################################################
+//
+// -j auto picks the input backend, the thread count and the chunk size per
+// input instead of per command line. Plain inputs up to
+// AUTOTUNE_READ_MAX_BYTES are read(), larger ones mapped; compressed inputs
+// are always streamed and solved serially.
+//
+// Solvers with supports_threads are calibrated on a newline aligned prefix
+// of their input (at most AUTOTUNE_MAX_CALIBRATION_BYTES): serial against
+// every thread count and chunk size, then with shrinking prefixes down to
+// the size where threads stop paying off. The outcome is kept in a tuning
+// profile, one line per machine (host name and online CPUs), solver and
+// solver version, so later runs skip the calibration unless an input is
+// larger than the one calibrated on. Every choice is logged on stderr.
+
+#define AUTOTUNE_PROFILE_ENV "AOC_TUNE_PROFILE"
+#define AUTOTUNE_DEFAULT_PROFILE ".autotune_profile"
+#define AUTOTUNE_MAX_CALIBRATION_BYTES (4 * 1024 * 1024)
+#define AUTOTUNE_READ_MAX_BYTES (256 * 1024)
+
+// Backend for a plain input of input_size bytes
+input_backend_t autotune_input_backend(size_t input_size);
+
+// Sets thread_cnt and chunk_size of options for the loaded input, calibrating
+// (and updating the profile) first if the profile has no fitting entry
+bool try_autotuning_solver(const solver_t* solver,
+                           void* state,
+                           const char* input_file_name,
+                           const char* input,
+                           size_t input_size,
+                           solver_options_t* options);
+
+// Logs the choice for a compressed input, which is always streamed serially
+void log_streamed_input(const solver_t* solver, const char* input_file_name, input_format_t format);
+
+#endif
@@ -0,0 +1,106 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>   // int64_t
+#include <unistd.h>     // getopt
+
+#include "autotune.h"
+#include "cli.h"
+#include "profiler.h"
+#include "utils.h"
+
+// Command Line
+// ################################################
+
+bool try_parsing_solver_option(int option, const char* argument, solver_options_t* options) {
+
+    switch(option) {
+        case 'c':
+            options->use_cache = true;
+            return true;
+        case 'j': {
+            if(strcmp(argument, "auto") == 0) {
+                options->autotune = true;
+                options->thread_cnt = 1;
+                return true;
+            }
+            char* end = NULL;
+            unsigned long thread_cnt = strtoul(argument, &end, 10);
+            if(end == argument || *end != '\0' || thread_cnt == 0 || thread_cnt > 1024) {
+                fprintf(stderr, "Error: Invalid thread count \"%s\"\n", argument);
+                return false;
+            }
+            options->autotune = false;
+            options->thread_cnt = (size_t)thread_cnt;
+            return true;
+        }
+        case 'm':
+            options->mode = argument;
+            return true;
+        case 'e':
+            options->export_file_name = argument;
+            return true;
+        case 'p':
+            if(!try_parsing_placement_policy(argument, &options->placement)) {
+                fprintf(stderr, "Error: Invalid placement policy \"%s\" (none, compact, spread)\n", argument);
+                return false;
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+void print_solver_options_usage(FILE* stream) {
+    fprintf(stream, "  -c          Use the persistent result cache\n");
+    fprintf(stream, "  -j threads  Number of worker threads (default: 1), auto: tune threads, chunks and input loading\n");
+    fprintf(stream, "              per input (profile in %s or $%s)\n", AUTOTUNE_DEFAULT_PROFILE, AUTOTUNE_PROFILE_ENV);
+    fprintf(stream, "  -m mode     Solver variant, e.g. 02: pipeline, whatif:<file>, 03: generic, packed, tiled[:columns], memo[:entries]\n");
+    fprintf(stream, "  -p policy   Worker pinning with -j: none (default), compact, spread\n");
+    fprintf(stream, "  -e file     Export per-item results of 02 and 03 (CSV, binary if file ends in .bin)\n");
+    fprintf(stream, "  %s=hz  Sample where the time goes and report it at the end (1 = %d Hz)\n",
+            PROFILER_ENV, PROFILER_DEFAULT_HZ);
+}
+
+int run_solver_main(int argc, char* argv[], const solver_t* solver) {
+
+    solver_options_t options = SOLVER_OPTIONS_DEFAULT;
+    int option;
+    while((option = getopt(argc, argv, SOLVER_OPTSTRING)) != -1) {
+        if(!try_parsing_solver_option(option, optarg, &options)) {
+            fprintf(stderr, "Usage: %s [options] [input_file]\n", argv[0]);
+            print_solver_options_usage(stderr);
+            return EXIT_FAILURE;
+        }
+    }
+    const char* input_file_name = (optind < argc) ? argv[optind] : solver->default_input;
+    warn_about_unsupported_threads(solver, &options);
+
+    if(!try_starting_profiler_from_env()) {
+        return EXIT_FAILURE;
+    }
+    int64_t start_time = print_program_start();
+    // ------------------------------------------------
+
+    void* state = NULL;
+    if(!try_initializing_solver(solver, &state)) {
+        return EXIT_FAILURE;
+    }
+
+    solver_result_t result;
+    bool cache_hit = false;
+    bool solved = try_solving_file(solver, state, &options, input_file_name, &result, &cache_hit);
+    destroy_solver(solver, state);
+
+    if(cache_hit) {
+        printf("Cache hit for \"%s\"\n", input_file_name);
+    }
+    printf("\n\nResult: %" PRId64 "\n", solved ? result.part_one : -1);
+    if(solved && result.has_part_two) {
+        printf("Result Part 2: %" PRId64 "\n", result.part_two);
+    }
+
+    // ------------------------------------------------
+    print_program_end(start_time);
+    return solved ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,22 @@
+#ifndef AOC_CLI_H
+#define AOC_CLI_H
+
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "solver.h"
+
+// Command Line
+// ################################################
+
+// getopt option string understood by every solver front end
+#define SOLVER_OPTSTRING "cj:m:p:e:"
+
+// Handles one option of SOLVER_OPTSTRING, returns false on invalid input
+bool try_parsing_solver_option(int option, const char* argument, solver_options_t* options);
+void print_solver_options_usage(FILE* stream);
+
+// Complete main() of a day binary: [options] [input_file]
+int run_solver_main(int argc, char* argv[], const solver_t* solver);
+
+#endif
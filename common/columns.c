@@ -0,0 +1,42 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "columns.h"
+
+// Columnar Files
+// ################################################
+
+bool try_growing_arrays(void** arrays[], const size_t element_sizes[], size_t arrays_cnt,
+                        size_t* capacity, size_t needed, const char* what) {
+    if(needed <= *capacity) {
+        return true;
+    }
+    size_t new_capacity = (*capacity > 0) ? *capacity : COLUMNS_INITIAL_CAPACITY;
+    while(new_capacity < needed) {
+        new_capacity *= 2;
+    }
+    for(size_t i=0; i<arrays_cnt; ++i) {
+        void* grown = realloc(*arrays[i], new_capacity * element_sizes[i]);
+        if(grown == NULL) {
+            fprintf(stderr, "Error allocating memory for %s\n", what);
+            return false;
+        }
+        *arrays[i] = grown;
+    }
+    *capacity = new_capacity;
+    return true;
+}
+
+uint64_t align_up(uint64_t offset, uint64_t alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+bool section_is_valid(uint64_t offset, uint64_t cnt, uint64_t element_size, size_t input_size) {
+    if(offset % sizeof(uint64_t) != 0 || offset > input_size) {
+        return false;
+    }
+    if(cnt > (UINT64_MAX / element_size)) {
+        return false;
+    }
+    return cnt * element_size <= input_size - offset;
+}
@@ -0,0 +1,28 @@
+#ifndef AOC_COLUMNS_H
+#define AOC_COLUMNS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Columnar Files
+// ################################################
+//
+// Helpers of the binary input formats (03 schematics, 02 game caches): the
+// converters fill parallel growable arrays and write each one as an aligned
+// section, the loaders check every section against the mapped file.
+
+#define COLUMNS_INITIAL_CAPACITY (1024)
+
+// Grows all arrays together to at least needed elements (contents are kept),
+// what names them in the error message
+bool try_growing_arrays(void** arrays[], const size_t element_sizes[], size_t arrays_cnt,
+                        size_t* capacity, size_t needed, const char* what);
+
+// offset rounded up to a multiple of alignment
+uint64_t align_up(uint64_t offset, uint64_t alignment);
+
+// True if [offset, offset + cnt * element_size) lies inside the file and is aligned
+bool section_is_valid(uint64_t offset, uint64_t cnt, uint64_t element_size, size_t input_size);
+
+#endif
@@ -0,0 +1,223 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>      // errno
+#include <fcntl.h>      // open
+#include <unistd.h>     // close
+#include <pthread.h>    // pthread_create
+#include <sys/uio.h>    // writev
+
+#include "export_writer.h"
+
+// Definitions
+// ################################################
+
+#define BINARY_SUFFIX ".bin"
+
+struct export_writer {
+    int fd;
+
+    // Ring of blocks, guarded by lock: [write_index, write_index + filled_cnt) wait for the thread
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t block_filled;
+    pthread_cond_t block_freed;
+    char* blocks[EXPORT_BLOCK_CNT];
+    size_t block_sizes[EXPORT_BLOCK_CNT];
+    size_t write_index;
+    size_t filled_cnt;
+    bool finishing;
+    bool failed;
+
+    // Producer side only
+    size_t fill_index;
+    size_t used;
+};
+
+// Writer Thread
+// ################################################
+
+// Writes all of iov, advancing over partial writes
+static bool try_writing_all(int fd, struct iovec* iov, int iov_cnt) {
+    while(iov_cnt > 0) {
+        ssize_t written = writev(fd, iov, iov_cnt);
+        if(written < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            perror("Error writing export");
+            return false;
+        }
+        size_t remaining = (size_t)written;
+        while(iov_cnt > 0 && remaining >= iov->iov_len) {
+            remaining -= iov->iov_len;
+            iov++;
+            iov_cnt--;
+        }
+        if(iov_cnt > 0) {
+            iov->iov_base = (char*)iov->iov_base + remaining;
+            iov->iov_len -= remaining;
+        }
+    }
+    return true;
+}
+
+static void* write_blocks(void* arg) {
+
+    export_writer_t* writer = (export_writer_t*)arg;
+    pthread_mutex_lock(&writer->lock);
+    for(;;) {
+        while(writer->filled_cnt == 0 && !writer->finishing) {
+            pthread_cond_wait(&writer->block_filled, &writer->lock);
+        }
+        if(writer->filled_cnt == 0) {
+            break;
+        }
+
+        // Everything filled so far goes out in one writev
+        size_t blocks_cnt = writer->filled_cnt;
+        struct iovec iov[EXPORT_BLOCK_CNT];
+        for(size_t i=0; i<blocks_cnt; ++i) {
+            size_t block = (writer->write_index + i) % EXPORT_BLOCK_CNT;
+            iov[i].iov_base = writer->blocks[block];
+            iov[i].iov_len = writer->block_sizes[block];
+        }
+        bool failed = writer->failed;
+        pthread_mutex_unlock(&writer->lock);
+
+        // After a failure the blocks are only recycled, so the producer never blocks
+        bool written = failed || try_writing_all(writer->fd, iov, (int)blocks_cnt);
+
+        pthread_mutex_lock(&writer->lock);
+        writer->failed = writer->failed || !written;
+        writer->write_index = (writer->write_index + blocks_cnt) % EXPORT_BLOCK_CNT;
+        writer->filled_cnt -= blocks_cnt;
+        pthread_cond_signal(&writer->block_freed);
+    }
+    pthread_mutex_unlock(&writer->lock);
+    return NULL;
+}
+
+// Producer
+// ################################################
+
+// Passes the current block to the thread and waits for a free one
+static bool hand_off_block(export_writer_t* writer) {
+
+    pthread_mutex_lock(&writer->lock);
+    writer->block_sizes[writer->fill_index] = writer->used;
+    writer->filled_cnt++;
+    pthread_cond_signal(&writer->block_filled);
+    while(writer->filled_cnt == EXPORT_BLOCK_CNT) {
+        pthread_cond_wait(&writer->block_freed, &writer->lock);
+    }
+    bool failed = writer->failed;
+    pthread_mutex_unlock(&writer->lock);
+
+    writer->fill_index = (writer->fill_index + 1) % EXPORT_BLOCK_CNT;
+    writer->used = 0;
+    return !failed;
+}
+
+static void destroy_export_writer(export_writer_t* writer) {
+    for(size_t i=0; i<EXPORT_BLOCK_CNT; ++i) {
+        free(writer->blocks[i]);
+    }
+    if(writer->fd >= 0) {
+        close(writer->fd);
+    }
+    pthread_mutex_destroy(&writer->lock);
+    pthread_cond_destroy(&writer->block_filled);
+    pthread_cond_destroy(&writer->block_freed);
+    free(writer);
+}
+
+export_format_t export_format_for(const char* file_name) {
+    size_t name_len = strlen(file_name);
+    size_t suffix_len = strlen(BINARY_SUFFIX);
+    if(name_len >= suffix_len && strcmp(file_name + name_len - suffix_len, BINARY_SUFFIX) == 0) {
+        return EXPORT_FORMAT_BINARY;
+    }
+    return EXPORT_FORMAT_CSV;
+}
+
+bool try_opening_export_writer(const char* file_name,
+                               const char* csv_header,
+                               const export_binary_header_t* binary_header,
+                               export_writer_t** writer) {
+
+    export_writer_t* w = calloc(1, sizeof(export_writer_t));
+    if(w == NULL) {
+        perror("Error allocating memory for export writer");
+        return false;
+    }
+    w->fd = -1;
+    pthread_mutex_init(&w->lock, NULL);
+    pthread_cond_init(&w->block_filled, NULL);
+    pthread_cond_init(&w->block_freed, NULL);
+
+    for(size_t i=0; i<EXPORT_BLOCK_CNT; ++i) {
+        w->blocks[i] = malloc(EXPORT_BLOCK_SIZE);
+        if(w->blocks[i] == NULL) {
+            perror("Error allocating memory for export buffers");
+            destroy_export_writer(w);
+            return false;
+        }
+    }
+    w->fd = open(file_name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(w->fd < 0) {
+        perror("Error opening export file");
+        destroy_export_writer(w);
+        return false;
+    }
+
+    if(export_format_for(file_name) == EXPORT_FORMAT_BINARY) {
+        memcpy(w->blocks[0], binary_header, sizeof(export_binary_header_t));
+        w->used = sizeof(export_binary_header_t);
+    } else {
+        size_t header_len = strlen(csv_header);
+        memcpy(w->blocks[0], csv_header, header_len);
+        w->blocks[0][header_len] = '\n';
+        w->used = header_len + 1;
+    }
+
+    if(pthread_create(&w->thread, NULL, write_blocks, w) != 0) {
+        perror("Error creating export thread");
+        destroy_export_writer(w);
+        return false;
+    }
+    *writer = w;
+    return true;
+}
+
+char* export_reserve(export_writer_t* writer, size_t max_len) {
+    if(writer->used + max_len > EXPORT_BLOCK_SIZE && !hand_off_block(writer)) {
+        return NULL;
+    }
+    return writer->blocks[writer->fill_index] + writer->used;
+}
+
+void export_commit(export_writer_t* writer, char* end) {
+    writer->used = (size_t)(end - writer->blocks[writer->fill_index]);
+}
+
+bool try_closing_export_writer(export_writer_t* writer) {
+
+    if(writer->used > 0) {
+        hand_off_block(writer);
+    }
+    pthread_mutex_lock(&writer->lock);
+    writer->finishing = true;
+    pthread_cond_signal(&writer->block_filled);
+    pthread_mutex_unlock(&writer->lock);
+    pthread_join(writer->thread, NULL);
+
+    bool successful = !writer->failed;
+    if(close(writer->fd) != 0) {
+        perror("Error closing export file");
+        successful = false;
+    }
+    writer->fd = -1;
+    destroy_export_writer(writer);
+    return successful;
+}
@@ -0,0 +1,74 @@
+#ifndef AOC_EXPORT_WRITER_H
+#define AOC_EXPORT_WRITER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Export Writer
+// ################################################
+//
+// Per-item results (see -e) are formatted into large blocks by the solver
+// and written by a separate thread, all full blocks in one writev, so
+// exporting overlaps solving instead of doing one small write per item.
+// File names ending in ".bin" select fixed-size binary records behind a
+// small header, everything else is CSV with a header line.
+
+#define EXPORT_BLOCK_CNT (4)
+#define EXPORT_BLOCK_SIZE (1024 * 1024)
+// Upper bound of one record, for export_reserve
+#define EXPORT_MAX_RECORD_LEN (256)
+
+#define EXPORT_MAGIC_LEN (8)
+
+typedef enum {
+    EXPORT_FORMAT_CSV = 0,
+    EXPORT_FORMAT_BINARY
+} export_format_t;
+
+// Header of binary exports, followed by records of record_size bytes
+typedef struct {
+    char magic[EXPORT_MAGIC_LEN];   // e.g. "AOC03PN", zero padded
+    uint32_t version;
+    uint32_t record_size;
+} export_binary_header_t;
+
+typedef struct export_writer export_writer_t;
+
+export_format_t export_format_for(const char* file_name);
+
+// Starts the writer thread and writes the CSV header line or the binary header
+bool try_opening_export_writer(const char* file_name,
+                               const char* csv_header,
+                               const export_binary_header_t* binary_header,
+                               export_writer_t** writer);
+// Space for up to max_len bytes (at most EXPORT_MAX_RECORD_LEN), NULL after a write error
+char* export_reserve(export_writer_t* writer, size_t max_len);
+// Ends the reserved record at end
+void export_commit(export_writer_t* writer, char* end);
+// Writes the rest, joins the thread; false if any write failed (already reported)
+bool try_closing_export_writer(export_writer_t* writer);
+
+// Formatting helpers, return the end of the written text
+static inline char* export_format_u64(char* out, uint64_t value) {
+    char digits[20];
+    size_t cnt = 0;
+    do {
+        digits[cnt++] = (char)('0' + value % 10);
+        value /= 10;
+    } while(value > 0);
+    while(cnt > 0) {
+        *out++ = digits[--cnt];
+    }
+    return out;
+}
+
+static inline char* export_format_i64(char* out, int64_t value) {
+    if(value < 0) {
+        *out++ = '-';
+        return export_format_u64(out, (uint64_t)0 - (uint64_t)value);
+    }
+    return export_format_u64(out, (uint64_t)value);
+}
+
+#endif
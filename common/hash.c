@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>    // bool
+
+#include "hash.h"
+#include "input.h"
+
+// Definitions
+// ################################################
+
+#define PRIME64_1 (0x9E3779B185EBCA87ULL)
+#define PRIME64_2 (0xC2B2AE3D27D4EB4FULL)
+#define PRIME64_3 (0x165667B19E3779F9ULL)
+#define PRIME64_4 (0x85EBCA77C2B2AE63ULL)
+#define PRIME64_5 (0x27D4EB2F165667C5ULL)
+
+// Helper Functions
+// ################################################
+
+static inline uint64_t rotl64(uint64_t value, unsigned int shift) {
+    return (value << shift) | (value >> (64 - shift));
+}
+
+static inline uint64_t read64(const uint8_t* ptr) {
+    uint64_t value;
+    memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+static inline uint32_t read32(const uint8_t* ptr) {
+    uint32_t value;
+    memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+static inline uint64_t xxh64_round(uint64_t acc, uint64_t input) {
+    acc += input * PRIME64_2;
+    acc = rotl64(acc, 31);
+    return acc * PRIME64_1;
+}
+
+static inline uint64_t xxh64_merge_round(uint64_t acc, uint64_t value) {
+    acc ^= xxh64_round(0, value);
+    return acc * PRIME64_1 + PRIME64_4;
+}
+
+// Hashing
+// ################################################
+
+uint64_t xxh64(const void* data, size_t length, uint64_t seed) {
+
+    const uint8_t* ptr = (const uint8_t*)data;
+    const uint8_t* end = ptr + length;
+    uint64_t hash;
+
+    // Bulk: four independent lanes over 32 byte stripes
+    if(length >= 32) {
+        const uint8_t* limit = end - 32;
+        uint64_t v1 = seed + PRIME64_1 + PRIME64_2;
+        uint64_t v2 = seed + PRIME64_2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - PRIME64_1;
+        do {
+            v1 = xxh64_round(v1, read64(ptr));
+            v2 = xxh64_round(v2, read64(ptr + 8));
+            v3 = xxh64_round(v3, read64(ptr + 16));
+            v4 = xxh64_round(v4, read64(ptr + 24));
+            ptr += 32;
+        } while(ptr <= limit);
+
+        hash = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+        hash = xxh64_merge_round(hash, v1);
+        hash = xxh64_merge_round(hash, v2);
+        hash = xxh64_merge_round(hash, v3);
+        hash = xxh64_merge_round(hash, v4);
+    } else {
+        hash = seed + PRIME64_5;
+    }
+    hash += (uint64_t)length;
+
+    // Tail: remaining 8, 4 and 1 byte blocks
+    while(ptr + 8 <= end) {
+        hash ^= xxh64_round(0, read64(ptr));
+        hash = rotl64(hash, 27) * PRIME64_1 + PRIME64_4;
+        ptr += 8;
+    }
+    if(ptr + 4 <= end) {
+        hash ^= (uint64_t)read32(ptr) * PRIME64_1;
+        hash = rotl64(hash, 23) * PRIME64_2 + PRIME64_3;
+        ptr += 4;
+    }
+    while(ptr < end) {
+        hash ^= (uint64_t)(*ptr) * PRIME64_5;
+        hash = rotl64(hash, 11) * PRIME64_1;
+        ptr++;
+    }
+
+    // Avalanche
+    hash ^= hash >> 33;
+    hash *= PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= PRIME64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+bool try_hashing_file(const char* file_name, uint64_t* hash) {
+
+    input_t input;
+    if(!try_loading_input(file_name, &input)) {
+        return false;
+    }
+    *hash = xxh64(input.data, input.size, 0);
+    release_input(&input);
+    return true;
+}
@@ -0,0 +1,17 @@
+#ifndef AOC_HASH_H
+#define AOC_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Hashing
+// ################################################
+
+// XXH64 compatible 64-bit hash (same output as the reference implementation)
+uint64_t xxh64(const void* data, size_t length, uint64_t seed);
+
+// Hashes a whole file via mmap; an empty file hashes like an empty buffer
+bool try_hashing_file(const char* file_name, uint64_t* hash);
+
+#endif
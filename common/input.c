@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>      // EINTR
+#include <fcntl.h>      // open
+#include <unistd.h>     // close
+#include <sys/mman.h>   // mmap
+#include <sys/stat.h>   // fstat
+
+#include "input.h"
+
+// Input Buffers
+// ################################################
+
+bool try_loading_input(const char* file_name, input_t* input) {
+    return try_loading_input_with(file_name, INPUT_BACKEND_MMAP, input);
+}
+
+static bool try_reading_whole_file(int fd, input_t* input) {
+
+    char* data = malloc(input->size);
+    if(data == NULL) {
+        perror("Error allocating memory for input");
+        return false;
+    }
+    size_t read_bytes = 0;
+    while(read_bytes < input->size) {
+        ssize_t result = read(fd, data + read_bytes, input->size - read_bytes);
+        if(result == -1 && errno == EINTR) {
+            continue;
+        }
+        if(result <= 0) {
+            perror("Error reading file");
+            free(data);
+            return false;
+        }
+        read_bytes += (size_t)result;
+    }
+    input->data = data;
+    input->allocated = true;
+    return true;
+}
+
+bool try_loading_input_with(const char* file_name, input_backend_t backend, input_t* input) {
+
+    input->data = NULL;
+    input->size = 0;
+    input->mapped = false;
+    input->allocated = false;
+
+    int fd = open(file_name, O_RDONLY);
+    if(fd == -1) {
+        perror("Error opening file");
+        return false;
+    }
+
+    struct stat file_stat;
+    if(fstat(fd, &file_stat) == -1) {
+        perror("Error reading file size");
+        close(fd);
+        return false;
+    }
+
+    // Empty inputs are represented by an empty buffer
+    input->size = (size_t)file_stat.st_size;
+    if(input->size == 0) {
+        close(fd);
+        return true;
+    }
+
+    if(backend == INPUT_BACKEND_READ) {
+        bool loaded = try_reading_whole_file(fd, input);
+        close(fd);
+        if(!loaded) {
+            input->size = 0;
+        }
+        return loaded;
+    }
+
+    void* data = mmap(NULL, input->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(data == MAP_FAILED) {
+        perror("Error mapping file");
+        return false;
+    }
+    madvise(data, input->size, MADV_SEQUENTIAL);
+
+    input->data = data;
+    input->mapped = true;
+    return true;
+}
+
+void release_input(input_t* input) {
+    if(input->mapped) {
+        munmap((void*)input->data, input->size);
+    }
+    if(input->allocated) {
+        free((void*)input->data);
+    }
+    input->data = NULL;
+    input->size = 0;
+    input->mapped = false;
+    input->allocated = false;
+}
+
+const char* input_backend_name(input_backend_t backend) {
+    switch(backend) {
+        case INPUT_BACKEND_MMAP:
+            return "mmap";
+        case INPUT_BACKEND_READ:
+            return "read";
+        default:
+            return "unknown";
+    }
+}
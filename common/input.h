@@ -0,0 +1,46 @@
+#ifndef AOC_INPUT_H
+#define AOC_INPUT_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+// Input Buffers
+// ################################################
+
+// How a whole input file is brought into memory
+typedef enum {
+    INPUT_BACKEND_MMAP = 0,     // Mapped, pages are faulted in on first touch
+    INPUT_BACKEND_READ          // Copied into a heap buffer with read(), cheaper for small files
+} input_backend_t;
+
+// Whole input file as one read-only buffer
+typedef struct {
+    const char* data;
+    size_t size;
+    bool mapped;
+    bool allocated;
+} input_t;
+
+// Maps the file
+bool try_loading_input(const char* file_name, input_t* input);
+bool try_loading_input_with(const char* file_name, input_backend_t backend, input_t* input);
+void release_input(input_t* input);
+const char* input_backend_name(input_backend_t backend);
+
+// Returns the next line of [*cursor, end) including its '\n' (if any)
+// and advances the cursor behind it. Returns false at the end of the buffer.
+static inline bool next_line(const char** cursor, const char* end,
+                             const char** line, size_t* line_len) {
+    if(*cursor >= end) {
+        return false;
+    }
+    const char* newline = memchr(*cursor, '\n', (size_t)(end - *cursor));
+    const char* line_end = (newline != NULL) ? newline + 1 : end;
+    *line = *cursor;
+    *line_len = (size_t)(line_end - *cursor);
+    *cursor = line_end;
+    return true;
+}
+
+#endif
@@ -0,0 +1,424 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>    // pthread_create
+#include <zlib.h>       // gzopen
+#ifdef HAVE_ZSTD
+    #include <zstd.h>   // ZSTD_decompressStream
+#endif
+
+#include "input_stream.h"
+#include "mem_stats.h"
+
+// Definitions
+// ################################################
+
+#define MAGIC_BYTES_CNT (4)
+#define GZIP_BUFFER_SIZE (128 * 1024)
+
+struct input_stream {
+    input_format_t format;
+    gzFile gz;
+#ifdef HAVE_ZSTD
+    FILE* file;
+    ZSTD_DCtx* dctx;
+    void* compressed;
+    size_t compressed_capacity;
+    ZSTD_inBuffer compressed_buffer;
+    bool compressed_eof;
+    size_t last_zstd_result;
+#endif
+
+    // Ring of decompressed buffers, guarded by lock
+    pthread_t thread;
+    bool thread_started;
+    pthread_mutex_t lock;
+    pthread_cond_t slot_filled;
+    pthread_cond_t slot_freed;
+    char* slots[INPUT_STREAM_SLOT_CNT];
+    size_t slot_sizes[INPUT_STREAM_SLOT_CNT];
+    size_t fill_index;
+    size_t consume_index;
+    size_t filled_cnt;
+    bool finished;
+    bool failed;
+    bool stopping;
+
+    // Consumer side only
+    bool holding_slot;
+    size_t slot_pos;
+    char* carry;                // Line that spans two or more slots
+    size_t carry_len;
+    size_t carry_capacity;
+};
+
+// Format Detection
+// ################################################
+
+bool try_detecting_input_format(const char* file_name, input_format_t* format) {
+
+    FILE* file = fopen(file_name, "rb");
+    if(file == NULL) {
+        perror("Error opening file");
+        return false;
+    }
+    unsigned char magic[MAGIC_BYTES_CNT] = {0};
+    size_t magic_len = fread(magic, 1, sizeof(magic), file);
+    fclose(file);
+
+    *format = INPUT_FORMAT_PLAIN;
+    if(magic_len >= 2 && magic[0] == 0x1F && magic[1] == 0x8B) {
+        *format = INPUT_FORMAT_GZIP;
+    } else if(magic_len >= 4 && magic[0] == 0x28 && magic[1] == 0xB5 && magic[2] == 0x2F && magic[3] == 0xFD) {
+        *format = INPUT_FORMAT_ZSTD;
+    }
+    return true;
+}
+
+const char* input_format_name(input_format_t format) {
+    switch(format) {
+        case INPUT_FORMAT_GZIP: return "gzip";
+        case INPUT_FORMAT_ZSTD: return "zstd";
+        default: return "plain";
+    }
+}
+
+// Decompression Thread
+// ################################################
+
+static bool try_filling_gzip_slot(input_stream_t* stream, char* slot, size_t* produced, bool* eof) {
+
+    while(*produced < INPUT_STREAM_SLOT_SIZE) {
+        int read_bytes = gzread(stream->gz, slot + *produced, (unsigned)(INPUT_STREAM_SLOT_SIZE - *produced));
+        if(read_bytes < 0) {
+            int error_number;
+            fprintf(stderr, "Error decompressing gzip input: %s\n", gzerror(stream->gz, &error_number));
+            return false;
+        }
+        if(read_bytes == 0) {
+            *eof = true;
+            break;
+        }
+        *produced += (size_t)read_bytes;
+    }
+    return true;
+}
+
+#ifdef HAVE_ZSTD
+static bool try_filling_zstd_slot(input_stream_t* stream, char* slot, size_t* produced, bool* eof) {
+
+    ZSTD_outBuffer out = {slot, INPUT_STREAM_SLOT_SIZE, 0};
+    ZSTD_inBuffer* in = &stream->compressed_buffer;
+    while(out.pos < out.size) {
+        if(in->pos == in->size && !stream->compressed_eof) {
+            size_t read_bytes = fread(stream->compressed, 1, stream->compressed_capacity, stream->file);
+            if(read_bytes == 0) {
+                if(ferror(stream->file)) {
+                    perror("Error reading zstd input");
+                    return false;
+                }
+                stream->compressed_eof = true;
+            }
+            in->src = stream->compressed;
+            in->size = read_bytes;
+            in->pos = 0;
+        }
+
+        // The decoder may still hold output after the last input byte was consumed
+        size_t out_before = out.pos;
+        size_t in_before = in->pos;
+        size_t result = ZSTD_decompressStream(stream->dctx, &out, in);
+        if(ZSTD_isError(result)) {
+            fprintf(stderr, "Error decompressing zstd input: %s\n", ZSTD_getErrorName(result));
+            return false;
+        }
+        bool progressed = (out.pos != out_before) || (in->pos != in_before);
+        // 0 means the last frame was completely decoded and flushed
+        if(progressed) {
+            stream->last_zstd_result = result;
+        }
+        if(stream->compressed_eof && !progressed) {
+            if(stream->last_zstd_result != 0) {
+                fprintf(stderr, "Error decompressing zstd input: truncated frame\n");
+                return false;
+            }
+            *eof = true;
+            break;
+        }
+    }
+    *produced = out.pos;
+    return true;
+}
+#endif
+
+static bool try_filling_slot(input_stream_t* stream, char* slot, size_t* produced, bool* eof) {
+    *produced = 0;
+    *eof = false;
+#ifdef HAVE_ZSTD
+    if(stream->format == INPUT_FORMAT_ZSTD) {
+        return try_filling_zstd_slot(stream, slot, produced, eof);
+    }
+#endif
+    return try_filling_gzip_slot(stream, slot, produced, eof);
+}
+
+static void* decompress_stream(void* argument) {
+
+    input_stream_t* stream = argument;
+    bool eof = false;
+    while(!eof) {
+        // Wait for a free slot
+        pthread_mutex_lock(&stream->lock);
+        while(stream->filled_cnt == INPUT_STREAM_SLOT_CNT && !stream->stopping) {
+            pthread_cond_wait(&stream->slot_freed, &stream->lock);
+        }
+        if(stream->stopping) {
+            pthread_mutex_unlock(&stream->lock);
+            break;
+        }
+        size_t slot_index = stream->fill_index;
+        pthread_mutex_unlock(&stream->lock);
+
+        // Decompress outside the lock, the consumer never touches a free slot
+        size_t produced;
+        bool filled = try_filling_slot(stream, stream->slots[slot_index], &produced, &eof);
+
+        pthread_mutex_lock(&stream->lock);
+        if(!filled) {
+            stream->failed = true;
+            eof = true;
+        } else if(produced > 0) {
+            stream->slot_sizes[slot_index] = produced;
+            stream->fill_index = (slot_index + 1) % INPUT_STREAM_SLOT_CNT;
+            stream->filled_cnt++;
+        }
+        if(eof) {
+            stream->finished = true;
+        }
+        pthread_cond_signal(&stream->slot_filled);
+        pthread_mutex_unlock(&stream->lock);
+    }
+    return NULL;
+}
+
+// Input Stream
+// ################################################
+
+static bool try_opening_decoder(input_stream_t* stream, const char* file_name) {
+
+    if(stream->format == INPUT_FORMAT_GZIP) {
+        stream->gz = gzopen(file_name, "rb");
+        if(stream->gz == NULL) {
+            perror("Error opening gzip input");
+            return false;
+        }
+        gzbuffer(stream->gz, GZIP_BUFFER_SIZE);
+        return true;
+    }
+
+#ifdef HAVE_ZSTD
+    stream->file = fopen(file_name, "rb");
+    if(stream->file == NULL) {
+        perror("Error opening zstd input");
+        return false;
+    }
+    stream->dctx = ZSTD_createDCtx();
+    stream->compressed_capacity = ZSTD_DStreamInSize();
+    stream->compressed = malloc(stream->compressed_capacity);
+    if(stream->dctx == NULL || stream->compressed == NULL) {
+        fprintf(stderr, "Error allocating memory for zstd decoder\n");
+        return false;
+    }
+    stream->compressed_buffer.src = stream->compressed;
+    stream->compressed_buffer.size = 0;
+    stream->compressed_buffer.pos = 0;
+    return true;
+#else
+    fprintf(stderr, "Error: %s is zstd compressed, but zstd support was not built in\n", file_name);
+    return false;
+#endif
+}
+
+static void close_decoder(input_stream_t* stream) {
+    if(stream->gz != NULL) {
+        gzclose(stream->gz);
+    }
+#ifdef HAVE_ZSTD
+    if(stream->file != NULL) {
+        fclose(stream->file);
+    }
+    ZSTD_freeDCtx(stream->dctx);
+    free(stream->compressed);
+#endif
+}
+
+bool try_opening_input_stream(const char* file_name, input_format_t format, input_stream_t** stream) {
+
+    *stream = calloc(1, sizeof(input_stream_t));
+    if(*stream == NULL) {
+        perror("Error allocating memory for input stream");
+        return false;
+    }
+    input_stream_t* s = *stream;
+    s->format = format;
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->slot_filled, NULL);
+    pthread_cond_init(&s->slot_freed, NULL);
+
+    if(!try_opening_decoder(s, file_name)) {
+        goto error;
+    }
+    for(size_t i=0; i<INPUT_STREAM_SLOT_CNT; ++i) {
+        s->slots[i] = malloc(INPUT_STREAM_SLOT_SIZE);
+        if(s->slots[i] == NULL) {
+            perror("Error allocating memory for input stream buffers");
+            goto error;
+        }
+    }
+    if(pthread_create(&s->thread, NULL, decompress_stream, s) != 0) {
+        perror("Error creating decompression thread");
+        goto error;
+    }
+    s->thread_started = true;
+    return true;
+
+    error:
+        close_input_stream(s);
+        *stream = NULL;
+        return false;
+}
+
+static void mark_stream_failed(input_stream_t* stream) {
+    pthread_mutex_lock(&stream->lock);
+    stream->failed = true;
+    pthread_mutex_unlock(&stream->lock);
+}
+
+static void release_consumed_slot(input_stream_t* stream) {
+    pthread_mutex_lock(&stream->lock);
+    stream->consume_index = (stream->consume_index + 1) % INPUT_STREAM_SLOT_CNT;
+    stream->filled_cnt--;
+    pthread_cond_signal(&stream->slot_freed);
+    pthread_mutex_unlock(&stream->lock);
+    stream->holding_slot = false;
+}
+
+static bool try_appending_to_carry(input_stream_t* stream, const char* data, size_t data_len) {
+    if(stream->carry_len + data_len > stream->carry_capacity) {
+        size_t new_capacity = stream->carry_capacity > 0 ? stream->carry_capacity : 256;
+        while(new_capacity < stream->carry_len + data_len) {
+            new_capacity *= 2;
+        }
+        char* new_carry = realloc(stream->carry, new_capacity);
+        if(new_carry == NULL) {
+            perror("Error allocating memory for input line");
+            return false;
+        }
+        stream->carry = new_carry;
+        stream->carry_capacity = new_capacity;
+    }
+    memcpy(stream->carry + stream->carry_len, data, data_len);
+    stream->carry_len += data_len;
+    return true;
+}
+
+bool try_reading_stream_line(input_stream_t* stream, const char** line, size_t* line_len) {
+
+    // The previously returned line is no longer needed
+    stream->carry_len = 0;
+
+    while(true) {
+        if(stream->holding_slot && stream->slot_pos == stream->slot_sizes[stream->consume_index]) {
+            release_consumed_slot(stream);
+        }
+
+        if(!stream->holding_slot) {
+            pthread_mutex_lock(&stream->lock);
+            while(stream->filled_cnt == 0 && !stream->finished) {
+                pthread_cond_wait(&stream->slot_filled, &stream->lock);
+            }
+            bool drained = (stream->filled_cnt == 0);
+            bool failed = stream->failed;
+            pthread_mutex_unlock(&stream->lock);
+            if(drained) {
+                // A last line without '\n' may still be in the carry
+                if(stream->carry_len > 0 && !failed) {
+                    *line = stream->carry;
+                    *line_len = stream->carry_len;
+                    return true;
+                }
+                return false;
+            }
+            stream->holding_slot = true;
+            stream->slot_pos = 0;
+        }
+
+        const char* slot = stream->slots[stream->consume_index];
+        const char* start = slot + stream->slot_pos;
+        size_t remaining = stream->slot_sizes[stream->consume_index] - stream->slot_pos;
+        const char* newline = memchr(start, '\n', remaining);
+        if(newline != NULL) {
+            size_t part_len = (size_t)(newline + 1 - start);
+            stream->slot_pos += part_len;
+            if(stream->carry_len == 0) {
+                // Common case: the line lies inside one slot and is returned in place
+                *line = start;
+                *line_len = part_len;
+                return true;
+            }
+            if(!try_appending_to_carry(stream, start, part_len)) {
+                mark_stream_failed(stream);
+                return false;
+            }
+            *line = stream->carry;
+            *line_len = stream->carry_len;
+            return true;
+        }
+
+        if(!try_appending_to_carry(stream, start, remaining)) {
+            mark_stream_failed(stream);
+            return false;
+        }
+        stream->slot_pos += remaining;
+    }
+}
+
+bool input_stream_failed(input_stream_t* stream) {
+    pthread_mutex_lock(&stream->lock);
+    bool failed = stream->failed;
+    pthread_mutex_unlock(&stream->lock);
+    return failed;
+}
+
+void close_input_stream(input_stream_t* stream) {
+
+    if(stream == NULL) {
+        return;
+    }
+    if(stream->thread_started) {
+        pthread_mutex_lock(&stream->lock);
+        stream->stopping = true;
+        pthread_cond_signal(&stream->slot_freed);
+        pthread_mutex_unlock(&stream->lock);
+        pthread_join(stream->thread, NULL);
+    }
+    // zlib keeps an input and an output buffer of GZIP_BUFFER_SIZE
+    size_t decoder_bytes = (stream->gz != NULL) ? 2 * GZIP_BUFFER_SIZE : 0;
+#ifdef HAVE_ZSTD
+    if(stream->gz == NULL) {
+        decoder_bytes = stream->compressed_capacity;
+    }
+#endif
+    mem_stats_record("stream buffers", INPUT_STREAM_SLOT_CNT * INPUT_STREAM_SLOT_SIZE
+                                       + decoder_bytes + stream->carry_capacity);
+    close_decoder(stream);
+    for(size_t i=0; i<INPUT_STREAM_SLOT_CNT; ++i) {
+        free(stream->slots[i]);
+    }
+    free(stream->carry);
+    pthread_mutex_destroy(&stream->lock);
+    pthread_cond_destroy(&stream->slot_filled);
+    pthread_cond_destroy(&stream->slot_freed);
+    free(stream);
+}
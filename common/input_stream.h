@@ -0,0 +1,71 @@
+#ifndef AOC_INPUT_STREAM_H
+#define AOC_INPUT_STREAM_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "input.h"
+
+// Compressed Input Streams
+// ################################################
+//
+// gzip (zlib) and zstd (only if built with HAVE_ZSTD) inputs are detected by
+// their magic bytes and decompressed on a separate thread into a small ring
+// of buffers, so decompression overlaps parsing and the decompressed input
+// never exists as a whole, neither on disk nor in memory.
+
+#define INPUT_STREAM_SLOT_CNT (4)
+#define INPUT_STREAM_SLOT_SIZE (256 * 1024)
+
+typedef enum {
+    INPUT_FORMAT_PLAIN = 0,
+    INPUT_FORMAT_GZIP,
+    INPUT_FORMAT_ZSTD
+} input_format_t;
+
+typedef struct input_stream input_stream_t;
+
+bool try_detecting_input_format(const char* file_name, input_format_t* format);
+const char* input_format_name(input_format_t format);
+
+// Starts the decompression thread, format must not be INPUT_FORMAT_PLAIN
+bool try_opening_input_stream(const char* file_name, input_format_t format, input_stream_t** stream);
+// Returns the next line including its '\n' (if any), valid until the next call.
+// Returns false at the end of the stream or on a decompression error.
+bool try_reading_stream_line(input_stream_t* stream, const char** line, size_t* line_len);
+// True if decompression failed (the error has already been reported)
+bool input_stream_failed(input_stream_t* stream);
+void close_input_stream(input_stream_t* stream);
+
+// Line Readers
+// ################################################
+//
+// Lets a parser consume lines without knowing if they come from an in-memory
+// buffer or from a decompression stream.
+
+typedef struct {
+    const char* cursor;
+    const char* end;
+    input_stream_t* stream;     // NULL: read from [cursor, end)
+} line_reader_t;
+
+static inline void init_buffer_line_reader(line_reader_t* reader, const char* input, size_t input_size) {
+    reader->cursor = input;
+    reader->end = input + input_size;
+    reader->stream = NULL;
+}
+
+static inline void init_stream_line_reader(line_reader_t* reader, input_stream_t* stream) {
+    reader->cursor = NULL;
+    reader->end = NULL;
+    reader->stream = stream;
+}
+
+static inline bool read_line(line_reader_t* reader, const char** line, size_t* line_len) {
+    if(reader->stream == NULL) {
+        return next_line(&reader->cursor, reader->end, line, line_len);
+    }
+    return try_reading_stream_line(reader->stream, line, line_len);
+}
+
+#endif
@@ -0,0 +1,125 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/resource.h>   // getrusage
+
+#include "mem_stats.h"
+
+// Definitions
+// ################################################
+
+#define BYTES_PER_KIB (1024)
+
+typedef struct {
+    const char* name;
+    size_t bytes;
+} mem_stats_entry_t;
+
+// Solvers may record from worker threads
+static pthread_mutex_t registry_lock = PTHREAD_MUTEX_INITIALIZER;
+static mem_stats_entry_t registry[MEM_STATS_MAX_ENTRIES];
+static size_t registry_cnt = 0;
+
+// Helper Functions
+// ################################################
+
+// VmHWM of /proc/self/status, resettable via clear_refs (unlike ru_maxrss)
+static bool try_reading_vm_hwm(int64_t* bytes) {
+
+    FILE* status = fopen("/proc/self/status", "r");
+    if(status == NULL) {
+        return false;
+    }
+    char line[256];
+    bool found = false;
+    while(!found && fgets(line, sizeof(line), status) != NULL) {
+        long kib;
+        if(sscanf(line, "VmHWM: %ld kB", &kib) == 1) {
+            *bytes = (int64_t)kib * BYTES_PER_KIB;
+            found = true;
+        }
+    }
+    fclose(status);
+    return found;
+}
+
+// Memory Statistics
+// ################################################
+
+void mem_stats_record(const char* name, size_t bytes) {
+
+    pthread_mutex_lock(&registry_lock);
+    size_t i = 0;
+    while(i < registry_cnt && strcmp(registry[i].name, name) != 0) {
+        i++;
+    }
+    if(i == registry_cnt && registry_cnt < MEM_STATS_MAX_ENTRIES) {
+        registry[i].name = name;
+        registry[i].bytes = 0;
+        registry_cnt++;
+    }
+    if(i < registry_cnt && bytes > registry[i].bytes) {
+        registry[i].bytes = bytes;
+    }
+    pthread_mutex_unlock(&registry_lock);
+}
+
+void mem_stats_reset(void) {
+
+    pthread_mutex_lock(&registry_lock);
+    registry_cnt = 0;
+    pthread_mutex_unlock(&registry_lock);
+
+    // "5" resets VmHWM to the current RSS (Linux 4.0+), ignored elsewhere
+    FILE* clear_refs = fopen("/proc/self/clear_refs", "w");
+    if(clear_refs != NULL) {
+        fputs("5", clear_refs);
+        fclose(clear_refs);
+    }
+}
+
+size_t mem_stats_entries_cnt(void) {
+    pthread_mutex_lock(&registry_lock);
+    size_t cnt = registry_cnt;
+    pthread_mutex_unlock(&registry_lock);
+    return cnt;
+}
+
+bool mem_stats_entry(size_t index, const char** name, size_t* bytes) {
+    pthread_mutex_lock(&registry_lock);
+    bool exists = index < registry_cnt;
+    if(exists) {
+        *name = registry[index].name;
+        *bytes = registry[index].bytes;
+    }
+    pthread_mutex_unlock(&registry_lock);
+    return exists;
+}
+
+int64_t peak_rss_bytes(void) {
+
+    int64_t bytes;
+    if(try_reading_vm_hwm(&bytes)) {
+        return bytes;
+    }
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+    // ru_maxrss is in KiB on Linux
+    return (int64_t)usage.ru_maxrss * BYTES_PER_KIB;
+}
+
+void print_mem_stats(FILE* stream) {
+
+    int64_t peak = peak_rss_bytes();
+    if(peak >= 0) {
+        fprintf(stream, "Peak RSS: %ld KiB\n", (long)(peak / BYTES_PER_KIB));
+    }
+    const char* name;
+    size_t bytes;
+    for(size_t i=0; mem_stats_entry(i, &name, &bytes); ++i) {
+        fprintf(stream, "  %-24s %10zu KiB\n", name, (bytes + BYTES_PER_KIB - 1) / BYTES_PER_KIB);
+    }
+}
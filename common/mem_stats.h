@@ -0,0 +1,31 @@
+#ifndef AOC_MEM_STATS_H
+#define AOC_MEM_STATS_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Memory Statistics
+// ################################################
+//
+// Peak RSS of the process plus a small registry of the bytes held by the
+// major structures of a solver. Solvers report a structure once it has
+// reached its full size; the registry keeps the largest value per name until
+// mem_stats_reset(). Names must be string literals (they are not copied).
+
+#define MEM_STATS_MAX_ENTRIES (32)
+
+void mem_stats_record(const char* name, size_t bytes);
+// Clears the registry and, where the kernel allows it, the peak RSS
+void mem_stats_reset(void);
+size_t mem_stats_entries_cnt(void);
+bool mem_stats_entry(size_t index, const char** name, size_t* bytes);
+
+// Peak resident set size in bytes (VmHWM, getrusage as fallback), -1 if unknown
+int64_t peak_rss_bytes(void);
+
+// "Peak RSS" line followed by one line per structure
+void print_mem_stats(FILE* stream);
+
+#endif
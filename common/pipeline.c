@@ -0,0 +1,223 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>    // pthread_create
+#include <sched.h>      // sched_yield
+
+#include "pipeline.h"
+#include "spsc_ring.h"
+#include "utils.h"
+#include "mem_stats.h"
+
+// Definitions
+// ################################################
+
+#define INITIAL_TEXT_CAPACITY (64 * 1024)
+
+typedef struct {
+    const pipeline_stages_t* stages;
+    spsc_ring_t to_parser;
+    spsc_ring_t to_solver;
+    spsc_ring_t to_reader;      // Free batches
+    void* to_parser_slots[PIPELINE_BATCH_CNT];
+    void* to_solver_slots[PIPELINE_BATCH_CNT];
+    void* to_reader_slots[PIPELINE_BATCH_CNT];
+    atomic_bool failed;
+    int64_t parser_us;
+    int64_t solver_us;
+} pipeline_t;
+
+// Helper Functions
+// ################################################
+
+// Waits for a batch, false if another stage failed meanwhile
+static bool try_taking_batch(pipeline_t* pipeline, spsc_ring_t* ring, pipeline_batch_t** batch) {
+    void* item;
+    while(!spsc_try_pop(ring, &item)) {
+        if(atomic_load(&pipeline->failed)) {
+            return false;
+        }
+        sched_yield();
+    }
+    *batch = (pipeline_batch_t*)item;
+    return true;
+}
+
+// The rings hold every batch at once, so a push only waits if the pipeline is misused
+static void pass_batch(spsc_ring_t* ring, pipeline_batch_t* batch) {
+    while(!spsc_try_push(ring, batch)) {
+        sched_yield();
+    }
+}
+
+static void fail_pipeline(pipeline_t* pipeline) {
+    atomic_store(&pipeline->failed, true);
+}
+
+// Copies the next lines of the reader into batch, an empty batch marks the end
+static bool try_filling_batch(line_reader_t* reader, pipeline_batch_t* batch, size_t* line_number) {
+
+    batch->lines_cnt = 0;
+    batch->text_len = 0;
+    batch->first_line_number = *line_number;
+    const char* line;
+    size_t line_len;
+    while(batch->lines_cnt < PIPELINE_BATCH_LINES && read_line(reader, &line, &line_len)) {
+        if(batch->text_len + line_len > batch->text_capacity) {
+            size_t new_capacity = batch->text_capacity * 2;
+            while(new_capacity < batch->text_len + line_len) {
+                new_capacity *= 2;
+            }
+            char* grown_text = realloc(batch->text, new_capacity);
+            if(grown_text == NULL) {
+                perror("Error allocating memory for pipeline batch");
+                return false;
+            }
+            batch->text = grown_text;
+            batch->text_capacity = new_capacity;
+        }
+        memcpy(batch->text + batch->text_len, line, line_len);
+        batch->line_lens[batch->lines_cnt] = line_len;
+        batch->text_len += line_len;
+        batch->lines_cnt++;
+    }
+
+    // The text may have moved while growing, so the line pointers are set last
+    const char* cursor = batch->text;
+    for(size_t i=0; i<batch->lines_cnt; ++i) {
+        batch->lines[i] = cursor;
+        cursor += batch->line_lens[i];
+    }
+    *line_number += batch->lines_cnt;
+    return true;
+}
+
+// Stages
+// ################################################
+
+static void* run_parser_stage(void* arg) {
+
+    pipeline_t* pipeline = (pipeline_t*)arg;
+    pipeline_batch_t* batch;
+    while(try_taking_batch(pipeline, &pipeline->to_parser, &batch)) {
+        if(batch->lines_cnt > 0) {
+            int64_t start = micros();
+            bool parsed = pipeline->stages->parse(pipeline->stages->context, batch);
+            pipeline->parser_us += micros() - start;
+            if(!parsed) {
+                fail_pipeline(pipeline);
+                break;
+            }
+        }
+        pass_batch(&pipeline->to_solver, batch);
+        if(batch->lines_cnt == 0) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+static void* run_solver_stage(void* arg) {
+
+    pipeline_t* pipeline = (pipeline_t*)arg;
+    pipeline_batch_t* batch;
+    while(try_taking_batch(pipeline, &pipeline->to_solver, &batch)) {
+        if(batch->lines_cnt == 0) {
+            break;
+        }
+        int64_t start = micros();
+        bool solved = pipeline->stages->solve(pipeline->stages->context, batch);
+        pipeline->solver_us += micros() - start;
+        if(!solved) {
+            fail_pipeline(pipeline);
+            break;
+        }
+        pass_batch(&pipeline->to_reader, batch);
+    }
+    return NULL;
+}
+
+// Pipeline
+// ################################################
+
+bool try_running_pipeline(line_reader_t* reader, const pipeline_stages_t* stages, pipeline_stats_t* stats) {
+
+    int64_t wall_start = micros();
+    pipeline_t* pipeline = calloc(1, sizeof(pipeline_t));
+    pipeline_batch_t* batches = calloc(PIPELINE_BATCH_CNT, sizeof(pipeline_batch_t));
+    if(pipeline == NULL || batches == NULL) {
+        perror("Error allocating memory for pipeline");
+        free(pipeline);
+        free(batches);
+        return false;
+    }
+    pipeline->stages = stages;
+    atomic_init(&pipeline->failed, false);
+    init_spsc_ring(&pipeline->to_parser, pipeline->to_parser_slots, PIPELINE_BATCH_CNT);
+    init_spsc_ring(&pipeline->to_solver, pipeline->to_solver_slots, PIPELINE_BATCH_CNT);
+    init_spsc_ring(&pipeline->to_reader, pipeline->to_reader_slots, PIPELINE_BATCH_CNT);
+
+    bool successful = true;
+    size_t parsed_bytes = stages->parsed_item_size * PIPELINE_BATCH_LINES;
+    for(size_t i=0; i<PIPELINE_BATCH_CNT && successful; ++i) {
+        batches[i].parsed = malloc(parsed_bytes > 0 ? parsed_bytes : 1);
+        batches[i].text = malloc(INITIAL_TEXT_CAPACITY);
+        batches[i].text_capacity = INITIAL_TEXT_CAPACITY;
+        successful = batches[i].parsed != NULL && batches[i].text != NULL;
+        // Every batch starts out free, before the solver thread becomes the producer of this ring
+        pass_batch(&pipeline->to_reader, &batches[i]);
+    }
+    if(!successful) {
+        perror("Error allocating memory for pipeline batches");
+    }
+    mem_stats_record("pipeline batches", PIPELINE_BATCH_CNT * (sizeof(pipeline_batch_t) + parsed_bytes + INITIAL_TEXT_CAPACITY));
+
+    pthread_t parser_thread;
+    pthread_t solver_thread;
+    bool parser_started = successful && pthread_create(&parser_thread, NULL, run_parser_stage, pipeline) == 0;
+    bool solver_started = parser_started && pthread_create(&solver_thread, NULL, run_solver_stage, pipeline) == 0;
+    if(successful && !solver_started) {
+        perror("Error creating pipeline thread");
+        fail_pipeline(pipeline);
+        successful = false;
+    }
+
+    // Reader stage on the calling thread
+    int64_t reader_us = 0;
+    size_t line_number = 0;
+    pipeline_batch_t* batch;
+    while(successful && try_taking_batch(pipeline, &pipeline->to_reader, &batch)) {
+        int64_t start = micros();
+        bool filled = try_filling_batch(reader, batch, &line_number);
+        reader_us += micros() - start;
+        if(!filled) {
+            fail_pipeline(pipeline);
+            break;
+        }
+        pass_batch(&pipeline->to_parser, batch);
+        if(batch->lines_cnt == 0) {
+            break;
+        }
+    }
+
+    if(parser_started) {
+        pthread_join(parser_thread, NULL);
+    }
+    if(solver_started) {
+        pthread_join(solver_thread, NULL);
+    }
+    successful = successful && !atomic_load(&pipeline->failed);
+
+    stats->reader_us = reader_us;
+    stats->parser_us = pipeline->parser_us;
+    stats->solver_us = pipeline->solver_us;
+    stats->wall_us = micros() - wall_start;
+
+    for(size_t i=0; i<PIPELINE_BATCH_CNT; ++i) {
+        free(batches[i].parsed);
+        free(batches[i].text);
+    }
+    free(batches);
+    free(pipeline);
+    return successful;
+}
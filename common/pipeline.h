@@ -0,0 +1,53 @@
+#ifndef AOC_PIPELINE_H
+#define AOC_PIPELINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "input_stream.h"
+
+// Reader -> Parser -> Solver Pipeline
+// ################################################
+//
+// The calling thread reads lines into batches, a parser thread and a solver
+// thread run the day's stage functions on them. Batches travel through
+// bounded SPSC rings (spsc_ring.h) and come back to the reader through a
+// third ring, so a slow stage stalls the ones in front of it instead of
+// letting batches pile up. The solver stage sees the batches in input order.
+
+#define PIPELINE_BATCH_CNT (8)
+#define PIPELINE_BATCH_LINES (1024)
+
+typedef struct {
+    size_t lines_cnt;
+    size_t first_line_number;       // 0-based index of the first line in the input
+    const char* lines[PIPELINE_BATCH_LINES];
+    size_t line_lens[PIPELINE_BATCH_LINES];
+    void* parsed;                   // parsed_item_size * PIPELINE_BATCH_LINES bytes for the parser stage
+    // Line copies, lines[] point into it
+    char* text;
+    size_t text_len;
+    size_t text_capacity;
+} pipeline_batch_t;
+
+typedef struct {
+    void* context;
+    size_t parsed_item_size;
+    // Both run on their own thread, returning false stops the pipeline
+    bool (*parse)(void* context, pipeline_batch_t* batch);
+    bool (*solve)(void* context, const pipeline_batch_t* batch);
+} pipeline_stages_t;
+
+// Busy time per stage (waiting excluded) and wall time of the whole run;
+// a wall time below the sum of the stages is the overlap gained
+typedef struct {
+    int64_t reader_us;
+    int64_t parser_us;
+    int64_t solver_us;
+    int64_t wall_us;
+} pipeline_stats_t;
+
+bool try_running_pipeline(line_reader_t* reader, const pipeline_stages_t* stages, pipeline_stats_t* stats);
+
+#endif
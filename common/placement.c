@@ -0,0 +1,149 @@
+// cpu_set_t and sched_setaffinity are GNU extensions
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>    // pthread_once
+#include <sched.h>      // sched_getaffinity
+
+#include "placement.h"
+
+// Definitions
+// ################################################
+
+#define NODE_CPULIST_FORMAT "/sys/devices/system/node/node%zu/cpulist"
+#define CPULIST_MAX_LEN (4096)
+
+// Allowed CPUs grouped by node: node n owns cpus[node_first[n], node_first[n+1])
+typedef struct {
+    size_t nodes_cnt;
+    size_t cpus_cnt;
+    size_t node_first[PLACEMENT_MAX_NODES + 1];
+    int cpus[PLACEMENT_MAX_CPUS];
+} cpu_topology_t;
+
+static pthread_once_t topology_once = PTHREAD_ONCE_INIT;
+static cpu_topology_t topology;
+
+// Helper Functions
+// ################################################
+
+// Appends the allowed CPUs of a cpulist like "0-3,8-11" that are not taken yet
+static void add_cpulist(const char* cpulist, const cpu_set_t* allowed, bool* taken) {
+
+    const char* cursor = cpulist;
+    while(*cursor != '\0' && *cursor != '\n') {
+        char* end;
+        long first = strtol(cursor, &end, 10);
+        if(end == cursor) {
+            return;
+        }
+        long last = first;
+        cursor = end;
+        if(*cursor == '-') {
+            last = strtol(cursor + 1, &end, 10);
+            cursor = end;
+        }
+        for(long cpu=first; cpu<=last && cpu<PLACEMENT_MAX_CPUS; ++cpu) {
+            if(cpu >= 0 && CPU_ISSET((size_t)cpu, allowed) && !taken[cpu] && topology.cpus_cnt < PLACEMENT_MAX_CPUS) {
+                taken[cpu] = true;
+                topology.cpus[topology.cpus_cnt++] = (int)cpu;
+            }
+        }
+        if(*cursor == ',') {
+            cursor++;
+        }
+    }
+}
+
+static void load_topology(void) {
+
+    memset(&topology, 0, sizeof(topology));
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if(sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return;
+    }
+
+    bool taken[PLACEMENT_MAX_CPUS] = {false};
+    char cpulist[CPULIST_MAX_LEN];
+    for(size_t node=0; node<PLACEMENT_MAX_NODES; ++node) {
+        char path[64];
+        snprintf(path, sizeof(path), NODE_CPULIST_FORMAT, node);
+        FILE* file = fopen(path, "r");
+        if(file == NULL) {
+            // Node ids are dense on all machines we run on, the first gap ends the scan
+            break;
+        }
+        bool has_list = fgets(cpulist, sizeof(cpulist), file) != NULL;
+        fclose(file);
+        size_t cpus_before = topology.cpus_cnt;
+        if(has_list) {
+            add_cpulist(cpulist, &allowed, taken);
+        }
+        // Nodes without allowed CPUs (memory only, or outside our cpuset) are skipped
+        if(topology.cpus_cnt > cpus_before) {
+            topology.node_first[topology.nodes_cnt] = cpus_before;
+            topology.nodes_cnt++;
+        }
+    }
+
+    // No NUMA information: every allowed CPU on one node
+    if(topology.nodes_cnt == 0) {
+        for(size_t cpu=0; cpu<PLACEMENT_MAX_CPUS; ++cpu) {
+            if(CPU_ISSET(cpu, &allowed)) {
+                topology.cpus[topology.cpus_cnt++] = (int)cpu;
+            }
+        }
+        topology.nodes_cnt = (topology.cpus_cnt > 0) ? 1 : 0;
+    }
+    topology.node_first[topology.nodes_cnt] = topology.cpus_cnt;
+}
+
+// Placement
+// ################################################
+
+bool try_parsing_placement_policy(const char* name, placement_policy_t* policy) {
+    if(strcmp(name, "none") == 0) {
+        *policy = PLACEMENT_NONE;
+    } else if(strcmp(name, "compact") == 0) {
+        *policy = PLACEMENT_COMPACT;
+    } else if(strcmp(name, "spread") == 0) {
+        *policy = PLACEMENT_SPREAD;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+int placement_cpu_for_worker(placement_policy_t policy, size_t worker) {
+
+    if(policy == PLACEMENT_NONE) {
+        return -1;
+    }
+    pthread_once(&topology_once, load_topology);
+    if(topology.cpus_cnt == 0) {
+        return -1;
+    }
+
+    if(policy == PLACEMENT_COMPACT) {
+        return topology.cpus[worker % topology.cpus_cnt];
+    }
+    size_t node = worker % topology.nodes_cnt;
+    size_t node_cpus_cnt = topology.node_first[node+1] - topology.node_first[node];
+    return topology.cpus[topology.node_first[node] + (worker / topology.nodes_cnt) % node_cpus_cnt];
+}
+
+void pin_current_thread(int cpu) {
+
+    if(cpu < 0) {
+        return;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET((size_t)cpu, &set);
+    // pid 0 is the calling thread
+    sched_setaffinity(0, sizeof(set), &set);
+}
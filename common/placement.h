@@ -0,0 +1,33 @@
+#ifndef AOC_PLACEMENT_H
+#define AOC_PLACEMENT_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// Worker Placement
+// ################################################
+//
+// Pins the workers of the parallel modes to CPUs, so that memory a worker
+// touches first (its chunk of a lazily mapped input, its scratch buffers)
+// is allocated on that worker's NUMA node and stays local.
+// The topology is read from /sys/devices/system/node; without it (or on a
+// single node) all allowed CPUs form one node and both policies only pin.
+
+#define PLACEMENT_MAX_CPUS (1024)
+#define PLACEMENT_MAX_NODES (64)
+
+typedef enum {
+    PLACEMENT_NONE = 0,     // Leave scheduling to the kernel
+    PLACEMENT_COMPACT,      // Fill the CPUs of one node before using the next
+    PLACEMENT_SPREAD        // Round-robin over the nodes
+} placement_policy_t;
+
+// Accepts "none", "compact" and "spread"
+bool try_parsing_placement_policy(const char* name, placement_policy_t* policy);
+
+// CPU for the given worker, -1 if the policy does not pin
+int placement_cpu_for_worker(placement_policy_t policy, size_t worker);
+// Pins the calling thread; placement is best effort, so failures are not reported
+void pin_current_thread(int cpu);
+
+#endif
@@ -0,0 +1,361 @@
+// ucontext register names and dladdr/dl_iterate_phdr
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <signal.h>
+#include <ucontext.h>
+#include <fcntl.h>          // open
+#include <unistd.h>         // close
+#include <dlfcn.h>          // dladdr
+#include <elf.h>            // symbol table of the binary
+#include <link.h>           // dl_iterate_phdr
+#include <sys/mman.h>       // mmap
+#include <sys/stat.h>       // fstat
+#include <sys/time.h>       // setitimer
+
+#include "profiler.h"
+
+// Definitions
+// ################################################
+
+#define MICROS_PER_SECOND (1000000)
+#define REPORT_MAX_FUNCTIONS (20)
+#define UNTAGGED_STAGE "(untagged)"
+#define UNKNOWN_FUNCTION "(unknown)"
+
+typedef struct {
+    uintptr_t ip;
+    const char* stage;
+} profile_sample_t;
+
+typedef struct {
+    uintptr_t start;
+    uintptr_t end;
+    const char* name;
+} function_symbol_t;
+
+// Function symbols of the binary, names point into its mapping
+typedef struct {
+    void* mapping;
+    size_t mapping_size;
+    function_symbol_t* symbols;
+    size_t symbols_cnt;
+} symbol_table_t;
+
+typedef struct {
+    const char* name;
+    size_t samples_cnt;
+} profile_entry_t;
+
+// Written by the signal handler: a slot is claimed with one fetch_add
+static profile_sample_t samples[PROFILER_MAX_SAMPLES];
+static atomic_size_t samples_cnt = 0;
+static _Thread_local const char* volatile current_stage = NULL;
+static bool running = false;
+static bool ran = false;
+static long sampling_hz = 0;
+
+// Sampling
+// ################################################
+
+static uintptr_t interrupted_ip(const void* context) {
+    const ucontext_t* ucontext = (const ucontext_t*)context;
+#if defined(__x86_64__)
+    return (uintptr_t)ucontext->uc_mcontext.gregs[REG_RIP];
+#elif defined(__aarch64__)
+    return (uintptr_t)ucontext->uc_mcontext.pc;
+#else
+    (void)ucontext;
+    return 0;   // Stage tags only
+#endif
+}
+
+static void handle_sigprof(int signal_number, siginfo_t* info, void* context) {
+    (void)signal_number;
+    (void)info;
+    size_t slot = atomic_fetch_add_explicit(&samples_cnt, 1, memory_order_relaxed);
+    if(slot < PROFILER_MAX_SAMPLES) {
+        samples[slot].ip = interrupted_ip(context);
+        samples[slot].stage = current_stage;
+    }
+}
+
+const char* profiler_enter_stage(const char* stage) {
+    const char* previous_stage = current_stage;
+    current_stage = stage;
+    return previous_stage;
+}
+
+void profiler_exit_stage(const char* previous_stage) {
+    current_stage = previous_stage;
+}
+
+bool try_starting_profiler_from_env(void) {
+
+    const char* value = getenv(PROFILER_ENV);
+    if(value == NULL || *value == '\0' || running) {
+        return true;
+    }
+    char* end = NULL;
+    long hz = strtol(value, &end, 10);
+    if(end == value || *end != '\0' || hz < 0 || hz > PROFILER_MAX_HZ) {
+        fprintf(stderr, "Error: Invalid %s \"%s\" (sampling rate in Hz, 1 = %d Hz, at most %d)\n",
+                PROFILER_ENV, value, PROFILER_DEFAULT_HZ, PROFILER_MAX_HZ);
+        return false;
+    }
+    if(hz == 0) {
+        return true;
+    }
+    sampling_hz = (hz == 1) ? PROFILER_DEFAULT_HZ : hz;
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = handle_sigprof;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if(sigaction(SIGPROF, &action, NULL) == -1) {
+        perror("Error installing the profiling signal handler");
+        return false;
+    }
+    long interval_us = MICROS_PER_SECOND / sampling_hz;
+    struct itimerval timer = {
+        .it_interval = {interval_us / MICROS_PER_SECOND, interval_us % MICROS_PER_SECOND},
+        .it_value = {interval_us / MICROS_PER_SECOND, interval_us % MICROS_PER_SECOND}
+    };
+    if(setitimer(ITIMER_PROF, &timer, NULL) == -1) {
+        perror("Error arming the profiling timer");
+        signal(SIGPROF, SIG_DFL);
+        return false;
+    }
+    running = true;
+    ran = true;
+    return true;
+}
+
+static void stop_profiler(void) {
+    if(!running) {
+        return;
+    }
+    struct itimerval disarmed;
+    memset(&disarmed, 0, sizeof(disarmed));
+    setitimer(ITIMER_PROF, &disarmed, NULL);
+    // A signal still pending is dropped instead of terminating the process
+    signal(SIGPROF, SIG_IGN);
+    running = false;
+}
+
+// Symbolization
+// ################################################
+
+// The main program comes first; its load bias turns symbol values into addresses
+static int find_program_bias(struct dl_phdr_info* info, size_t size, void* data) {
+    (void)size;
+    *(uintptr_t*)data = (uintptr_t)info->dlpi_addr;
+    return 1;
+}
+
+static int compare_symbols(const void* a, const void* b) {
+    const function_symbol_t* x = (const function_symbol_t*)a;
+    const function_symbol_t* y = (const function_symbol_t*)b;
+    return (x->start > y->start) - (x->start < y->start);
+}
+
+// Reads the function symbols from the .symtab of /proc/self/exe (stripped binaries have none)
+static void load_symbol_table(symbol_table_t* table) {
+
+    memset(table, 0, sizeof(*table));
+    int fd = open("/proc/self/exe", O_RDONLY);
+    if(fd == -1) {
+        return;
+    }
+    struct stat file_stat;
+    if(fstat(fd, &file_stat) == -1 || (size_t)file_stat.st_size < sizeof(Elf64_Ehdr)) {
+        close(fd);
+        return;
+    }
+    size_t file_size = (size_t)file_stat.st_size;
+    void* mapping = mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(mapping == MAP_FAILED) {
+        return;
+    }
+    table->mapping = mapping;
+    table->mapping_size = file_size;
+
+    const char* file = (const char*)mapping;
+    const Elf64_Ehdr* elf_header = (const Elf64_Ehdr*)mapping;
+    if(memcmp(elf_header->e_ident, ELFMAG, SELFMAG) != 0 || elf_header->e_ident[EI_CLASS] != ELFCLASS64
+    || elf_header->e_shentsize != sizeof(Elf64_Shdr)
+    || elf_header->e_shoff > file_size
+    || (size_t)elf_header->e_shnum * sizeof(Elf64_Shdr) > file_size - elf_header->e_shoff) {
+        return;
+    }
+    const Elf64_Shdr* sections = (const Elf64_Shdr*)(const void*)(file + elf_header->e_shoff);
+
+    uintptr_t bias = 0;
+    dl_iterate_phdr(find_program_bias, &bias);
+
+    for(size_t i=0; i<elf_header->e_shnum; ++i) {
+        const Elf64_Shdr* symtab = &sections[i];
+        if(symtab->sh_type != SHT_SYMTAB || symtab->sh_link >= elf_header->e_shnum
+        || symtab->sh_offset > file_size || symtab->sh_size > file_size - symtab->sh_offset) {
+            continue;
+        }
+        const Elf64_Shdr* strtab = &sections[symtab->sh_link];
+        if(strtab->sh_offset > file_size || strtab->sh_size > file_size - strtab->sh_offset) {
+            continue;
+        }
+        const Elf64_Sym* symbols = (const Elf64_Sym*)(const void*)(file + symtab->sh_offset);
+        size_t symbols_cnt = symtab->sh_size / sizeof(Elf64_Sym);
+        table->symbols = malloc((symbols_cnt > 0 ? symbols_cnt : 1) * sizeof(function_symbol_t));
+        if(table->symbols == NULL) {
+            return;
+        }
+        for(size_t j=0; j<symbols_cnt; ++j) {
+            const Elf64_Sym* symbol = &symbols[j];
+            if(ELF64_ST_TYPE(symbol->st_info) != STT_FUNC || symbol->st_value == 0
+            || symbol->st_name >= strtab->sh_size) {
+                continue;
+            }
+            function_symbol_t* function = &table->symbols[table->symbols_cnt++];
+            function->start = bias + (uintptr_t)symbol->st_value;
+            function->end = function->start + (uintptr_t)symbol->st_size;
+            function->name = file + strtab->sh_offset + symbol->st_name;
+        }
+        qsort(table->symbols, table->symbols_cnt, sizeof(function_symbol_t), compare_symbols);
+        return;
+    }
+}
+
+static void release_symbol_table(symbol_table_t* table) {
+    free(table->symbols);
+    if(table->mapping != NULL) {
+        munmap(table->mapping, table->mapping_size);
+    }
+}
+
+static const char* find_function(const symbol_table_t* table, uintptr_t ip) {
+
+    // Last symbol starting at or before ip
+    size_t low = 0;
+    size_t high = table->symbols_cnt;
+    while(low < high) {
+        size_t middle = low + (high - low) / 2;
+        if(table->symbols[middle].start <= ip) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if(low > 0 && ip < table->symbols[low - 1].end) {
+        return table->symbols[low - 1].name;
+    }
+
+    // Shared libraries export their symbols for dladdr, their internal
+    // functions (e.g. the regex matcher behind regexec) count for the library
+    Dl_info info;
+    if(ip == 0 || dladdr((const void*)ip, &info) == 0) {
+        return UNKNOWN_FUNCTION;
+    }
+    if(info.dli_sname != NULL) {
+        return info.dli_sname;
+    }
+    if(info.dli_fname != NULL && *info.dli_fname != '\0') {
+        const char* base_name = strrchr(info.dli_fname, '/');
+        return base_name != NULL ? base_name + 1 : info.dli_fname;
+    }
+    return UNKNOWN_FUNCTION;
+}
+
+// Report
+// ################################################
+
+static int compare_names(const void* a, const void* b) {
+    return strcmp(*(const char* const*)a, *(const char* const*)b);
+}
+
+static int compare_entries(const void* a, const void* b) {
+    const profile_entry_t* x = (const profile_entry_t*)a;
+    const profile_entry_t* y = (const profile_entry_t*)b;
+    if(x->samples_cnt != y->samples_cnt) {
+        return (x->samples_cnt < y->samples_cnt) - (x->samples_cnt > y->samples_cnt);
+    }
+    return strcmp(x->name, y->name);
+}
+
+// Counts equal names, most frequent first;
+// names and entries both have names_cnt elements, the count of entries is returned
+static size_t count_names(const char** names, size_t names_cnt, profile_entry_t* entries) {
+    qsort(names, names_cnt, sizeof(const char*), compare_names);
+    size_t entries_cnt = 0;
+    for(size_t i=0; i<names_cnt; ++i) {
+        if(entries_cnt == 0 || strcmp(entries[entries_cnt - 1].name, names[i]) != 0) {
+            entries[entries_cnt].name = names[i];
+            entries[entries_cnt].samples_cnt = 0;
+            entries_cnt++;
+        }
+        entries[entries_cnt - 1].samples_cnt++;
+    }
+    qsort(entries, entries_cnt, sizeof(profile_entry_t), compare_entries);
+    return entries_cnt;
+}
+
+static void print_entries(FILE* stream, const char* title, const profile_entry_t* entries,
+                          size_t entries_cnt, size_t total_cnt) {
+    fprintf(stream, "  %-40s %8s %7s\n", title, "samples", "share");
+    for(size_t i=0; i<entries_cnt; ++i) {
+        fprintf(stream, "  %-40.40s %8zu %6.1f%%\n", entries[i].name, entries[i].samples_cnt,
+                100.0 * (double)entries[i].samples_cnt / (double)total_cnt);
+    }
+}
+
+void print_profile(FILE* stream) {
+
+    if(!ran) {
+        return;
+    }
+    stop_profiler();
+
+    size_t taken_cnt = atomic_load(&samples_cnt);
+    size_t stored_cnt = taken_cnt < PROFILER_MAX_SAMPLES ? taken_cnt : PROFILER_MAX_SAMPLES;
+    fprintf(stream, "Profile: %zu samples at up to %ld Hz of CPU time", taken_cnt, sampling_hz);
+    if(stored_cnt < taken_cnt) {
+        fprintf(stream, ", report covers the first %zu", stored_cnt);
+    }
+    fprintf(stream, "\n");
+    if(stored_cnt == 0) {
+        return;
+    }
+
+    const char** names = malloc(stored_cnt * sizeof(const char*));
+    profile_entry_t* entries = malloc(stored_cnt * sizeof(profile_entry_t));
+    if(names == NULL || entries == NULL) {
+        perror("Error allocating memory for the profile");
+        free(names);
+        free(entries);
+        return;
+    }
+
+    symbol_table_t table;
+    load_symbol_table(&table);
+    for(size_t i=0; i<stored_cnt; ++i) {
+        names[i] = find_function(&table, samples[i].ip);
+    }
+    size_t entries_cnt = count_names(names, stored_cnt, entries);
+    print_entries(stream, "function", entries,
+                  entries_cnt < REPORT_MAX_FUNCTIONS ? entries_cnt : REPORT_MAX_FUNCTIONS, stored_cnt);
+
+    for(size_t i=0; i<stored_cnt; ++i) {
+        names[i] = samples[i].stage != NULL ? samples[i].stage : UNTAGGED_STAGE;
+    }
+    entries_cnt = count_names(names, stored_cnt, entries);
+    print_entries(stream, "stage", entries, entries_cnt, stored_cnt);
+
+    release_symbol_table(&table);
+    free(names);
+    free(entries);
+}
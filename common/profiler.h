@@ -0,0 +1,37 @@
+#ifndef AOC_PROFILER_H
+#define AOC_PROFILER_H
+
+#include <stdio.h>
+#include <stdbool.h>
+
+// Sampling Profiler
+// ################################################
+//
+// Opt-in, in-process profiler for when no external one may be attached:
+// AOC_PROFILE=<hz> (AOC_PROFILE=1 for the default rate) makes a SIGPROF
+// timer sample the interrupted instruction pointer and the stage tag of the
+// interrupted thread into a fixed, lock-free buffer. The report at the end
+// of the run attributes the samples to functions (symbol table of the
+// binary, dladdr for shared libraries such as regexec in libc) and to
+// stages. Samples are CPU time of all threads; the kernel tick may cap the
+// rate. Once the buffer is full, further samples are only counted.
+
+#define PROFILER_ENV "AOC_PROFILE"
+#define PROFILER_DEFAULT_HZ (997)   // Prime, so it does not beat with periodic work
+#define PROFILER_MAX_HZ (10000)
+#define PROFILER_MAX_SAMPLES (1 << 18)
+
+// Starts sampling if AOC_PROFILE is set; false only if it is set but invalid
+// or the timer could not be armed (reported)
+bool try_starting_profiler_from_env(void);
+// Stops sampling and prints the hot spots; nothing if it never ran
+void print_profile(FILE* stream);
+
+// Stage tags name what the current thread is doing, so the report can
+// separate e.g. parsing from solving even when both run the same libc
+// functions. Tags must be string literals; the previous tag is restored on
+// exit, so stages nest. Both are a single thread-local store.
+const char* profiler_enter_stage(const char* stage);
+void profiler_exit_stage(const char* previous_stage);
+
+#endif
@@ -0,0 +1,177 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>   // PRIx64
+#include <errno.h>      // errno
+#include <sys/stat.h>   // mkdir
+#include <unistd.h>     // getpid
+#include <stdatomic.h>
+
+#include "hash.h"
+#include "result_cache.h"
+
+// Definitions
+// ################################################
+
+#define RESULT_CACHE_MAGIC "AOCRC001"
+#define RESULT_CACHE_MAGIC_LEN (8)
+
+typedef struct {
+    char magic[RESULT_CACHE_MAGIC_LEN];
+    uint64_t key;
+    uint32_t values_cnt;
+    uint32_t reserved;
+} result_cache_header_t;
+
+// Helper Functions
+// ################################################
+
+static void build_entry_path(char* path, size_t path_size, const char* cache_dir, uint64_t key) {
+    snprintf(path, path_size, "%s/%016" PRIx64 ".res", cache_dir, key);
+}
+
+// Result Cache
+// ################################################
+
+const char* result_cache_dir(void) {
+    const char* dir = getenv(RESULT_CACHE_DIR_ENV);
+    if(dir == NULL || *dir == '\0') {
+        return RESULT_CACHE_DEFAULT_DIR;
+    }
+    return dir;
+}
+
+bool try_computing_cache_key(const char* input_file_name,
+                             const result_cache_key_t* key_info,
+                             uint64_t* key) {
+
+    uint64_t input_hash;
+    if(!try_hashing_file(input_file_name, &input_hash)) {
+        return false;
+    }
+
+    // Mix solver identity into the content hash
+    char identity[256];
+    int identity_len = snprintf(identity, sizeof(identity), "%s|%" PRIu32 "|%s",
+                                key_info->solver_name,
+                                key_info->solver_version,
+                                key_info->mode != NULL ? key_info->mode : "");
+    if(identity_len < 0 || (size_t)identity_len >= sizeof(identity)) {
+        fprintf(stderr, "Error: Cache key identity too long\n");
+        return false;
+    }
+
+    *key = xxh64(identity, (size_t)identity_len, input_hash);
+    return true;
+}
+
+bool try_loading_cached_result(const char* cache_dir,
+                               uint64_t key,
+                               int64_t* values,
+                               size_t values_cnt) {
+
+    char path[4096];
+    build_entry_path(path, sizeof(path), cache_dir, key);
+
+    FILE* file = fopen(path, "rb");
+    if(file == NULL) {
+        return false;
+    }
+
+    bool hit = false;
+    result_cache_header_t header;
+    if(fread(&header, sizeof(header), 1, file) != 1) {
+        goto cleanup;
+    }
+    if(memcmp(header.magic, RESULT_CACHE_MAGIC, RESULT_CACHE_MAGIC_LEN) != 0
+    || header.key != key
+    || header.values_cnt != values_cnt) {
+        goto cleanup;
+    }
+    if(fread(values, sizeof(int64_t), values_cnt, file) != values_cnt) {
+        goto cleanup;
+    }
+    hit = true;
+
+    cleanup:
+        fclose(file);
+        return hit;
+}
+
+bool try_storing_cached_result(const char* cache_dir,
+                               uint64_t key,
+                               const int64_t* values,
+                               size_t values_cnt) {
+
+    if(values_cnt > RESULT_CACHE_MAX_VALUES) {
+        fprintf(stderr, "Error: Too many values for result cache entry\n");
+        return false;
+    }
+
+    if(mkdir(cache_dir, 0755) == -1 && errno != EEXIST) {
+        perror("Error creating cache directory");
+        return false;
+    }
+
+    // Write to a temporary file first, so readers never see partial entries;
+    // the sequence number keeps parallel jobs of one process apart
+    static atomic_ulong temp_sequence = 0;
+    char path[4096];
+    char temp_path[4200];
+    build_entry_path(path, sizeof(path), cache_dir, key);
+    snprintf(temp_path, sizeof(temp_path), "%s.%ld.%lu.tmp", path, (long)getpid(),
+             atomic_fetch_add(&temp_sequence, 1));
+
+    FILE* file = fopen(temp_path, "wb");
+    if(file == NULL) {
+        perror("Error creating cache entry");
+        return false;
+    }
+
+    result_cache_header_t header;
+    memcpy(header.magic, RESULT_CACHE_MAGIC, RESULT_CACHE_MAGIC_LEN);
+    header.key = key;
+    header.values_cnt = (uint32_t)values_cnt;
+    header.reserved = 0;
+
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1
+                && fwrite(values, sizeof(int64_t), values_cnt, file) == values_cnt;
+    if(fclose(file) != 0) {
+        written = false;
+    }
+    if(!written) {
+        fprintf(stderr, "Error writing cache entry %s\n", temp_path);
+        remove(temp_path);
+        return false;
+    }
+
+    if(rename(temp_path, path) == -1) {
+        perror("Error publishing cache entry");
+        remove(temp_path);
+        return false;
+    }
+    return true;
+}
+
+bool result_cache_lookup(const char* input_file_name,
+                         const result_cache_key_t* key_info,
+                         result_cache_slot_t* slot,
+                         int64_t* values,
+                         size_t values_cnt) {
+
+    slot->valid = try_computing_cache_key(input_file_name, key_info, &slot->key);
+    if(!slot->valid) {
+        return false;
+    }
+    return try_loading_cached_result(result_cache_dir(), slot->key, values, values_cnt);
+}
+
+void result_cache_store(const result_cache_slot_t* slot,
+                        const int64_t* values,
+                        size_t values_cnt) {
+
+    if(!slot->valid) {
+        return;
+    }
+    try_storing_cached_result(result_cache_dir(), slot->key, values, values_cnt);
+}
@@ -0,0 +1,62 @@
+#ifndef AOC_RESULT_CACHE_H
+#define AOC_RESULT_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Persistent result cache
+// ################################################
+//
+// Results are stored per (input content, solver, version, mode) in one small
+// file per entry. The key is derived from an xxh64 hash of the input file, so
+// a cache hit never has to parse the input.
+
+#define RESULT_CACHE_DIR_ENV "AOC_CACHE_DIR"
+#define RESULT_CACHE_DEFAULT_DIR ".result_cache"
+#define RESULT_CACHE_MAX_VALUES (8)
+
+typedef struct {
+    const char* solver_name;
+    uint32_t solver_version;
+    const char* mode;
+} result_cache_key_t;
+
+// Key of a looked up entry, so a miss can be filled in after solving
+typedef struct {
+    bool valid;
+    uint64_t key;
+} result_cache_slot_t;
+
+// Directory used for cache entries ($AOC_CACHE_DIR or ".result_cache")
+const char* result_cache_dir(void);
+
+bool try_computing_cache_key(const char* input_file_name,
+                             const result_cache_key_t* key_info,
+                             uint64_t* key);
+
+// Returns true on a hit and fills values[0..values_cnt)
+bool try_loading_cached_result(const char* cache_dir,
+                               uint64_t key,
+                               int64_t* values,
+                               size_t values_cnt);
+
+bool try_storing_cached_result(const char* cache_dir,
+                               uint64_t key,
+                               const int64_t* values,
+                               size_t values_cnt);
+
+// Convenience wrappers used by the day binaries:
+// lookup hashes the input and returns true on a hit,
+// store is a no-op if the lookup could not compute a key
+bool result_cache_lookup(const char* input_file_name,
+                         const result_cache_key_t* key_info,
+                         result_cache_slot_t* slot,
+                         int64_t* values,
+                         size_t values_cnt);
+
+void result_cache_store(const result_cache_slot_t* slot,
+                        const int64_t* values,
+                        size_t values_cnt);
+
+#endif
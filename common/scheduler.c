@@ -0,0 +1,376 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>    // pthread_create
+#include <sched.h>      // sched_yield
+
+#include "scheduler.h"
+
+// Definitions
+// ################################################
+
+#define AUTO_GRAIN_RANGES_PER_WORKER (8)
+#define DEQUE_MASK ((size_t)SCHEDULER_DEQUE_CAPACITY - 1)
+
+typedef struct {
+    size_t begin;
+    size_t end;
+} range_task_t;
+
+// Chase-Lev deque: the owner pushes and takes at bottom, thieves steal at top
+typedef struct {
+    _Alignas(64) _Atomic int64_t top;
+    _Alignas(64) _Atomic int64_t bottom;
+    _Atomic(range_task_t*) slots[SCHEDULER_DEQUE_CAPACITY];
+} work_deque_t;
+
+typedef struct {
+    size_t grain;
+    parallel_body_t body;
+    reduce_body_t reduce_body;      // Set instead of body for reductions
+    void* context;
+    char* partials;                 // worker_cnt * partial_size
+    size_t partial_size;
+
+    // Every split takes one task, so items_cnt / grain + 1 tasks are enough
+    range_task_t* tasks;
+    size_t tasks_capacity;
+    atomic_size_t tasks_used;
+
+    atomic_size_t remaining_items;
+    atomic_bool failed;
+} loop_t;
+
+typedef struct {
+    scheduler_t* scheduler;
+    size_t worker;
+} worker_arg_t;
+
+struct scheduler {
+    size_t worker_cnt;
+    placement_policy_t placement;
+    work_deque_t* deques;
+    pthread_t* threads;
+    worker_arg_t* worker_args;
+    size_t started_cnt;
+
+    // Guarded by lock: a new generation hands loop to the sleeping workers
+    pthread_mutex_t lock;
+    pthread_cond_t loop_started;
+    pthread_cond_t loop_finished;
+    uint64_t generation;
+    size_t busy_cnt;
+    bool shutting_down;
+    loop_t* loop;
+};
+
+// Deque
+// ################################################
+
+static bool try_pushing_task(work_deque_t* deque, range_task_t* task) {
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    if(bottom - top >= SCHEDULER_DEQUE_CAPACITY) {
+        return false;
+    }
+    atomic_store_explicit(&deque->slots[(size_t)bottom & DEQUE_MASK], task, memory_order_relaxed);
+    // Publishes the task's range to the thieves
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_release);
+    return true;
+}
+
+// Owner side, NULL if empty or the last task went to a thief
+static range_task_t* take_task(work_deque_t* deque) {
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+    if(top > bottom) {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return NULL;
+    }
+    range_task_t* task = atomic_load_explicit(&deque->slots[(size_t)bottom & DEQUE_MASK], memory_order_relaxed);
+    if(top == bottom) {
+        // Last task: race the thieves for it
+        if(!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                    memory_order_seq_cst, memory_order_relaxed)) {
+            task = NULL;
+        }
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    }
+    return task;
+}
+
+// Thief side, NULL if empty or another thread won the task
+static range_task_t* steal_task(work_deque_t* deque) {
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+    if(top >= bottom) {
+        return NULL;
+    }
+    range_task_t* task = atomic_load_explicit(&deque->slots[(size_t)top & DEQUE_MASK], memory_order_relaxed);
+    if(!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                memory_order_seq_cst, memory_order_relaxed)) {
+        return NULL;
+    }
+    return task;
+}
+
+// Workers
+// ################################################
+
+static range_task_t* allocate_task(loop_t* loop, size_t begin, size_t end) {
+    size_t index = atomic_fetch_add_explicit(&loop->tasks_used, 1, memory_order_relaxed);
+    if(index >= loop->tasks_capacity) {
+        return NULL;
+    }
+    loop->tasks[index].begin = begin;
+    loop->tasks[index].end = end;
+    return &loop->tasks[index];
+}
+
+static void run_range(scheduler_t* scheduler, loop_t* loop, size_t worker, size_t begin, size_t end) {
+
+    // Hand out the upper halves, whatever is not pushed runs here
+    while(end - begin > loop->grain) {
+        size_t middle = begin + (end - begin) / 2;
+        range_task_t* upper = allocate_task(loop, middle, end);
+        if(upper == NULL || !try_pushing_task(&scheduler->deques[worker], upper)) {
+            break;
+        }
+        end = middle;
+    }
+
+    // After a failure the ranges are only counted off
+    if(!atomic_load_explicit(&loop->failed, memory_order_relaxed)) {
+        bool successful;
+        if(loop->reduce_body != NULL) {
+            successful = loop->reduce_body(loop->context, begin, end, loop->partials + worker * loop->partial_size);
+        } else {
+            successful = loop->body(loop->context, begin, end, worker);
+        }
+        if(!successful) {
+            atomic_store_explicit(&loop->failed, true, memory_order_relaxed);
+        }
+    }
+    atomic_fetch_sub_explicit(&loop->remaining_items, end - begin, memory_order_release);
+}
+
+static range_task_t* try_stealing(scheduler_t* scheduler, size_t worker, uint32_t* seed) {
+    // xorshift, so the thieves do not all start at the same victim
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 17;
+    *seed ^= *seed << 5;
+    size_t first_victim = *seed % scheduler->worker_cnt;
+    for(size_t i=0; i<scheduler->worker_cnt; ++i) {
+        size_t victim = (first_victim + i) % scheduler->worker_cnt;
+        if(victim == worker) {
+            continue;
+        }
+        range_task_t* task = steal_task(&scheduler->deques[victim]);
+        if(task != NULL) {
+            return task;
+        }
+    }
+    return NULL;
+}
+
+static void work_on_loop(scheduler_t* scheduler, loop_t* loop, size_t worker) {
+
+    uint32_t seed = (uint32_t)worker * 2654435761u + 1;
+    while(atomic_load_explicit(&loop->remaining_items, memory_order_acquire) > 0) {
+        range_task_t* task = take_task(&scheduler->deques[worker]);
+        if(task == NULL) {
+            task = try_stealing(scheduler, worker, &seed);
+        }
+        if(task == NULL) {
+            sched_yield();
+            continue;
+        }
+        run_range(scheduler, loop, worker, task->begin, task->end);
+    }
+}
+
+static void* run_worker(void* arg) {
+
+    worker_arg_t* worker_arg = (worker_arg_t*)arg;
+    scheduler_t* scheduler = worker_arg->scheduler;
+    pin_current_thread(placement_cpu_for_worker(scheduler->placement, worker_arg->worker));
+
+    uint64_t seen_generation = 0;
+    pthread_mutex_lock(&scheduler->lock);
+    for(;;) {
+        while(scheduler->generation == seen_generation && !scheduler->shutting_down) {
+            pthread_cond_wait(&scheduler->loop_started, &scheduler->lock);
+        }
+        if(scheduler->shutting_down) {
+            break;
+        }
+        seen_generation = scheduler->generation;
+        loop_t* loop = scheduler->loop;
+        pthread_mutex_unlock(&scheduler->lock);
+
+        work_on_loop(scheduler, loop, worker_arg->worker);
+
+        pthread_mutex_lock(&scheduler->lock);
+        scheduler->busy_cnt--;
+        if(scheduler->busy_cnt == 0) {
+            pthread_cond_signal(&scheduler->loop_finished);
+        }
+    }
+    pthread_mutex_unlock(&scheduler->lock);
+    return NULL;
+}
+
+// Scheduler
+// ################################################
+
+bool try_creating_scheduler(size_t worker_cnt, placement_policy_t placement, scheduler_t** scheduler) {
+
+    if(worker_cnt == 0) {
+        worker_cnt = 1;
+    }
+    scheduler_t* s = calloc(1, sizeof(scheduler_t));
+    if(s == NULL) {
+        perror("Error allocating memory for scheduler");
+        return false;
+    }
+    s->worker_cnt = worker_cnt;
+    s->placement = placement;
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->loop_started, NULL);
+    pthread_cond_init(&s->loop_finished, NULL);
+
+    // Own cache lines per deque end, see work_deque_t
+    s->deques = aligned_alloc(_Alignof(work_deque_t), worker_cnt * sizeof(work_deque_t));
+    s->threads = calloc(worker_cnt, sizeof(pthread_t));
+    s->worker_args = calloc(worker_cnt, sizeof(worker_arg_t));
+    if(s->deques == NULL || s->threads == NULL || s->worker_args == NULL) {
+        perror("Error allocating memory for scheduler");
+        destroy_scheduler(s);
+        return false;
+    }
+    for(size_t i=0; i<worker_cnt; ++i) {
+        atomic_init(&s->deques[i].top, 0);
+        atomic_init(&s->deques[i].bottom, 0);
+        s->worker_args[i].scheduler = s;
+        s->worker_args[i].worker = i;
+    }
+
+    // Worker 0 is the thread that starts the loops
+    for(size_t i=1; i<worker_cnt; ++i) {
+        if(pthread_create(&s->threads[i], NULL, run_worker, &s->worker_args[i]) != 0) {
+            perror("Error creating scheduler thread");
+            destroy_scheduler(s);
+            return false;
+        }
+        s->started_cnt++;
+    }
+    *scheduler = s;
+    return true;
+}
+
+void destroy_scheduler(scheduler_t* scheduler) {
+
+    pthread_mutex_lock(&scheduler->lock);
+    scheduler->shutting_down = true;
+    pthread_cond_broadcast(&scheduler->loop_started);
+    pthread_mutex_unlock(&scheduler->lock);
+    for(size_t i=0; i<scheduler->started_cnt; ++i) {
+        pthread_join(scheduler->threads[i+1], NULL);
+    }
+
+    pthread_mutex_destroy(&scheduler->lock);
+    pthread_cond_destroy(&scheduler->loop_started);
+    pthread_cond_destroy(&scheduler->loop_finished);
+    free(scheduler->deques);
+    free(scheduler->threads);
+    free(scheduler->worker_args);
+    free(scheduler);
+}
+
+size_t scheduler_worker_cnt(const scheduler_t* scheduler) {
+    return scheduler->worker_cnt;
+}
+
+static bool try_running_loop(scheduler_t* scheduler, loop_t* loop, size_t items_cnt, size_t grain) {
+
+    if(grain == SCHEDULER_AUTO_GRAIN) {
+        grain = items_cnt / (scheduler->worker_cnt * AUTO_GRAIN_RANGES_PER_WORKER);
+    }
+    loop->grain = grain > 0 ? grain : 1;
+    loop->tasks_capacity = items_cnt / loop->grain + 1;
+    loop->tasks = malloc(loop->tasks_capacity * sizeof(range_task_t));
+    if(loop->tasks == NULL) {
+        perror("Error allocating memory for scheduler tasks");
+        return false;
+    }
+    atomic_init(&loop->tasks_used, 0);
+    atomic_init(&loop->remaining_items, items_cnt);
+    atomic_init(&loop->failed, false);
+
+    // The whole range starts on the caller's deque, the workers steal from there
+    try_pushing_task(&scheduler->deques[0], allocate_task(loop, 0, items_cnt));
+    if(scheduler->started_cnt > 0) {
+        pthread_mutex_lock(&scheduler->lock);
+        scheduler->loop = loop;
+        scheduler->generation++;
+        scheduler->busy_cnt = scheduler->started_cnt;
+        pthread_cond_broadcast(&scheduler->loop_started);
+        pthread_mutex_unlock(&scheduler->lock);
+    }
+
+    work_on_loop(scheduler, loop, 0);
+
+    // The tasks are freed below, so every worker must have left the loop
+    pthread_mutex_lock(&scheduler->lock);
+    while(scheduler->busy_cnt > 0) {
+        pthread_cond_wait(&scheduler->loop_finished, &scheduler->lock);
+    }
+    scheduler->loop = NULL;
+    pthread_mutex_unlock(&scheduler->lock);
+
+    free(loop->tasks);
+    return !atomic_load(&loop->failed);
+}
+
+bool parallel_for(scheduler_t* scheduler, size_t items_cnt, size_t grain,
+                  parallel_body_t body, void* context) {
+
+    if(items_cnt == 0) {
+        return true;
+    }
+    loop_t loop = {0};
+    loop.body = body;
+    loop.context = context;
+    return try_running_loop(scheduler, &loop, items_cnt, grain);
+}
+
+bool parallel_reduce(scheduler_t* scheduler, size_t items_cnt, size_t grain,
+                     reduce_body_t body, void* context,
+                     size_t partial_size, reduce_combine_t combine, void* result) {
+
+    memset(result, 0, partial_size);
+    if(items_cnt == 0) {
+        return true;
+    }
+    loop_t loop = {0};
+    loop.reduce_body = body;
+    loop.context = context;
+    loop.partial_size = partial_size;
+    loop.partials = calloc(scheduler->worker_cnt, partial_size);
+    if(loop.partials == NULL) {
+        perror("Error allocating memory for partial results");
+        return false;
+    }
+
+    bool successful = try_running_loop(scheduler, &loop, items_cnt, grain);
+    for(size_t i=0; i<scheduler->worker_cnt; ++i) {
+        combine(result, loop.partials + i * partial_size);
+    }
+    free(loop.partials);
+    return successful;
+}
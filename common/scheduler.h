@@ -0,0 +1,49 @@
+#ifndef AOC_SCHEDULER_H
+#define AOC_SCHEDULER_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "placement.h"
+
+// Work-Stealing Scheduler
+// ################################################
+//
+// A fixed set of workers shared by all parallel modes. The calling thread
+// takes part as worker 0, the others are started once and sleep between
+// loops. A loop over [0, items_cnt) starts as one range on the caller's
+// deque; whoever runs a range splits it in halves, keeps the lower half and
+// pushes the upper one, until it is at most grain items long. Idle workers
+// steal from the top of the other deques (Chase-Lev), so the oldest and
+// largest ranges move, and a few expensive items cannot leave workers idle.
+
+// Picks a grain of about 8 ranges per worker
+#define SCHEDULER_AUTO_GRAIN (0)
+// Pushes beyond this run inline, so splitting never allocates
+#define SCHEDULER_DEQUE_CAPACITY (256)
+
+typedef struct scheduler scheduler_t;
+
+// Runs items [begin, end) on the given worker; returning false stops the loop
+typedef bool (*parallel_body_t)(void* context, size_t begin, size_t end, size_t worker);
+// Same for reductions, accumulating into the worker's partial result
+typedef bool (*reduce_body_t)(void* context, size_t begin, size_t end, void* partial);
+// Merges from into into; must be associative and commutative
+typedef void (*reduce_combine_t)(void* into, const void* from);
+
+// Starts worker_cnt - 1 threads, pinned according to placement
+bool try_creating_scheduler(size_t worker_cnt, placement_policy_t placement, scheduler_t** scheduler);
+void destroy_scheduler(scheduler_t* scheduler);
+size_t scheduler_worker_cnt(const scheduler_t* scheduler);
+
+// Not reentrant: bodies must not start loops on the same scheduler.
+// False if a body returned false; the remaining items are then skipped.
+bool parallel_for(scheduler_t* scheduler, size_t items_cnt, size_t grain,
+                  parallel_body_t body, void* context);
+// Every worker starts from an all-zero partial of partial_size bytes, which
+// must be the identity of combine; the partials are combined into result
+bool parallel_reduce(scheduler_t* scheduler, size_t items_cnt, size_t grain,
+                     reduce_body_t body, void* context,
+                     size_t partial_size, reduce_combine_t combine, void* result);
+
+#endif
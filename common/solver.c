@@ -0,0 +1,163 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "autotune.h"
+#include "input.h"
+#include "input_stream.h"
+#include "mem_stats.h"
+#include "result_cache.h"
+#include "solver.h"
+
+// Definitions
+// ################################################
+
+#define CACHED_VALUES_CNT (3)
+
+// Solver Helpers
+// ################################################
+
+bool solver_mode_is(const solver_options_t* options, const char* mode) {
+    if(options->mode == NULL) {
+        return strcmp(mode, "default") == 0;
+    }
+    return strcmp(options->mode, mode) == 0;
+}
+
+void warn_about_unsupported_threads(const solver_t* solver, const solver_options_t* options) {
+    if(options->thread_cnt > 1 && !solver->supports_threads) {
+        fprintf(stderr, "Warning: Solver %s has no parallel mode, -j %zu runs serially\n",
+                solver->name, options->thread_cnt);
+    }
+}
+
+bool try_initializing_solver(const solver_t* solver, void** state) {
+    *state = NULL;
+    if(solver->init == NULL) {
+        return true;
+    }
+    if(!solver->init(state)) {
+        fprintf(stderr, "Error initializing solver %s\n", solver->name);
+        return false;
+    }
+    return true;
+}
+
+void destroy_solver(const solver_t* solver, void* state) {
+    if(solver->destroy != NULL) {
+        solver->destroy(state);
+    }
+}
+
+bool try_solving_buffer(const solver_t* solver,
+                        void* state,
+                        const solver_options_t* options,
+                        const char* input,
+                        size_t input_size,
+                        solver_result_t* result) {
+
+    result->part_one = 0;
+    result->part_two = 0;
+    result->has_part_two = false;
+    return solver->solve(state, options, input, input_size, result);
+}
+
+static bool try_solving_stream(const solver_t* solver,
+                               void* state,
+                               const solver_options_t* options,
+                               const char* file_name,
+                               input_format_t format,
+                               solver_result_t* result) {
+
+    if(solver->solve_lines == NULL) {
+        fprintf(stderr, "Error: Solver %s does not support %s compressed input\n",
+                solver->name, input_format_name(format));
+        return false;
+    }
+
+    input_stream_t* stream;
+    if(!try_opening_input_stream(file_name, format, &stream)) {
+        return false;
+    }
+    line_reader_t reader;
+    init_stream_line_reader(&reader, stream);
+
+    result->part_one = 0;
+    result->part_two = 0;
+    result->has_part_two = false;
+    bool solved = solver->solve_lines(state, options, &reader, result);
+
+    // A truncated or corrupt stream just ends early, so its result must not count
+    if(input_stream_failed(stream)) {
+        solved = false;
+    }
+    close_input_stream(stream);
+    return solved;
+}
+
+bool try_solving_file(const solver_t* solver,
+                      void* state,
+                      const solver_options_t* options,
+                      const char* file_name,
+                      solver_result_t* result,
+                      bool* cache_hit) {
+
+    *cache_hit = false;
+
+    // Look up the result of an identical input and mode first (an export needs the actual solve)
+    const result_cache_key_t key_info = {solver->name, solver->version,
+                                         options->mode != NULL ? options->mode : "default"};
+    bool use_cache = options->use_cache && options->export_file_name == NULL
+                  && (solver->bypasses_result_cache == NULL || !solver->bypasses_result_cache(options, file_name));
+    result_cache_slot_t cache_slot = {false, 0};
+    int64_t cached_values[CACHED_VALUES_CNT];
+    if(use_cache && result_cache_lookup(file_name, &key_info, &cache_slot, cached_values, CACHED_VALUES_CNT)) {
+        result->part_one = cached_values[0];
+        result->part_two = cached_values[1];
+        result->has_part_two = cached_values[2] != 0;
+        *cache_hit = true;
+        return true;
+    }
+
+    input_format_t format;
+    if(!try_detecting_input_format(file_name, &format)) {
+        return false;
+    }
+
+    // Auto-tuning settles the backend before loading and the threads after
+    solver_options_t tuned = *options;
+    if(options->autotune && format == INPUT_FORMAT_PLAIN) {
+        struct stat file_stat;
+        if(stat(file_name, &file_stat) == 0) {
+            tuned.input_backend = autotune_input_backend((size_t)file_stat.st_size);
+        }
+    }
+
+    bool solved;
+    if(format == INPUT_FORMAT_PLAIN) {
+        input_t input;
+        if(!try_loading_input_with(file_name, tuned.input_backend, &input)) {
+            return false;
+        }
+        mem_stats_record("input buffer", input.size);
+        solved = (!options->autotune
+                  || try_autotuning_solver(solver, state, file_name, input.data, input.size, &tuned))
+              && try_solving_buffer(solver, state, &tuned, input.data, input.size, result);
+        release_input(&input);
+    } else {
+        if(options->autotune) {
+            tuned.thread_cnt = 1;
+            log_streamed_input(solver, file_name, format);
+        }
+        solved = try_solving_stream(solver, state, &tuned, file_name, format, result);
+    }
+
+    if(solved && use_cache) {
+        cached_values[0] = result->part_one;
+        cached_values[1] = result->part_two;
+        cached_values[2] = result->has_part_two ? 1 : 0;
+        result_cache_store(&cache_slot, cached_values, CACHED_VALUES_CNT);
+    }
+    return solved;
+}
@@ -0,0 +1,88 @@
+#ifndef AOC_SOLVER_H
+#define AOC_SOLVER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "input_stream.h"
+#include "placement.h"
+
+// Solver Interface
+// ################################################
+//
+// Every day exposes one solver_t. The day binaries and the multi-day runner
+// both drive solvers through this interface: input buffer in, results out.
+
+typedef struct {
+    size_t thread_cnt;      // 1 = serial
+    bool use_cache;
+    const char* mode;       // Solver specific variant (NULL = default), see -m
+    placement_policy_t placement;   // Pinning of the workers of parallel modes, see -p
+    const char* export_file_name;   // Per-item results (NULL = none), see -e
+    bool autotune;                  // Choose the fields below and thread_cnt per input, see -j auto
+    size_t chunk_size;              // Bytes per scheduler item of the parallel modes (0 = solver default)
+    input_backend_t input_backend;  // How plain inputs are loaded
+} solver_options_t;
+
+typedef struct {
+    int64_t part_one;
+    int64_t part_two;
+    bool has_part_two;
+} solver_result_t;
+
+typedef struct {
+    const char* name;           // Registry key, e.g. "01" or "03_V2"
+    const char* directory;      // Day directory, e.g. "01_Day"
+    const char* default_input;  // Default input file inside the day directory
+    uint32_t version;           // Bump when results may change (invalidates cached results)
+    // Optional: set up state that can be reused across solve calls (e.g. compiled regexes)
+    bool (*init)(void** state);
+    bool (*solve)(void* state,
+                  const solver_options_t* options,
+                  const char* input,
+                  size_t input_size,
+                  solver_result_t* result);
+    // Optional: same as solve, but pulls lines from a reader; needed for compressed inputs
+    bool (*solve_lines)(void* state,
+                        const solver_options_t* options,
+                        line_reader_t* reader,
+                        solver_result_t* result);
+    // Optional: release the state created by init
+    void (*destroy)(void* state);
+    // Optional: true if this run must neither use nor fill the result cache,
+    // e.g. because the mode writes output of its own
+    bool (*bypasses_result_cache)(const solver_options_t* options, const char* file_name);
+    // solve honours thread_cnt and chunk_size, so auto-tuning calibrates it
+    bool supports_threads;
+} solver_t;
+
+#define SOLVER_OPTIONS_DEFAULT {1, false, NULL, PLACEMENT_NONE, NULL, false, 0, INPUT_BACKEND_MMAP}
+
+// True if options select the given mode ("default" matches a missing mode)
+bool solver_mode_is(const solver_options_t* options, const char* mode);
+
+// -j N is ignored by solvers without supports_threads, the caller is told so
+void warn_about_unsupported_threads(const solver_t* solver, const solver_options_t* options);
+
+bool try_initializing_solver(const solver_t* solver, void** state);
+void destroy_solver(const solver_t* solver, void* state);
+
+// Solves an in-memory input (no result cache involved)
+bool try_solving_buffer(const solver_t* solver,
+                        void* state,
+                        const solver_options_t* options,
+                        const char* input,
+                        size_t input_size,
+                        solver_result_t* result);
+
+// Loads the file, consults the result cache (if enabled) and solves on a miss.
+// gzip/zstd compressed files are streamed through solve_lines.
+bool try_solving_file(const solver_t* solver,
+                      void* state,
+                      const solver_options_t* options,
+                      const char* file_name,
+                      solver_result_t* result,
+                      bool* cache_hit);
+
+#endif
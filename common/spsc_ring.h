@@ -0,0 +1,54 @@
+#ifndef AOC_SPSC_RING_H
+#define AOC_SPSC_RING_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// Single-Producer Single-Consumer Ring
+// ################################################
+//
+// Bounded lock-free queue of pointers between exactly two threads. head is
+// only written by the consumer, tail only by the producer; the release store
+// of one side paired with the acquire load of the other publishes the slot.
+// Capacity must be a power of two.
+
+typedef struct {
+    _Alignas(64) atomic_size_t head;    // Next slot to pop
+    _Alignas(64) atomic_size_t tail;    // Next slot to push
+    size_t mask;
+    void** slots;
+} spsc_ring_t;
+
+static inline void init_spsc_ring(spsc_ring_t* ring, void** slots, size_t capacity) {
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    ring->mask = capacity - 1;
+    ring->slots = slots;
+}
+
+// False if the ring is full
+static inline bool spsc_try_push(spsc_ring_t* ring, void* item) {
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    if(tail - head > ring->mask) {
+        return false;
+    }
+    ring->slots[tail & ring->mask] = item;
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+// False if the ring is empty
+static inline bool spsc_try_pop(spsc_ring_t* ring, void** item) {
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    if(head == tail) {
+        return false;
+    }
+    *item = ring->slots[head & ring->mask];
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    return true;
+}
+
+#endif
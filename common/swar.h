@@ -0,0 +1,90 @@
+#ifndef AOC_SWAR_H
+#define AOC_SWAR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+// SWAR Integer Parsing
+// ################################################
+//
+// Parses ASCII digits 8 at a time inside one 64-bit register: one load, a
+// branch-free digit mask and three multiply/shift steps per 8 digits.
+// Assumes a little-endian target (first character in the lowest byte).
+
+static const uint64_t SWAR_POW10[9] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL
+};
+
+// Loads up to 8 bytes, missing bytes are 0 (which is not a digit)
+static inline uint64_t swar_load(const char* str, size_t str_len) {
+    uint64_t chunk = 0;
+    memcpy(&chunk, str, str_len < 8 ? str_len : 8);
+    return chunk;
+}
+
+// Number of leading digit bytes in chunk (0-8)
+static inline uint32_t swar_leading_digits(uint64_t chunk) {
+    // Digits become 0x00-0x09. A byte is not a digit if its high nibble is set
+    // or its low nibble + 6 reaches 0x10 (no carry can cross a byte: max 0x15)
+    uint64_t values = chunk ^ 0x3030303030303030ULL;
+    uint64_t non_digit = (values & 0xF0F0F0F0F0F0F0F0ULL)
+                       | (((values & 0x0F0F0F0F0F0F0F0FULL) + 0x0606060606060606ULL) & 0x1010101010101010ULL);
+    // Set the high bit of every non-zero byte
+    uint64_t mask = (((non_digit & 0x7F7F7F7F7F7F7F7FULL) + 0x7F7F7F7F7F7F7F7FULL) | non_digit) & 0x8080808080808080ULL;
+    if(mask == 0) {
+        return 8;
+    }
+    return (uint32_t)__builtin_ctzll(mask) / 8;
+}
+
+// Value of the first digit_cnt (1-8) digits of chunk
+static inline uint64_t swar_digits_value(uint64_t chunk, uint32_t digit_cnt) {
+    // Move the digits to the top, the vacated low bytes act as leading zeros
+    uint64_t values = (chunk & 0x0F0F0F0F0F0F0F0FULL) << (8 * (8 - digit_cnt));
+    values = (values * 10) + (values >> 8);
+    values = (((values & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)))
+            + (((values >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+    return values;
+}
+
+// Parses up to 8 leading digits of str, returns the number of digits consumed
+static inline uint32_t swar_parse_8_digits(const char* str, size_t str_len, uint64_t* value) {
+    uint64_t chunk = swar_load(str, str_len);
+    uint32_t digit_cnt = swar_leading_digits(chunk);
+    *value = (digit_cnt > 0) ? swar_digits_value(chunk, digit_cnt) : 0;
+    return digit_cnt;
+}
+
+// Parses the leading unsigned decimal of str (any length).
+// consumed is the length of the digit run (0 if str does not start with a digit).
+// Returns false if the value exceeds max_value instead of truncating it.
+static inline bool swar_try_parsing_uint(const char* str, size_t str_len, uint64_t max_value,
+                                         uint64_t* value, size_t* consumed) {
+    *value = 0;
+    *consumed = 0;
+    bool in_range = true;
+    while(*consumed < str_len) {
+        uint64_t chunk_value;
+        uint32_t digit_cnt = swar_parse_8_digits(str + *consumed, str_len - *consumed, &chunk_value);
+        if(digit_cnt == 0) {
+            break;
+        }
+        if(in_range) {
+            if(*value > (max_value - chunk_value) / SWAR_POW10[digit_cnt]
+            || chunk_value > max_value) {
+                in_range = false;
+            } else {
+                *value = *value * SWAR_POW10[digit_cnt] + chunk_value;
+            }
+        }
+        *consumed += digit_cnt;
+        if(digit_cnt < 8) {
+            break;
+        }
+    }
+    return in_range;
+}
+
+#endif
@@ -0,0 +1,78 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>       // timespec_get
+
+#include "utils.h"
+#include "mem_stats.h"
+#include "profiler.h"
+
+// Utility Functions
+// ################################################
+
+int64_t millis(void) {
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return ((int64_t) now.tv_sec) * 1000 + ((int64_t) now.tv_nsec) / 1000000;
+}
+
+int64_t micros(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((int64_t) now.tv_sec) * 1000000 + ((int64_t) now.tv_nsec) / 1000;
+}
+
+int64_t print_program_start(void) {
+    int64_t current_time = millis();
+    printf("\n");
+    printf("Started\n");
+    printf("---------------------------------\n");
+    return current_time;
+}
+
+void print_program_end(int64_t start_time) {
+    int64_t end_time = millis();
+    int64_t elapsed_time_ms = end_time - start_time;
+    printf("---------------------------------\n");
+    print_mem_stats(stdout);
+    print_profile(stdout);
+    printf("Finished in %ld ms\n", elapsed_time_ms);
+    printf("\n");
+}
+
+char* rawify(const char* str) {
+    size_t length = strlen(str);
+    char *raw_str = (char*) malloc((length * 2 + 1) * sizeof(char));
+    if(raw_str == NULL) {
+        return NULL;
+    }
+    char *temp = raw_str;
+
+    while (*str) {
+        if (*str == '\n') {
+            *temp++ = '\\';
+            *temp++ = 'n';
+        } else if (*str == '\t') {
+            *temp++ = '\\';
+            *temp++ = 't';
+        } else if (*str == '\r') {
+            *temp++ = '\\';
+            *temp++ = 'r';
+        } else {
+            *temp++ = *str;
+        }
+        str++;
+    }
+    *temp = '\0';
+    return raw_str;
+}
+
+bool try_opening_file(const char* file_name, FILE** file) {
+
+    *file = fopen(file_name, "r");
+    if(*file == NULL) {
+        perror("Error opening file");
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,19 @@
+#ifndef AOC_UTILS_H
+#define AOC_UTILS_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Basic Utility Functions
+// ################################################
+
+int64_t millis(void);
+int64_t micros(void);
+int64_t print_program_start(void);
+void print_program_end(int64_t start_time);
+// Returns a heap copy of str with \n, \t and \r escaped (caller frees)
+char* rawify(const char* str);
+bool try_opening_file(const char* file_name, FILE** file);
+
+#endif
@@ -0,0 +1,188 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>   // int64_t
+#include <unistd.h>     // getopt
+#include <stdbool.h>    // bool
+#include <sys/socket.h> // socket
+#include <sys/un.h>     // sockaddr_un
+
+#include "input.h"
+#include "utils.h"
+#include "daemon.h"
+
+// Definitions
+// ################################################
+
+#define CLIENT_MAX_LINE (4096)
+
+// Function Prototypes
+// ################################################
+
+static void print_usage(const char* program_name);
+static int try_connecting(const char* socket_path);
+static bool try_sending_request(int socket_fd, FILE* stream, const char* request, bool send_inline);
+
+// Main
+// ################################################
+
+int main (int argc, char* argv[]) {
+
+    const char* socket_path = DAEMON_DEFAULT_SOCKET;
+    bool send_inline = false;
+    bool shutdown_daemon = false;
+    unsigned long repetitions = 1;
+
+    int option;
+    while((option = getopt(argc, argv, "s:in:x")) != -1) {
+        switch(option) {
+            case 's':
+                socket_path = optarg;
+                break;
+            case 'i':
+                send_inline = true;
+                break;
+            case 'n':
+                repetitions = strtoul(optarg, NULL, 10);
+                if(repetitions == 0) {
+                    repetitions = 1;
+                }
+                break;
+            case 'x':
+                shutdown_daemon = true;
+                break;
+            default:
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if(optind >= argc && !shutdown_daemon) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int socket_fd = try_connecting(socket_path);
+    if(socket_fd == -1) {
+        return EXIT_FAILURE;
+    }
+    FILE* stream = fdopen(socket_fd, "r");
+    if(stream == NULL) {
+        perror("Error opening socket stream");
+        close(socket_fd);
+        return EXIT_FAILURE;
+    }
+
+    // Requests are DAY=input_file, sent one after another on one connection
+    bool successful = true;
+    for(unsigned long repetition=0; repetition<repetitions && successful; ++repetition) {
+        for(int i=optind; i<argc && successful; ++i) {
+            successful = try_sending_request(socket_fd, stream, argv[i], send_inline);
+        }
+    }
+    if(successful && shutdown_daemon) {
+        successful = try_sending_request(socket_fd, stream, "SHUTDOWN", false);
+    }
+
+    fclose(stream);
+    return successful ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Client Functions
+// ################################################
+
+static void print_usage(const char* program_name) {
+    fprintf(stderr, "Usage: %s [-s socket] [-i] [-n repetitions] [-x] DAY=input_file...\n", program_name);
+    fprintf(stderr, "  -s socket   Daemon socket (default: %s)\n", DAEMON_DEFAULT_SOCKET);
+    fprintf(stderr, "  -i          Send the input contents inline instead of the path\n");
+    fprintf(stderr, "  -n count    Repeat all requests count times\n");
+    fprintf(stderr, "  -x          Shut the daemon down afterwards\n");
+}
+
+static int try_connecting(const char* socket_path) {
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if(strlen(socket_path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Error: Socket path too long\n");
+        return -1;
+    }
+    strcpy(address.sun_path, socket_path);
+
+    int socket_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(socket_fd == -1) {
+        perror("Error creating socket");
+        return -1;
+    }
+    if(connect(socket_fd, (struct sockaddr*)&address, sizeof(address)) == -1) {
+        perror("Error connecting to daemon");
+        close(socket_fd);
+        return -1;
+    }
+    return socket_fd;
+}
+
+static bool try_writing_all(int socket_fd, const char* data, size_t size) {
+    while(size > 0) {
+        ssize_t written = write(socket_fd, data, size);
+        if(written <= 0) {
+            perror("Error sending request");
+            return false;
+        }
+        data += written;
+        size -= (size_t)written;
+    }
+    return true;
+}
+
+static bool try_sending_request(int socket_fd, FILE* stream, const char* request, bool send_inline) {
+
+    char header[CLIENT_MAX_LINE];
+    const char* file_name = NULL;
+    input_t input = {NULL, 0, false, false};
+    bool successful = false;
+
+    if(strcmp(request, "SHUTDOWN") == 0) {
+        snprintf(header, sizeof(header), "SHUTDOWN\n");
+    } else {
+        const char* separator = strchr(request, '=');
+        if(separator == NULL) {
+            fprintf(stderr, "Error: Expected DAY=input_file, got \"%s\"\n", request);
+            return false;
+        }
+        int day_len = (int)(separator - request);
+        file_name = separator + 1;
+        if(send_inline) {
+            if(!try_loading_input(file_name, &input)) {
+                return false;
+            }
+            snprintf(header, sizeof(header), "INLINE %.*s %zu\n", day_len, request, input.size);
+        } else {
+            snprintf(header, sizeof(header), "SOLVE %.*s %s\n", day_len, request, file_name);
+        }
+    }
+
+    int64_t start = micros();
+    if(!try_writing_all(socket_fd, header, strlen(header))) {
+        goto cleanup;
+    }
+    if(input.size > 0 && !try_writing_all(socket_fd, input.data, input.size)) {
+        goto cleanup;
+    }
+
+    char response[CLIENT_MAX_LINE];
+    if(fgets(response, sizeof(response), stream) == NULL) {
+        fprintf(stderr, "Error: Daemon closed the connection\n");
+        goto cleanup;
+    }
+    int64_t round_trip_us = micros() - start;
+
+    response[strcspn(response, "\n")] = '\0';
+    printf("%-40s %s (round trip %" PRId64 " us)\n",
+        file_name != NULL ? file_name : request, response, round_trip_us);
+    successful = strncmp(response, "OK", 2) == 0;
+
+    cleanup:
+        release_input(&input);
+        return successful;
+}
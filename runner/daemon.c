@@ -0,0 +1,471 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>   // int64_t
+#include <errno.h>      // errno
+#include <signal.h>     // sigaction
+#include <unistd.h>     // close, pipe
+#include <stdbool.h>    // bool
+#include <pthread.h>    // pthread_create
+#include <poll.h>       // poll
+#include <sys/time.h>   // timeval
+#include <sys/socket.h> // socket
+#include <sys/un.h>     // sockaddr_un
+
+#include "utils.h"
+#include "registry.h"
+#include "daemon.h"
+
+// Definitions
+// ################################################
+
+#define DAEMON_BACKLOG (64)
+#define DAEMON_MAX_LINE (4096)
+// Connections are served by this many workers, further ones wait in the queue
+#define DAEMON_WORKERS (4)
+#define DAEMON_QUEUE_LEN (64)
+// A connection without a complete request line or payload for this long is closed
+#define DAEMON_READ_TIMEOUT_S (10)
+
+// Structs, Typedefs, Enums and Global Variables
+// ################################################
+
+static volatile sig_atomic_t G_STOP_REQUESTED = 0;
+
+// Inline payloads are read into one buffer that only ever grows
+typedef struct {
+    char* data;
+    size_t capacity;
+} payload_buffer_t;
+
+typedef struct {
+    uint64_t requests;
+    uint64_t failures;
+    int64_t total_latency_us;
+} daemon_stats_t;
+
+// Accepted connections waiting for a worker. Solver states, the result cache
+// and the stats are shared, so requests are solved one at a time under
+// solve_lock; only reading requests and sending answers run concurrently.
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    int fds[DAEMON_QUEUE_LEN];
+    size_t head;
+    size_t cnt;
+    bool closed;
+    int active_fds[DAEMON_WORKERS];     // Connection per worker (-1: idle)
+    pthread_mutex_t solve_lock;
+    const solver_options_t* options;
+    daemon_stats_t stats;
+    int wake_fd;                        // Written to on SHUTDOWN, wakes the accept loop
+} daemon_t;
+
+typedef struct {
+    daemon_t* daemon;
+    size_t index;
+} worker_t;
+
+// Function Prototypes
+// ################################################
+
+static void handle_stop_signal(int signal_number);
+static bool try_setting_up_signals(void);
+static int try_opening_socket(const char* socket_path);
+static bool try_starting_workers(daemon_t* daemon, pthread_t* threads, worker_t* workers, size_t* started);
+static void stop_workers(daemon_t* daemon, pthread_t* threads, size_t started);
+static bool try_queueing_connection(daemon_t* daemon, int connection_fd);
+static void* run_worker(void* argument);
+static bool serve_connection(daemon_t* daemon, int connection_fd, payload_buffer_t* payload);
+static bool try_reading_payload(FILE* stream, size_t size, payload_buffer_t* payload);
+static void send_result(int connection_fd, const solver_result_t* result, int64_t latency_us);
+
+// Daemon
+// ################################################
+
+int run_daemon(const char* socket_path, const solver_options_t* options) {
+
+    if(!try_setting_up_signals()) {
+        return EXIT_FAILURE;
+    }
+
+    int server_fd = try_opening_socket(socket_path);
+    if(server_fd == -1) {
+        return EXIT_FAILURE;
+    }
+    int wake_fds[2];
+    if(pipe(wake_fds) == -1) {
+        perror("Error creating wake pipe");
+        close(server_fd);
+        unlink(socket_path);
+        return EXIT_FAILURE;
+    }
+
+    // Warm up every solver once, so the first request does not pay for it
+    for(size_t i=0; i<SOLVER_REGISTRY_CNT; ++i) {
+        void* state;
+        if(!try_getting_solver_state(i, &state)) {
+            fprintf(stderr, "Warning: Solver %s is unavailable\n", SOLVER_REGISTRY[i]->name);
+        }
+        warn_about_unsupported_threads(SOLVER_REGISTRY[i], options);
+    }
+
+    daemon_t daemon;
+    memset(&daemon, 0, sizeof(daemon));
+    pthread_mutex_init(&daemon.lock, NULL);
+    pthread_cond_init(&daemon.not_empty, NULL);
+    pthread_mutex_init(&daemon.solve_lock, NULL);
+    for(size_t i=0; i<DAEMON_WORKERS; ++i) {
+        daemon.active_fds[i] = -1;
+    }
+    daemon.options = options;
+    daemon.wake_fd = wake_fds[1];
+
+    pthread_t threads[DAEMON_WORKERS];
+    worker_t workers[DAEMON_WORKERS];
+    size_t started = 0;
+    bool successful = try_starting_workers(&daemon, threads, workers, &started);
+    if(successful) {
+        printf("Listening on %s (%d workers)\n", socket_path, DAEMON_WORKERS);
+        fflush(stdout);
+    }
+
+    struct pollfd poll_fds[2] = {{server_fd, POLLIN, 0}, {wake_fds[0], POLLIN, 0}};
+    while(successful && !G_STOP_REQUESTED) {
+        if(poll(poll_fds, 2, -1) == -1) {
+            if(errno == EINTR) {
+                continue;
+            }
+            perror("Error waiting for connections");
+            break;
+        }
+        if(poll_fds[1].revents != 0) {
+            break;
+        }
+        if((poll_fds[0].revents & POLLIN) == 0) {
+            continue;
+        }
+        int connection_fd = accept(server_fd, NULL, NULL);
+        if(connection_fd == -1) {
+            if(errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            perror("Error accepting connection");
+            break;
+        }
+        if(!try_queueing_connection(&daemon, connection_fd)) {
+            dprintf(connection_fd, "ERR busy\n");
+            close(connection_fd);
+        }
+    }
+    stop_workers(&daemon, threads, started);
+
+    printf("Served %" PRIu64 " requests (%" PRIu64 " failed), mean latency %.1f us\n",
+        daemon.stats.requests, daemon.stats.failures,
+        daemon.stats.requests > 0 ? (double)daemon.stats.total_latency_us / (double)daemon.stats.requests : 0.0);
+
+    pthread_mutex_destroy(&daemon.solve_lock);
+    pthread_cond_destroy(&daemon.not_empty);
+    pthread_mutex_destroy(&daemon.lock);
+    destroy_solver_states();
+    close(wake_fds[0]);
+    close(wake_fds[1]);
+    close(server_fd);
+    unlink(socket_path);
+    return successful ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Helper Functions
+// ################################################
+
+static void handle_stop_signal(int signal_number) {
+    (void)signal_number;
+    G_STOP_REQUESTED = 1;
+}
+
+static bool try_setting_up_signals(void) {
+
+    // No SA_RESTART: a pending poll() returns with EINTR and the loop ends
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handle_stop_signal;
+    sigemptyset(&action.sa_mask);
+    if(sigaction(SIGINT, &action, NULL) == -1 || sigaction(SIGTERM, &action, NULL) == -1) {
+        perror("Error installing signal handler");
+        return false;
+    }
+
+    // Clients that hang up early must not kill the daemon
+    signal(SIGPIPE, SIG_IGN);
+    return true;
+}
+
+static int try_opening_socket(const char* socket_path) {
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if(strlen(socket_path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Error: Socket path too long\n");
+        return -1;
+    }
+    strcpy(address.sun_path, socket_path);
+
+    int server_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(server_fd == -1) {
+        perror("Error creating socket");
+        return -1;
+    }
+
+    // Remove a stale socket of a previous run
+    unlink(socket_path);
+    if(bind(server_fd, (struct sockaddr*)&address, sizeof(address)) == -1) {
+        perror("Error binding socket");
+        close(server_fd);
+        return -1;
+    }
+    if(listen(server_fd, DAEMON_BACKLOG) == -1) {
+        perror("Error listening on socket");
+        close(server_fd);
+        unlink(socket_path);
+        return -1;
+    }
+    return server_fd;
+}
+
+// Worker Pool
+// ################################################
+
+static bool try_starting_workers(daemon_t* daemon, pthread_t* threads, worker_t* workers, size_t* started) {
+
+    // Stop signals are handled by the accept loop only, their EINTR wakes its poll
+    sigset_t stop_signals;
+    sigset_t previous;
+    sigemptyset(&stop_signals);
+    sigaddset(&stop_signals, SIGINT);
+    sigaddset(&stop_signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stop_signals, &previous);
+
+    bool successful = true;
+    for(*started=0; *started<DAEMON_WORKERS; ++(*started)) {
+        workers[*started].daemon = daemon;
+        workers[*started].index = *started;
+        if(pthread_create(&threads[*started], NULL, run_worker, &workers[*started]) != 0) {
+            fprintf(stderr, "Error starting daemon worker\n");
+            successful = false;
+            break;
+        }
+    }
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+    return successful;
+}
+
+static void stop_workers(daemon_t* daemon, pthread_t* threads, size_t started) {
+
+    // Queued connections are dropped, idle ones are woken up by the shutdown
+    pthread_mutex_lock(&daemon->lock);
+    daemon->closed = true;
+    while(daemon->cnt > 0) {
+        close(daemon->fds[daemon->head]);
+        daemon->head = (daemon->head + 1) % DAEMON_QUEUE_LEN;
+        daemon->cnt--;
+    }
+    for(size_t i=0; i<DAEMON_WORKERS; ++i) {
+        if(daemon->active_fds[i] != -1) {
+            shutdown(daemon->active_fds[i], SHUT_RD);
+        }
+    }
+    pthread_cond_broadcast(&daemon->not_empty);
+    pthread_mutex_unlock(&daemon->lock);
+
+    for(size_t i=0; i<started; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+}
+
+// False if the queue is full
+static bool try_queueing_connection(daemon_t* daemon, int connection_fd) {
+
+    pthread_mutex_lock(&daemon->lock);
+    bool queued = daemon->cnt < DAEMON_QUEUE_LEN;
+    if(queued) {
+        daemon->fds[(daemon->head + daemon->cnt) % DAEMON_QUEUE_LEN] = connection_fd;
+        daemon->cnt++;
+        pthread_cond_signal(&daemon->not_empty);
+    }
+    pthread_mutex_unlock(&daemon->lock);
+    return queued;
+}
+
+static void* run_worker(void* argument) {
+
+    worker_t* worker = (worker_t*)argument;
+    daemon_t* daemon = worker->daemon;
+    payload_buffer_t payload = {NULL, 0};
+    while(true) {
+        pthread_mutex_lock(&daemon->lock);
+        while(daemon->cnt == 0 && !daemon->closed) {
+            pthread_cond_wait(&daemon->not_empty, &daemon->lock);
+        }
+        if(daemon->closed) {
+            pthread_mutex_unlock(&daemon->lock);
+            break;
+        }
+        int connection_fd = daemon->fds[daemon->head];
+        daemon->head = (daemon->head + 1) % DAEMON_QUEUE_LEN;
+        daemon->cnt--;
+        daemon->active_fds[worker->index] = connection_fd;
+        pthread_mutex_unlock(&daemon->lock);
+
+        // Idle clients must not hold a worker forever
+        struct timeval timeout = {DAEMON_READ_TIMEOUT_S, 0};
+        setsockopt(connection_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        if(!serve_connection(daemon, connection_fd, &payload)) {
+            G_STOP_REQUESTED = 1;
+            if(write(daemon->wake_fd, "x", 1) == -1) {
+                perror("Error waking the daemon");
+            }
+        }
+    }
+    free(payload.data);
+    return NULL;
+}
+
+// Connections
+// ################################################
+
+static bool try_reading_payload(FILE* stream, size_t size, payload_buffer_t* payload) {
+
+    if(size > payload->capacity) {
+        char* data = realloc(payload->data, size);
+        if(data == NULL) {
+            perror("Error allocating memory for payload");
+            return false;
+        }
+        payload->data = data;
+        payload->capacity = size;
+    }
+    return fread(payload->data, 1, size, stream) == size;
+}
+
+static void send_result(int connection_fd, const solver_result_t* result, int64_t latency_us) {
+    if(result->has_part_two) {
+        dprintf(connection_fd, "OK %" PRId64 " %" PRId64 " %" PRId64 "\n",
+            result->part_one, result->part_two, latency_us);
+    } else {
+        dprintf(connection_fd, "OK %" PRId64 " - %" PRId64 "\n",
+            result->part_one, latency_us);
+    }
+}
+
+// Returns false if the daemon should shut down. Closes the connection.
+static bool serve_connection(daemon_t* daemon, int connection_fd, payload_buffer_t* payload) {
+
+    // The stream owns connection_fd from here on
+    FILE* stream = fdopen(connection_fd, "r");
+    if(stream == NULL) {
+        perror("Error opening connection stream");
+    }
+
+    bool keep_running = true;
+    char line[DAEMON_MAX_LINE];
+    while(stream != NULL && fgets(line, sizeof(line), stream) != NULL) {
+
+        char* rest = line;
+        char* command = strtok_r(line, " \r\n", &rest);
+        if(command == NULL) {
+            continue;
+        }
+        if(strcmp(command, "PING") == 0) {
+            dprintf(connection_fd, "PONG\n");
+            continue;
+        }
+        if(strcmp(command, "SHUTDOWN") == 0) {
+            dprintf(connection_fd, "OK shutdown\n");
+            keep_running = false;
+            break;
+        }
+
+        bool is_inline = strcmp(command, "INLINE") == 0;
+        if(!is_inline && strcmp(command, "SOLVE") != 0) {
+            dprintf(connection_fd, "ERR unknown command\n");
+            continue;
+        }
+
+        char* day = strtok_r(NULL, " \r\n", &rest);
+        char* argument = strtok_r(NULL, "\r\n", &rest);
+        if(day == NULL || argument == NULL) {
+            dprintf(connection_fd, "ERR missing arguments\n");
+            continue;
+        }
+
+        // The payload has to be consumed even if the solver is unknown
+        size_t payload_size = 0;
+        if(is_inline) {
+            char* end = NULL;
+            unsigned long long size = strtoull(argument, &end, 10);
+            if(end == argument || size > DAEMON_MAX_INLINE_SIZE) {
+                dprintf(connection_fd, "ERR invalid payload size\n");
+                break;
+            }
+            payload_size = (size_t)size;
+            if(!try_reading_payload(stream, payload_size, payload)) {
+                dprintf(connection_fd, "ERR incomplete payload\n");
+                break;
+            }
+        }
+
+        // One solve at a time, the solver states are shared
+        pthread_mutex_lock(&daemon->solve_lock);
+        daemon_stats_t* stats = &daemon->stats;
+        int64_t request_start = micros();
+        long solver_index = find_solver(day);
+        void* state = NULL;
+        if(solver_index < 0 || !try_getting_solver_state((size_t)solver_index, &state)) {
+            stats->requests++;
+            stats->failures++;
+            pthread_mutex_unlock(&daemon->solve_lock);
+            dprintf(connection_fd, "ERR unknown solver\n");
+            continue;
+        }
+        const solver_t* solver = SOLVER_REGISTRY[solver_index];
+
+        solver_result_t result;
+        bool cache_hit = false;
+        bool solved = is_inline
+            ? try_solving_buffer(solver, state, daemon->options, payload->data, payload_size, &result)
+            : try_solving_file(solver, state, daemon->options, argument, &result, &cache_hit);
+        int64_t latency_us = micros() - request_start;
+
+        stats->requests++;
+        stats->total_latency_us += latency_us;
+        if(!solved) {
+            stats->failures++;
+        }
+        pthread_mutex_unlock(&daemon->solve_lock);
+        if(!solved) {
+            dprintf(connection_fd, "ERR solver failed\n");
+            continue;
+        }
+        send_result(connection_fd, &result, latency_us);
+
+        printf("%-6s %-8s %-40s %8" PRId64 " us%s\n", solver->name, command,
+            is_inline ? "<inline>" : argument, latency_us, cache_hit ? " (cached)" : "");
+        fflush(stdout);
+    }
+
+    pthread_mutex_lock(&daemon->lock);
+    for(size_t i=0; i<DAEMON_WORKERS; ++i) {
+        if(daemon->active_fds[i] == connection_fd) {
+            daemon->active_fds[i] = -1;
+        }
+    }
+    pthread_mutex_unlock(&daemon->lock);
+    if(stream != NULL) {
+        fclose(stream);
+    } else {
+        close(connection_fd);
+    }
+    return keep_running;
+}
@@ -0,0 +1,29 @@
+#ifndef AOC_DAEMON_H
+#define AOC_DAEMON_H
+
+#include "solver.h"
+
+// Solver Daemon
+// ################################################
+//
+// Line based protocol over a Unix domain socket, several requests per
+// connection are allowed. Connections are served by a small worker pool and
+// closed after DAEMON_READ_TIMEOUT_S seconds without a request; the solves
+// themselves run one at a time.
+//
+//   SOLVE <day> <input_file>\n         -> solve a file (uses the result cache with -c)
+//   INLINE <day> <size>\n<size bytes>  -> solve the transmitted buffer
+//   PING\n                             -> PONG
+//   SHUTDOWN\n                         -> stop the daemon
+//
+// Answers are single lines:
+//
+//   OK <part_one> <part_two|-> <latency_us>\n
+//   ERR <message>\n
+
+#define DAEMON_DEFAULT_SOCKET "/tmp/aoc_solver.sock"
+#define DAEMON_MAX_INLINE_SIZE (1024UL * 1024UL * 1024UL)
+
+int run_daemon(const char* socket_path, const solver_options_t* options);
+
+#endif
@@ -0,0 +1,360 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>   // int64_t
+#include <unistd.h>     // getopt
+#include <stdbool.h>    // bool
+
+#include "cli.h"
+#include "solver.h"
+#include "utils.h"
+#include "profiler.h"
+#include "scheduler.h"
+#include "registry.h"
+#include "daemon.h"
+
+// Definitions
+// ################################################
+
+#define RUNNER_OPTSTRING "lf:d:" SOLVER_OPTSTRING
+#define ROOT_DIR_ENV "AOC_ROOT"
+#define DEFAULT_ROOT_DIR ".."
+
+// Structs, Typedefs, Enums and Global Variables
+// ################################################
+
+typedef struct {
+    size_t solver_index;
+    char* input_file_name;
+} job_t;
+
+typedef struct {
+    job_t* jobs;
+    size_t jobs_cnt;
+} job_list_t;
+
+typedef struct {
+    solver_result_t result;
+    bool solved;
+    bool cache_hit;
+    int64_t time_us;
+} job_outcome_t;
+
+// Shared by the workers of run_jobs_parallel, states are per worker and solver
+typedef struct {
+    const job_list_t* job_list;
+    const solver_options_t* options;
+    job_outcome_t* outcomes;
+    void** states;
+    bool* states_initialized;
+} parallel_jobs_t;
+
+// Function Prototypes
+// ################################################
+
+static void print_usage(const char* program_name);
+static void list_solvers(void);
+static bool try_adding_job(job_list_t* job_list, const char* day, const char* input_file_name);
+static bool try_parsing_job_argument(job_list_t* job_list, const char* argument);
+static bool try_reading_job_file(job_list_t* job_list, const char* file_name);
+static bool run_jobs(const job_list_t* job_list, const solver_options_t* options);
+static bool run_jobs_parallel(const job_list_t* job_list, const solver_options_t* options);
+static void free_jobs(job_list_t* job_list);
+
+// Main
+// ################################################
+
+int main (int argc, char* argv[]) {
+
+    solver_options_t options = SOLVER_OPTIONS_DEFAULT;
+    job_list_t job_list = {NULL, 0};
+    bool failure = false;
+    const char* socket_path = NULL;
+
+    int option;
+    while((option = getopt(argc, argv, RUNNER_OPTSTRING)) != -1) {
+        switch(option) {
+            case 'l':
+                list_solvers();
+                free_jobs(&job_list);
+                return EXIT_SUCCESS;
+            case 'd':
+                socket_path = optarg;
+                break;
+            case 'f':
+                if(!try_reading_job_file(&job_list, optarg)) {
+                    free_jobs(&job_list);
+                    return EXIT_FAILURE;
+                }
+                break;
+            default:
+                if(!try_parsing_solver_option(option, optarg, &options)) {
+                    print_usage(argv[0]);
+                    free_jobs(&job_list);
+                    return EXIT_FAILURE;
+                }
+        }
+    }
+    for(int i=optind; i<argc; ++i) {
+        if(!try_parsing_job_argument(&job_list, argv[i])) {
+            free_jobs(&job_list);
+            return EXIT_FAILURE;
+        }
+    }
+    if(socket_path != NULL) {
+        free_jobs(&job_list);
+        return run_daemon(socket_path, &options);
+    }
+    if(job_list.jobs_cnt == 0) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if(!try_starting_profiler_from_env()) {
+        free_jobs(&job_list);
+        return EXIT_FAILURE;
+    }
+    int64_t start_time = print_program_start();
+    // ------------------------------------------------
+
+    failure = !run_jobs(&job_list, &options);
+
+    // ------------------------------------------------
+    print_program_end(start_time);
+    free_jobs(&job_list);
+    return failure ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// Runner Functions
+// ################################################
+
+static void print_usage(const char* program_name) {
+    fprintf(stderr, "Usage: %s [options] DAY[=input_file]...\n", program_name);
+    fprintf(stderr, "  -l          List registered solvers\n");
+    fprintf(stderr, "  -f file     Read jobs from file (one \"DAY [input_file]\" per line)\n");
+    fprintf(stderr, "  -d socket   Run as daemon on the given Unix socket (see aoc_client)\n");
+    print_solver_options_usage(stderr);
+}
+
+static void list_solvers(void) {
+    for(size_t i=0; i<SOLVER_REGISTRY_CNT; ++i) {
+        const solver_t* solver = SOLVER_REGISTRY[i];
+        printf("%-6s %s/%s (version %" PRIu32 ")\n",
+            solver->name, solver->directory, solver->default_input, solver->version);
+    }
+}
+
+static bool try_adding_job(job_list_t* job_list, const char* day, const char* input_file_name) {
+
+    long solver_index = find_solver(day);
+    if(solver_index < 0) {
+        fprintf(stderr, "Error: Unknown solver \"%s\" (see -l)\n", day);
+        return false;
+    }
+    const solver_t* solver = SOLVER_REGISTRY[solver_index];
+
+    // Without an explicit input, use the default input of the day directory
+    char* path;
+    if(input_file_name != NULL && *input_file_name != '\0') {
+        path = strdup(input_file_name);
+    } else {
+        const char* root_dir = getenv(ROOT_DIR_ENV);
+        if(root_dir == NULL || *root_dir == '\0') {
+            root_dir = DEFAULT_ROOT_DIR;
+        }
+        size_t path_len = strlen(root_dir) + strlen(solver->directory) + strlen(solver->default_input) + 3;
+        path = malloc(path_len);
+        if(path != NULL) {
+            snprintf(path, path_len, "%s/%s/%s", root_dir, solver->directory, solver->default_input);
+        }
+    }
+    if(path == NULL) {
+        perror("Error allocating memory for job");
+        return false;
+    }
+
+    job_t* jobs = realloc(job_list->jobs, (job_list->jobs_cnt+1) * sizeof(job_t));
+    if(jobs == NULL) {
+        perror("Error allocating memory for job");
+        free(path);
+        return false;
+    }
+    job_list->jobs = jobs;
+    job_list->jobs[job_list->jobs_cnt].solver_index = (size_t)solver_index;
+    job_list->jobs[job_list->jobs_cnt].input_file_name = path;
+    job_list->jobs_cnt++;
+    return true;
+}
+
+static bool try_parsing_job_argument(job_list_t* job_list, const char* argument) {
+
+    // DAY or DAY=input_file
+    char* day = strdup(argument);
+    if(day == NULL) {
+        perror("Error allocating memory for job");
+        return false;
+    }
+    char* input_file_name = strchr(day, '=');
+    if(input_file_name != NULL) {
+        *input_file_name = '\0';
+        input_file_name++;
+    }
+    bool added = try_adding_job(job_list, day, input_file_name);
+    free(day);
+    return added;
+}
+
+static bool try_reading_job_file(job_list_t* job_list, const char* file_name) {
+
+    FILE* file;
+    if(!try_opening_file(file_name, &file)) {
+        return false;
+    }
+
+    bool successful = true;
+    char* line = NULL;
+    size_t line_size = 0;
+    size_t line_number = 0;
+    while(getline(&line, &line_size, file) != -1) {
+        line_number++;
+        char* rest = line;
+        char* day = strtok_r(line, " \t\r\n", &rest);
+        if(day == NULL || day[0] == '#') {
+            continue;
+        }
+        char* input_file_name = strtok_r(NULL, " \t\r\n", &rest);
+        if(!try_adding_job(job_list, day, input_file_name)) {
+            fprintf(stderr, "Error in job file %s at line %zu\n", file_name, line_number);
+            successful = false;
+            break;
+        }
+    }
+
+    free(line);
+    fclose(file);
+    return successful;
+}
+
+static bool print_job_outcome(const job_t* job, const job_outcome_t* outcome) {
+
+    const solver_t* solver = SOLVER_REGISTRY[job->solver_index];
+    if(!outcome->solved) {
+        printf("%-6s %-40s FAILED\n", solver->name, job->input_file_name);
+        return false;
+    }
+    printf("%-6s %-40s part1=%-12" PRId64, solver->name, job->input_file_name, outcome->result.part_one);
+    if(outcome->result.has_part_two) {
+        printf(" part2=%-12" PRId64, outcome->result.part_two);
+    } else {
+        printf(" %-18s", "");
+    }
+    printf(" %8.3f ms%s\n", (double)outcome->time_us / 1000.0, outcome->cache_hit ? " (cached)" : "");
+    return true;
+}
+
+static bool run_jobs(const job_list_t* job_list, const solver_options_t* options) {
+
+    // With several jobs the threads go to the jobs instead of the solvers.
+    // An export is a single file, so those batches stay serial.
+    if(options->thread_cnt > 1 && job_list->jobs_cnt > 1 && options->export_file_name == NULL) {
+        return run_jobs_parallel(job_list, options);
+    }
+
+    bool successful = true;
+    for(size_t i=0; i<job_list->jobs_cnt; ++i) {
+        const job_t* job = &job_list->jobs[i];
+        const solver_t* solver = SOLVER_REGISTRY[job->solver_index];
+        job_outcome_t outcome = {{0, 0, false}, false, false, 0};
+
+        // Solver states are created once and shared by all jobs of that solver
+        void* state = NULL;
+        warn_about_unsupported_threads(solver, options);
+        if(try_getting_solver_state(job->solver_index, &state)) {
+            int64_t job_start = micros();
+            outcome.solved = try_solving_file(solver, state, options,
+                                              job->input_file_name, &outcome.result, &outcome.cache_hit);
+            outcome.time_us = micros() - job_start;
+        }
+        successful = print_job_outcome(job, &outcome) && successful;
+    }
+
+    destroy_solver_states();
+    return successful;
+}
+
+static bool run_job_range(void* context, size_t begin, size_t end, size_t worker) {
+
+    parallel_jobs_t* parallel_jobs = (parallel_jobs_t*)context;
+    solver_options_t job_options = *parallel_jobs->options;
+    job_options.thread_cnt = 1;
+
+    for(size_t i=begin; i<end; ++i) {
+        const job_t* job = &parallel_jobs->job_list->jobs[i];
+        const solver_t* solver = SOLVER_REGISTRY[job->solver_index];
+        job_outcome_t* outcome = &parallel_jobs->outcomes[i];
+
+        // Solver states are not thread safe, so every worker keeps its own
+        size_t state_index = worker * SOLVER_REGISTRY_CNT + job->solver_index;
+        if(!parallel_jobs->states_initialized[state_index]) {
+            if(!try_initializing_solver(solver, &parallel_jobs->states[state_index])) {
+                continue;
+            }
+            parallel_jobs->states_initialized[state_index] = true;
+        }
+
+        int64_t job_start = micros();
+        outcome->solved = try_solving_file(solver, parallel_jobs->states[state_index], &job_options,
+                                           job->input_file_name, &outcome->result, &outcome->cache_hit);
+        outcome->time_us = micros() - job_start;
+    }
+    return true;
+}
+
+// Jobs are the scheduler's items: a few huge inputs keep their workers busy
+// while the others steal the small ones. Results are printed in job order.
+static bool run_jobs_parallel(const job_list_t* job_list, const solver_options_t* options) {
+
+    size_t worker_cnt = options->thread_cnt < job_list->jobs_cnt ? options->thread_cnt : job_list->jobs_cnt;
+    size_t states_cnt = worker_cnt * SOLVER_REGISTRY_CNT;
+    parallel_jobs_t parallel_jobs = {
+        .job_list = job_list,
+        .options = options,
+        .outcomes = calloc(job_list->jobs_cnt, sizeof(job_outcome_t)),
+        .states = calloc(states_cnt, sizeof(void*)),
+        .states_initialized = calloc(states_cnt, sizeof(bool))
+    };
+    scheduler_t* scheduler = NULL;
+    bool successful = parallel_jobs.outcomes != NULL && parallel_jobs.states != NULL
+                   && parallel_jobs.states_initialized != NULL;
+    if(!successful) {
+        perror("Error allocating memory for jobs");
+    }
+    successful = successful && try_creating_scheduler(worker_cnt, options->placement, &scheduler);
+
+    if(successful) {
+        parallel_for(scheduler, job_list->jobs_cnt, 1, run_job_range, &parallel_jobs);
+        destroy_scheduler(scheduler);
+        for(size_t i=0; i<job_list->jobs_cnt; ++i) {
+            successful = print_job_outcome(&job_list->jobs[i], &parallel_jobs.outcomes[i]) && successful;
+        }
+    }
+
+    for(size_t i=0; i<states_cnt && parallel_jobs.states_initialized != NULL; ++i) {
+        if(parallel_jobs.states_initialized[i]) {
+            destroy_solver(SOLVER_REGISTRY[i % SOLVER_REGISTRY_CNT], parallel_jobs.states[i]);
+        }
+    }
+    free(parallel_jobs.outcomes);
+    free(parallel_jobs.states);
+    free(parallel_jobs.states_initialized);
+    return successful;
+}
+
+static void free_jobs(job_list_t* job_list) {
+    for(size_t i=0; i<job_list->jobs_cnt; ++i) {
+        free(job_list->jobs[i].input_file_name);
+    }
+    free(job_list->jobs);
+    job_list->jobs = NULL;
+    job_list->jobs_cnt = 0;
+}
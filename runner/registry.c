@@ -0,0 +1,55 @@
+#include <string.h>
+
+#include "registry.h"
+#include "day01.h"
+#include "day02.h"
+#include "day03.h"
+#include "day03_v2.h"
+
+// Solver Registry
+// ################################################
+
+const solver_t* const SOLVER_REGISTRY[] = {
+    &DAY01_SOLVER,
+    &DAY02_SOLVER,
+    &DAY03_SOLVER,
+    &DAY03_V2_SOLVER,
+};
+
+#define REGISTRY_CNT (sizeof(SOLVER_REGISTRY) / sizeof(SOLVER_REGISTRY[0]))
+
+const size_t SOLVER_REGISTRY_CNT = REGISTRY_CNT;
+
+static void* G_SOLVER_STATES[REGISTRY_CNT];
+static bool G_SOLVER_INITIALIZED[REGISTRY_CNT];
+
+long find_solver(const char* name) {
+    for(size_t i=0; i<SOLVER_REGISTRY_CNT; ++i) {
+        if(strcmp(SOLVER_REGISTRY[i]->name, name) == 0) {
+            return (long)i;
+        }
+    }
+    return -1;
+}
+
+bool try_getting_solver_state(size_t solver_index, void** state) {
+
+    if(!G_SOLVER_INITIALIZED[solver_index]) {
+        if(!try_initializing_solver(SOLVER_REGISTRY[solver_index], &G_SOLVER_STATES[solver_index])) {
+            return false;
+        }
+        G_SOLVER_INITIALIZED[solver_index] = true;
+    }
+    *state = G_SOLVER_STATES[solver_index];
+    return true;
+}
+
+void destroy_solver_states(void) {
+    for(size_t i=0; i<REGISTRY_CNT; ++i) {
+        if(G_SOLVER_INITIALIZED[i]) {
+            destroy_solver(SOLVER_REGISTRY[i], G_SOLVER_STATES[i]);
+            G_SOLVER_STATES[i] = NULL;
+            G_SOLVER_INITIALIZED[i] = false;
+        }
+    }
+}
@@ -0,0 +1,22 @@
+#ifndef AOC_REGISTRY_H
+#define AOC_REGISTRY_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "solver.h"
+
+// Solver Registry
+// ################################################
+
+extern const solver_t* const SOLVER_REGISTRY[];
+extern const size_t SOLVER_REGISTRY_CNT;
+
+// Returns the index of the solver with the given name or -1
+long find_solver(const char* name);
+
+// Solver states are created on first use and kept warm until destroyed
+bool try_getting_solver_state(size_t solver_index, void** state);
+void destroy_solver_states(void);
+
+#endif